@@ -1,4 +1,5 @@
 #include "fmrb_audio.h"
+#include "fmrb_app.h"
 #include "fmrb_hal.h"
 #include "fmrb_link_protocol.h"
 #include "fmrb_link_transport.h"
@@ -9,40 +10,58 @@
 
 static const char *TAG = "fmrb_audio";
 
-// Audio context
+// Per-app state, only touched from the app's own task
 typedef struct {
-    bool initialized;
+    bool used;                      // Sent audio commands (gets a STOP when it exits)
+    bool used_sfx;                  // Uploaded sound effects (unloaded when it exits)
     fmrb_apu_status_t current_status;
     uint8_t current_volume;
+} fmrb_audio_app_t;
+
+// Audio context
+typedef struct {
+    bool initialized;
+    fmrb_audio_app_t apps[FMRB_MAX_APPS];
 } fmrb_audio_ctx_t;
 
 static fmrb_audio_ctx_t audio_ctx = {
-    .initialized = false,
-    .current_status = FMRB_APU_STATUS_STOPPED,
-    .current_volume = 128
+    .initialized = false
 };
 
-static fmrb_audio_err_t send_apu_command(fmrb_apu_cmd_t cmd, const void* data, size_t data_size) {
+// The calling app; tasks without an app context count as the kernel
+static uint8_t current_proc_id(void) {
+    fmrb_app_task_context_t *ctx = fmrb_current();
+    return ctx ? (uint8_t)ctx->app_id : (uint8_t)PROC_ID_KERNEL;
+}
+
+// PCM bytes per QUEUE_SAMPLES message, leaving room for the header within a link frame
+#define AUDIO_STREAM_CHUNK_BYTES 2048
+
+// Sound effect upload header: [uint8 sfx_id | uint8 bits_per_sample | uint8 max_voices |
+// uint8 priority | uint32 sample_rate | uint32 total_size | uint32 offset] after command and proc_id
+#define AUDIO_SFX_LOAD_HEADER_BYTES 18
+#define AUDIO_SFX_MAX_EFFECTS 32
+#define AUDIO_SFX_MAX_SIZE (1024 * 1024)
+#define AUDIO_SFX_ALL 0xFF
+
+// APU commands go to the host as FMRB_LINK_TYPE_AUDIO messages whose payload is
+// [uint8 command | uint8 proc_id | command fields] (fmrb_audio_*_cmd_t in host/common/audio_commands.h)
+static fmrb_audio_err_t send_apu_command(uint8_t proc_id, fmrb_apu_cmd_t cmd, const void* data, size_t data_size) {
     // Create command packet
-    size_t packet_size = sizeof(fmrb_apu_cmd_t) + data_size;
+    size_t packet_size = 2 + data_size;
     uint8_t* packet = fmrb_sys_malloc(packet_size);
     if (!packet) {
         return FMRB_AUDIO_ERR_NO_MEMORY;
     }
 
-    // Pack command and data
-    memcpy(packet, &cmd, sizeof(fmrb_apu_cmd_t));
+    // Pack command, app and data
+    packet[0] = (uint8_t)cmd;
+    packet[1] = proc_id;
     if (data && data_size > 0) {
-        memcpy(packet + sizeof(fmrb_apu_cmd_t), data, data_size);
+        memcpy(packet + 2, data, data_size);
     }
 
-    // Send via link communication
-    fmrb_link_message_t msg = {
-        .data = packet,
-        .size = packet_size
-    };
-
-    fmrb_err_t ret = fmrb_hal_link_send(FMRB_LINK_AUDIO, &msg, 1000);
+    fmrb_err_t ret = fmrb_link_transport_send(FMRB_LINK_TYPE_AUDIO, (uint8_t)cmd, packet, packet_size);
     fmrb_sys_free(packet);
 
     if (ret == FMRB_OK) {
@@ -66,9 +85,13 @@ fmrb_audio_err_t fmrb_audio_init(void) {
         return FMRB_AUDIO_ERR_FAILED;
     }
 
+    for (int i = 0; i < FMRB_MAX_APPS; i++) {
+        audio_ctx.apps[i].used = false;
+        audio_ctx.apps[i].used_sfx = false;
+        audio_ctx.apps[i].current_status = FMRB_APU_STATUS_STOPPED;
+        audio_ctx.apps[i].current_volume = 128;
+    }
     audio_ctx.initialized = true;
-    audio_ctx.current_status = FMRB_APU_STATUS_STOPPED;
-    audio_ctx.current_volume = 128;
 
     ESP_LOGI(TAG, "Audio subsystem (APU emulator) initialized");
     return FMRB_AUDIO_OK;
@@ -80,13 +103,55 @@ fmrb_audio_err_t fmrb_audio_deinit(void) {
     }
 
     // Stop any playing audio
-    fmrb_audio_stop();
+    for (int i = 0; i < FMRB_MAX_APPS; i++) {
+        fmrb_audio_release_app((uint8_t)i);
+    }
 
     audio_ctx.initialized = false;
     ESP_LOGI(TAG, "Audio subsystem deinitialized");
     return FMRB_AUDIO_OK;
 }
 
+fmrb_audio_err_t fmrb_audio_set_focus(uint8_t proc_id) {
+    if (!audio_ctx.initialized) {
+        return FMRB_AUDIO_ERR_NOT_INITIALIZED;
+    }
+
+    ESP_LOGI(TAG, "Audio focus: app %u", proc_id);
+    return send_apu_command(proc_id, FMRB_APU_CMD_SET_FOCUS, NULL, 0);
+}
+
+fmrb_audio_err_t fmrb_audio_release_app(uint8_t proc_id) {
+    if (!audio_ctx.initialized) {
+        return FMRB_AUDIO_ERR_NOT_INITIALIZED;
+    }
+    if (proc_id >= FMRB_MAX_APPS) {
+        return FMRB_AUDIO_ERR_INVALID_PARAM;
+    }
+
+    // Apps that never touched audio cost no link traffic when they exit
+    fmrb_audio_app_t *app = &audio_ctx.apps[proc_id];
+    if (!app->used) {
+        return FMRB_AUDIO_OK;
+    }
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_STOP, NULL, 0);
+    if (app->used_sfx) {
+        // Frees the host memory of every effect the app uploaded
+        uint8_t sfx_id = AUDIO_SFX_ALL;
+        send_apu_command(proc_id, FMRB_APU_CMD_SFX_UNLOAD, &sfx_id, sizeof(sfx_id));
+    }
+    if (app->current_volume != 128) {
+        // The next app in this slot starts at the default gain
+        uint8_t volume = 128;
+        send_apu_command(proc_id, FMRB_APU_CMD_SET_VOLUME, &volume, sizeof(volume));
+    }
+    app->used = false;
+    app->used_sfx = false;
+    app->current_status = FMRB_APU_STATUS_STOPPED;
+    app->current_volume = 128;
+    return ret;
+}
+
 fmrb_audio_err_t fmrb_audio_load_music(const fmrb_audio_music_t* music) {
     if (!audio_ctx.initialized) {
         return FMRB_AUDIO_ERR_NOT_INITIALIZED;
@@ -98,14 +163,22 @@ fmrb_audio_err_t fmrb_audio_load_music(const fmrb_audio_music_t* music) {
 
     ESP_LOGI(TAG, "Loading music binary: ID=%u, size=%zu bytes", music->id, music->size);
 
-    // Send load command with music data
+    // [uint32 music_id | uint32 data_size | music binary], see the APU format in audio_commands.h
     // Note: For large binaries, this might need chunking in production
-    fmrb_audio_err_t ret = send_apu_command(FMRB_APU_CMD_LOAD_BINARY, music, sizeof(fmrb_audio_music_t));
-    if (ret == FMRB_AUDIO_OK) {
-        // Send the actual binary data
-        ret = send_apu_command(FMRB_APU_CMD_LOAD_BINARY, music->data, music->size);
+    size_t body_size = 8 + music->size;
+    uint8_t* body = fmrb_sys_malloc(body_size);
+    if (!body) {
+        return FMRB_AUDIO_ERR_NO_MEMORY;
     }
-
+    uint32_t size32 = (uint32_t)music->size;
+    memcpy(body, &music->id, 4);
+    memcpy(body + 4, &size32, 4);
+    memcpy(body + 8, music->data, music->size);
+
+    uint8_t proc_id = current_proc_id();
+    audio_ctx.apps[proc_id].used = true;
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_LOAD_BINARY, body, body_size);
+    fmrb_sys_free(body);
     return ret;
 }
 
@@ -116,9 +189,11 @@ fmrb_audio_err_t fmrb_audio_play(uint32_t music_id) {
 
     ESP_LOGI(TAG, "Starting playback: music_id=%u", music_id);
 
-    fmrb_audio_err_t ret = send_apu_command(FMRB_APU_CMD_PLAY, &music_id, sizeof(music_id));
+    uint8_t proc_id = current_proc_id();
+    audio_ctx.apps[proc_id].used = true;
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_PLAY, &music_id, sizeof(music_id));
     if (ret == FMRB_AUDIO_OK) {
-        audio_ctx.current_status = FMRB_APU_STATUS_PLAYING;
+        audio_ctx.apps[proc_id].current_status = FMRB_APU_STATUS_PLAYING;
     }
 
     return ret;
@@ -131,9 +206,10 @@ fmrb_audio_err_t fmrb_audio_stop(void) {
 
     ESP_LOGI(TAG, "Stopping playback");
 
-    fmrb_audio_err_t ret = send_apu_command(FMRB_APU_CMD_STOP, NULL, 0);
+    uint8_t proc_id = current_proc_id();
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_STOP, NULL, 0);
     if (ret == FMRB_AUDIO_OK) {
-        audio_ctx.current_status = FMRB_APU_STATUS_STOPPED;
+        audio_ctx.apps[proc_id].current_status = FMRB_APU_STATUS_STOPPED;
     }
 
     return ret;
@@ -146,9 +222,10 @@ fmrb_audio_err_t fmrb_audio_pause(void) {
 
     ESP_LOGI(TAG, "Pausing playback");
 
-    fmrb_audio_err_t ret = send_apu_command(FMRB_APU_CMD_PAUSE, NULL, 0);
+    uint8_t proc_id = current_proc_id();
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_PAUSE, NULL, 0);
     if (ret == FMRB_AUDIO_OK) {
-        audio_ctx.current_status = FMRB_APU_STATUS_PAUSED;
+        audio_ctx.apps[proc_id].current_status = FMRB_APU_STATUS_PAUSED;
     }
 
     return ret;
@@ -161,9 +238,10 @@ fmrb_audio_err_t fmrb_audio_resume(void) {
 
     ESP_LOGI(TAG, "Resuming playback");
 
-    fmrb_audio_err_t ret = send_apu_command(FMRB_APU_CMD_RESUME, NULL, 0);
+    uint8_t proc_id = current_proc_id();
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_RESUME, NULL, 0);
     if (ret == FMRB_AUDIO_OK) {
-        audio_ctx.current_status = FMRB_APU_STATUS_PLAYING;
+        audio_ctx.apps[proc_id].current_status = FMRB_APU_STATUS_PLAYING;
     }
 
     return ret;
@@ -176,9 +254,11 @@ fmrb_audio_err_t fmrb_audio_set_volume(uint8_t volume) {
 
     ESP_LOGI(TAG, "Setting volume: %u", volume);
 
-    fmrb_audio_err_t ret = send_apu_command(FMRB_APU_CMD_SET_VOLUME, &volume, sizeof(volume));
+    uint8_t proc_id = current_proc_id();
+    audio_ctx.apps[proc_id].used = true;
+    fmrb_audio_err_t ret = send_apu_command(proc_id, FMRB_APU_CMD_SET_VOLUME, &volume, sizeof(volume));
     if (ret == FMRB_AUDIO_OK) {
-        audio_ctx.current_volume = volume;
+        audio_ctx.apps[proc_id].current_volume = volume;
     }
 
     return ret;
@@ -193,9 +273,172 @@ fmrb_audio_err_t fmrb_audio_get_status(fmrb_apu_status_t* status) {
         return FMRB_AUDIO_ERR_INVALID_PARAM;
     }
 
-    // For now, return cached status
-    // In production, this might query the APU via link communication
-    *status = audio_ctx.current_status;
+    // The host ACKs every APU command with the app's playback status, which also tells when a
+    // track has reached its end; fall back to the cached status if the query fails
+    uint8_t proc_id = current_proc_id();
+    uint8_t cmd[2] = { FMRB_APU_CMD_GET_STATUS, proc_id };
+    uint8_t response[4];
+    uint32_t response_len = sizeof(response);
+    fmrb_err_t ret = fmrb_link_transport_send_sync(FMRB_LINK_TYPE_AUDIO, cmd[0], cmd, sizeof(cmd),
+                                                   response, &response_len, 100);
+    if (ret == FMRB_OK && response_len >= 1) {
+        audio_ctx.apps[proc_id].current_status = (fmrb_apu_status_t)response[0];
+    }
+    *status = audio_ctx.apps[proc_id].current_status;
 
     return FMRB_AUDIO_OK;
-}
\ No newline at end of file
+}
+
+fmrb_audio_err_t fmrb_audio_queue_samples(uint32_t sample_rate, uint8_t channels, uint8_t bits_per_sample,
+                                          const void* data, size_t size, fmrb_audio_stream_status_t* status) {
+    if (!audio_ctx.initialized) {
+        return FMRB_AUDIO_ERR_NOT_INITIALIZED;
+    }
+
+    const size_t frame_bytes = (size_t)channels * (bits_per_sample / 8);
+    if (!data || size == 0 || sample_rate == 0 || (channels != 1 && channels != 2) ||
+        (bits_per_sample != 8 && bits_per_sample != 16) || size % frame_bytes != 0) {
+        return FMRB_AUDIO_ERR_INVALID_PARAM;
+    }
+
+    uint8_t* packet = fmrb_sys_malloc(sizeof(fmrb_link_audio_play_t) + AUDIO_STREAM_CHUNK_BYTES);
+    if (!packet) {
+        return FMRB_AUDIO_ERR_NO_MEMORY;
+    }
+
+    // Chunks stay whole frames so the host's resampler never sees a split sample
+    const size_t chunk_max = AUDIO_STREAM_CHUNK_BYTES - AUDIO_STREAM_CHUNK_BYTES % frame_bytes;
+    const uint8_t* src = (const uint8_t*)data;
+    fmrb_audio_err_t result = FMRB_AUDIO_OK;
+    fmrb_link_audio_queue_status_t ack = {0};
+    while (size > 0) {
+        const size_t chunk = size < chunk_max ? size : chunk_max;
+        fmrb_link_audio_play_t hdr = {
+            .sample_rate = sample_rate,
+            .channels = channels,
+            .bits_per_sample = bits_per_sample,
+            .data_len = (uint32_t)chunk
+        };
+        memcpy(packet, &hdr, sizeof(hdr));
+        memcpy(packet + sizeof(hdr), src, chunk);
+
+        // The ACK carries the host's buffer fill level
+        uint32_t ack_len = sizeof(ack);
+        fmrb_err_t ret = fmrb_link_transport_send_sync(FMRB_LINK_TYPE_AUDIO, FMRB_LINK_MSG_AUDIO_QUEUE_SAMPLES,
+                                                       packet, sizeof(hdr) + chunk,
+                                                       (uint8_t*)&ack, &ack_len, 100);
+        if (ret != FMRB_OK) {
+            ESP_LOGE(TAG, "Failed to queue %zu sample bytes", chunk);
+            result = ret == FMRB_ERR_TIMEOUT ? FMRB_AUDIO_ERR_TIMEOUT : FMRB_AUDIO_ERR_FAILED;
+            break;
+        }
+        src += chunk;
+        size -= chunk;
+    }
+    fmrb_sys_free(packet);
+
+    if (status && result == FMRB_AUDIO_OK) {
+        status->queued_frames = ack.queued_frames;
+        status->target_frames = ack.target_frames;
+        status->free_frames = ack.free_frames;
+        status->output_rate = ack.output_rate;
+        status->underruns = ack.underruns;
+        status->overruns = ack.overruns;
+    }
+    return result;
+}
+
+fmrb_audio_err_t fmrb_audio_sfx_load(uint8_t sfx_id, const fmrb_audio_sfx_t* sfx) {
+    if (!audio_ctx.initialized) {
+        return FMRB_AUDIO_ERR_NOT_INITIALIZED;
+    }
+
+    if (!sfx || !sfx->data || sfx->size == 0 || sfx->size > AUDIO_SFX_MAX_SIZE || sfx->sample_rate == 0 ||
+        sfx_id >= AUDIO_SFX_MAX_EFFECTS || (sfx->bits_per_sample != 8 && sfx->bits_per_sample != 16) ||
+        sfx->size % (sfx->bits_per_sample / 8) != 0) {
+        return FMRB_AUDIO_ERR_INVALID_PARAM;
+    }
+
+    ESP_LOGI(TAG, "Loading sound effect %u: %zu bytes at %u Hz", sfx_id, sfx->size, sfx->sample_rate);
+
+    const size_t header_size = 2 + AUDIO_SFX_LOAD_HEADER_BYTES;
+    uint8_t* packet = fmrb_sys_malloc(header_size + AUDIO_STREAM_CHUNK_BYTES);
+    if (!packet) {
+        return FMRB_AUDIO_ERR_NO_MEMORY;
+    }
+
+    uint8_t proc_id = current_proc_id();
+    audio_ctx.apps[proc_id].used = true;
+    audio_ctx.apps[proc_id].used_sfx = true;
+
+    // Chunks are sent in order and each waits for its ACK, so the effect is installed on the host
+    // before this returns and a trigger sent right after finds it
+    const uint32_t rate = sfx->sample_rate;
+    const uint32_t total = (uint32_t)sfx->size;
+    const uint8_t* src = (const uint8_t*)sfx->data;
+    fmrb_audio_err_t result = FMRB_AUDIO_OK;
+    for (uint32_t offset = 0; offset < total;) {
+        const uint32_t chunk = total - offset < AUDIO_STREAM_CHUNK_BYTES ? total - offset : AUDIO_STREAM_CHUNK_BYTES;
+        packet[0] = FMRB_APU_CMD_SFX_LOAD;
+        packet[1] = proc_id;
+        packet[2] = sfx_id;
+        packet[3] = sfx->bits_per_sample;
+        packet[4] = sfx->max_voices;
+        packet[5] = sfx->priority;
+        memcpy(packet + 6, &rate, 4);
+        memcpy(packet + 10, &total, 4);
+        memcpy(packet + 14, &offset, 4);
+        memcpy(packet + header_size, src + offset, chunk);
+
+        uint8_t response[4];
+        uint32_t response_len = sizeof(response);
+        fmrb_err_t ret = fmrb_link_transport_send_sync(FMRB_LINK_TYPE_AUDIO, FMRB_APU_CMD_SFX_LOAD,
+                                                       packet, header_size + chunk,
+                                                       response, &response_len, 100);
+        if (ret != FMRB_OK) {
+            ESP_LOGE(TAG, "Failed to upload sound effect %u at offset %u", sfx_id, offset);
+            result = ret == FMRB_ERR_TIMEOUT ? FMRB_AUDIO_ERR_TIMEOUT : FMRB_AUDIO_ERR_FAILED;
+            break;
+        }
+        offset += chunk;
+    }
+    fmrb_sys_free(packet);
+    return result;
+}
+
+fmrb_audio_err_t fmrb_audio_sfx_trigger(uint8_t sfx_id, uint8_t volume, int8_t pan, int16_t pitch_cents) {
+    if (!audio_ctx.initialized) {
+        return FMRB_AUDIO_ERR_NOT_INITIALIZED;
+    }
+
+    if (sfx_id >= AUDIO_SFX_MAX_EFFECTS) {
+        return FMRB_AUDIO_ERR_INVALID_PARAM;
+    }
+
+    // [uint8 sfx_id | uint8 volume | int8 pan | int16 pitch]; sent without waiting so a game loop
+    // can fire effects every frame
+    uint8_t packet[7];
+    packet[0] = FMRB_APU_CMD_SFX_TRIGGER;
+    packet[1] = current_proc_id();
+    packet[2] = sfx_id;
+    packet[3] = volume;
+    packet[4] = (uint8_t)pan;
+    memcpy(packet + 5, &pitch_cents, 2);
+
+    fmrb_err_t ret = fmrb_link_transport_send(FMRB_LINK_TYPE_AUDIO, FMRB_APU_CMD_SFX_TRIGGER, packet, sizeof(packet));
+    return ret == FMRB_OK ? FMRB_AUDIO_OK : FMRB_AUDIO_ERR_FAILED;
+}
+
+fmrb_audio_err_t fmrb_audio_sfx_unload(uint8_t sfx_id) {
+    if (!audio_ctx.initialized) {
+        return FMRB_AUDIO_ERR_NOT_INITIALIZED;
+    }
+
+    if (sfx_id >= AUDIO_SFX_MAX_EFFECTS && sfx_id != AUDIO_SFX_ALL) {
+        return FMRB_AUDIO_ERR_INVALID_PARAM;
+    }
+
+    ESP_LOGI(TAG, "Unloading sound effect %u", sfx_id);
+
+    return send_apu_command(current_proc_id(), FMRB_APU_CMD_SFX_UNLOAD, &sfx_id, sizeof(sfx_id));
+}
@@ -26,7 +26,11 @@ typedef enum {
     FMRB_APU_CMD_PAUSE = 0x04,           // Pause playback
     FMRB_APU_CMD_RESUME = 0x05,          // Resume playback
     FMRB_APU_CMD_SET_VOLUME = 0x06,      // Set volume level
-    FMRB_APU_CMD_GET_STATUS = 0x07       // Get playback status
+    FMRB_APU_CMD_GET_STATUS = 0x07,      // Get playback status
+    FMRB_APU_CMD_SET_FOCUS = 0x08,       // Duck every app but the focused one
+    FMRB_APU_CMD_SFX_LOAD = 0x09,        // Upload a sound effect (chunked)
+    FMRB_APU_CMD_SFX_TRIGGER = 0x0A,     // Play an uploaded sound effect
+    FMRB_APU_CMD_SFX_UNLOAD = 0x0B       // Remove a sound effect
 } fmrb_apu_cmd_t;
 
 // APU playback status
@@ -44,6 +48,30 @@ typedef struct {
     uint32_t id;                // Music track ID
 } fmrb_audio_music_t;
 
+// Sound effect clip, uploaded once with fmrb_audio_sfx_load() and then played by id
+typedef struct {
+    const void* data;           // Mono PCM: 8-bit unsigned or 16-bit signed little endian
+    size_t size;                // Data size in bytes (up to 1 MB)
+    uint32_t sample_rate;       // Sample rate in Hz
+    uint8_t bits_per_sample;    // 8 or 16
+    uint8_t max_voices;         // Simultaneous plays of this effect (0 = host default of 4)
+    uint8_t priority;           // Higher-priority effects may steal voices from lower ones
+} fmrb_audio_sfx_t;
+
+// Host stream buffer state returned by fmrb_audio_queue_samples(); frames are at the host's
+// output rate. Pace sending so queued_frames stays near target_frames.
+typedef struct {
+    uint32_t queued_frames;     // Buffered on the host, not yet played
+    uint32_t target_frames;     // Host latency target
+    uint32_t free_frames;       // Room left before the host drops samples
+    uint32_t output_rate;       // Host output sample rate
+    uint32_t underruns;         // Times playback ran dry
+    uint32_t overruns;          // Times samples were dropped on a full buffer
+} fmrb_audio_stream_status_t;
+
+// Playback calls act on the calling app's own player on the host: its own tracks, status and
+// volume, mixed with the other apps' players.
+
 /**
  * @brief Initialize audio subsystem (APU emulator interface)
  * @return Audio error code
@@ -56,6 +84,20 @@ fmrb_audio_err_t fmrb_audio_init(void);
  */
 fmrb_audio_err_t fmrb_audio_deinit(void);
 
+/**
+ * @brief Set the focused app; the host ducks the others (called on focus changes)
+ * @param proc_id Focused app, or 0xFF for none
+ * @return Audio error code
+ */
+fmrb_audio_err_t fmrb_audio_set_focus(uint8_t proc_id);
+
+/**
+ * @brief Stop an app's playback if it used audio (called when the app exits)
+ * @param proc_id App
+ * @return Audio error code
+ */
+fmrb_audio_err_t fmrb_audio_release_app(uint8_t proc_id);
+
 /**
  * @brief Load music binary to APU emulator
  * @param music Music binary information
@@ -102,6 +144,44 @@ fmrb_audio_err_t fmrb_audio_set_volume(uint8_t volume);
  */
 fmrb_audio_err_t fmrb_audio_get_status(fmrb_apu_status_t* status);
 
+/**
+ * @brief Stream PCM samples to the host (mixed with APU playback, resampled to the output rate)
+ * @param sample_rate Sample rate of the data in Hz
+ * @param channels 1 or 2 (interleaved)
+ * @param bits_per_sample 8 (unsigned) or 16 (signed little endian)
+ * @param data Sample data
+ * @param size Data size in bytes
+ * @param status Host buffer state after queuing, for flow control (can be NULL)
+ * @return Audio error code
+ */
+fmrb_audio_err_t fmrb_audio_queue_samples(uint32_t sample_rate, uint8_t channels, uint8_t bits_per_sample,
+                                          const void* data, size_t size, fmrb_audio_stream_status_t* status);
+
+/**
+ * @brief Upload a sound effect to the host, replacing any effect with the same id
+ * @param sfx_id Effect id (0-31, per app)
+ * @param sfx Clip
+ * @return Audio error code
+ */
+fmrb_audio_err_t fmrb_audio_sfx_load(uint8_t sfx_id, const fmrb_audio_sfx_t* sfx);
+
+/**
+ * @brief Play an uploaded sound effect (does not wait for the host)
+ * @param sfx_id Effect id
+ * @param volume Volume level (0-255)
+ * @param pan -127 (left) to 127 (right), 0 for center
+ * @param pitch_cents Pitch shift in cents (-2400 to 2400)
+ * @return Audio error code
+ */
+fmrb_audio_err_t fmrb_audio_sfx_trigger(uint8_t sfx_id, uint8_t volume, int8_t pan, int16_t pitch_cents);
+
+/**
+ * @brief Remove a sound effect, stopping its voices
+ * @param sfx_id Effect id, or 0xFF for all of the app's effects
+ * @return Audio error code
+ */
+fmrb_audio_err_t fmrb_audio_sfx_unload(uint8_t sfx_id);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -76,6 +76,10 @@ typedef struct fmrb_app_task_context_s {
     uint16_t              window_pos_y;
     uint8_t               z_order;           // Z-order (0=back, higher=front)
     uint16_t              canvas_id;         // Canvas ID (0 for headless apps)
+    uint8_t               frame_style;       // Compositor-drawn frame (FMRB_GFX_FRAME_*)
+    uint8_t               frame_flags;       // FMRB_GFX_FRAME_FLAG_*
+    uint32_t              frames_presented;  // PRESENTs sent to the Host Task
+    uint32_t              frames_displayed;  // Newest PRESENT reported on screen (frame-complete notification)
 
     // Load mode and data (replaces encoded user_data pointer tagging)
     fmrb_load_mode_t      load_mode;         // How to load the script
@@ -134,6 +138,8 @@ typedef struct {
     uint16_t              width;            // Window width
     uint16_t              height;           // Window height
     uint8_t               z_order;          // Z-order (0=back, higher=front)
+    uint8_t               frame_style;      // Compositor-drawn frame (FMRB_GFX_FRAME_*)
+    uint8_t               frame_flags;      // FMRB_GFX_FRAME_FLAG_*
 } fmrb_window_info_t;
 
 // Core APIs
@@ -25,16 +25,96 @@ static bool is_clipped(fmrb_gfx_context_impl_t *ctx, int16_t x, int16_t y) {
             y >= ctx->clip_rect.y + ctx->clip_rect.height);
 }
 
+// Text color and size are per canvas on the host; the shadow follows one canvas at a time
+static void text_state_select(fmrb_gfx_context_impl_t *ctx, fmrb_canvas_handle_t canvas_id) {
+    if (ctx->text_canvas != canvas_id) {
+        ctx->text_canvas = canvas_id;
+        ctx->text_color_valid = false;
+        ctx->text_size_valid = false;
+    }
+}
+
+// Display list being recorded; ctx is a copy of the sending context whose
+// draw calls end up in data instead of on the link
+struct fmrb_gfx_list_recorder {
+    fmrb_gfx_context_impl_t ctx;
+    fmrb_gfx_context_impl_t *base;
+    fmrb_canvas_handle_t canvas_id;
+    uint8_t list_id;
+    uint8_t slot_count;
+    fmrb_color_t slot_colors[FMRB_LINK_GFX_LIST_MAX_SLOTS];
+    uint16_t len;
+    bool overflow;
+    uint8_t data[FMRB_LINK_GFX_LIST_MAX_SIZE];
+};
+
+// Commands the host can replay from a display list
+static bool is_list_command(uint8_t cmd_type) {
+    switch (cmd_type) {
+        case FMRB_LINK_GFX_DRAW_PIXEL:
+        case FMRB_LINK_GFX_DRAW_LINE:
+        case FMRB_LINK_GFX_DRAW_RECT:
+        case FMRB_LINK_GFX_FILL_RECT:
+        case FMRB_LINK_GFX_DRAW_ROUND_RECT:
+        case FMRB_LINK_GFX_FILL_ROUND_RECT:
+        case FMRB_LINK_GFX_DRAW_CIRCLE:
+        case FMRB_LINK_GFX_FILL_CIRCLE:
+        case FMRB_LINK_GFX_DRAW_ELLIPSE:
+        case FMRB_LINK_GFX_FILL_ELLIPSE:
+        case FMRB_LINK_GFX_DRAW_TRIANGLE:
+        case FMRB_LINK_GFX_FILL_TRIANGLE:
+        case FMRB_LINK_GFX_DRAW_STRING:
+        case FMRB_LINK_GFX_DRAW_STRING_CURRENT:
+        case FMRB_LINK_GFX_SET_TEXT_SIZE:
+        case FMRB_LINK_GFX_SET_TEXT_COLOR:
+        case FMRB_LINK_GFX_DRAW_POLYLINE:
+        case FMRB_LINK_GFX_DRAW_POLYGON:
+        case FMRB_LINK_GFX_FILL_POLYGON:
+        case FMRB_LINK_GFX_DRAW_POINTS:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Append one command to the list being recorded
+static fmrb_gfx_err_t list_record(fmrb_gfx_list_recorder_t *rec, uint8_t cmd_type, const void *cmd_data, size_t cmd_size) {
+    if (!is_list_command(cmd_type)) {
+        ESP_LOGE(TAG, "Command 0x%02X cannot be recorded in a display list", cmd_type);
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    size_t item_size = sizeof(fmrb_link_graphics_list_item_t) + cmd_size;
+    if (rec->overflow || rec->len + item_size > FMRB_LINK_GFX_LIST_MAX_SIZE) {
+        rec->overflow = true;
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    fmrb_link_graphics_list_item_t item = {
+        .cmd_type = cmd_type,
+        .len = (uint16_t)cmd_size
+    };
+    memcpy(rec->data + rec->len, &item, sizeof(item));
+    memcpy(rec->data + rec->len + sizeof(item), cmd_data, cmd_size);
+    rec->len += (uint16_t)item_size;
+    return FMRB_GFX_OK;
+}
+
 // Helper function to send graphics command (asynchronous)
 static fmrb_gfx_err_t send_graphics_command(fmrb_gfx_context_impl_t *ctx, uint8_t cmd_type, const void *cmd_data, size_t cmd_size) {
     if (!ctx) {
         return FMRB_GFX_ERR_NOT_INITIALIZED;
     }
 
+    if (ctx->recorder) {
+        return list_record(ctx->recorder, cmd_type, cmd_data, cmd_size);
+    }
+
     fmrb_err_t ret = fmrb_link_transport_send(FMRB_LINK_TYPE_GRAPHICS, cmd_type, (const uint8_t*)cmd_data, cmd_size);
 
     switch (ret) {
         case FMRB_OK:
+            ctx->stats.commands_sent++;
             return FMRB_GFX_OK;
         case FMRB_ERR_INVALID_PARAM:
             return FMRB_GFX_ERR_INVALID_PARAM;
@@ -60,6 +140,9 @@ static fmrb_gfx_err_t send_graphics_command_sync(
     if (!ctx) {
         return FMRB_GFX_ERR_NOT_INITIALIZED;
     }
+    if (ctx->recorder) {
+        return FMRB_GFX_ERR_INVALID_PARAM;  // Queries cannot be recorded
+    }
 
     fmrb_err_t ret = fmrb_link_transport_send_sync(
         FMRB_LINK_TYPE_GRAPHICS,
@@ -73,6 +156,7 @@ static fmrb_gfx_err_t send_graphics_command_sync(
 
     switch (ret) {
         case FMRB_OK:
+            ctx->stats.commands_sent++;
             return FMRB_GFX_OK;
         case FMRB_ERR_INVALID_PARAM:
             return FMRB_GFX_ERR_INVALID_PARAM;
@@ -113,6 +197,7 @@ fmrb_gfx_err_t fmrb_gfx_init(const fmrb_gfx_config_t *config) {
     ctx->initialized = true;
     ctx->current_target = FMRB_CANVAS_SCREEN;  // Default to main screen
     ctx->next_canvas_id = 1;  // Start canvas IDs from 1
+    ctx->text_canvas = FMRB_CANVAS_INVALID;  // No text state known on the host yet
 
     // Store as global context
     g_gfx_context = ctx;
@@ -126,6 +211,14 @@ fmrb_gfx_err_t fmrb_gfx_init(const fmrb_gfx_config_t *config) {
 fmrb_gfx_err_t fmrb_gfx_deinit(void) {
     // Only deinitialize if this is the global context
     if (g_gfx_context != NULL) {
+        const fmrb_gfx_stats_t *stats = &g_gfx_context->stats;
+        uint32_t state_total = stats->commands_sent + stats->state_elided;
+        ESP_LOGI(TAG, "Encoder stats: sent=%lu, state elided=%lu (%lu%%), text style reused=%lu/%lu (%lu%%)",
+                 (unsigned long)stats->commands_sent, (unsigned long)stats->state_elided,
+                 (unsigned long)(state_total ? stats->state_elided * 100 / state_total : 0),
+                 (unsigned long)stats->text_style_reused, (unsigned long)stats->text_sent,
+                 (unsigned long)(stats->text_sent ? stats->text_style_reused * 100 / stats->text_sent : 0));
+
         // Deinitialize singleton transport
         fmrb_link_transport_deinit();
 
@@ -144,6 +237,15 @@ fmrb_gfx_context_t fmrb_gfx_get_global_context(void) {
     return g_gfx_context;
 }
 
+fmrb_gfx_err_t fmrb_gfx_get_stats(fmrb_gfx_context_t context, fmrb_gfx_stats_t *stats) {
+    if (!context || !stats) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    *stats = context->stats;
+    return FMRB_GFX_OK;
+}
+
 fmrb_gfx_err_t fmrb_gfx_clear(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, fmrb_color_t color) {
     ESP_LOGD(TAG, "clear: called with context=%p, canvas_id=%d, color=0x%02x", context, canvas_id, color);
 
@@ -325,6 +427,34 @@ fmrb_gfx_err_t fmrb_gfx_draw_text(fmrb_gfx_context_t context, fmrb_canvas_handle
         text_len = 255; // Limit text length
     }
 
+    // A transparent background is expressed as bg == fg, matching the host's setTextColor()
+    fmrb_color_t effective_bg = bg_transparent ? color : bg_color;
+    text_state_select(ctx, canvas_id);
+
+    if (ctx->text_color_valid && ctx->text_fg == color && ctx->text_bg == effective_bg) {
+        // Host already has this text color on the canvas: send position and text only
+        size_t total_size = sizeof(fmrb_link_graphics_text_current_t) + text_len;
+        uint8_t *cmd_buffer = fmrb_sys_malloc(total_size);
+        if (!cmd_buffer) {
+            return FMRB_GFX_ERR_NO_MEMORY;
+        }
+
+        fmrb_link_graphics_text_current_t *text_cmd = (fmrb_link_graphics_text_current_t*)cmd_buffer;
+        text_cmd->canvas_id = canvas_id;
+        text_cmd->x = x;
+        text_cmd->y = y;
+        text_cmd->text_len = text_len;
+        memcpy(cmd_buffer + sizeof(fmrb_link_graphics_text_current_t), text, text_len);
+
+        fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_DRAW_STRING_CURRENT, cmd_buffer, total_size);
+        fmrb_sys_free(cmd_buffer);
+        if (ret == FMRB_GFX_OK) {
+            ctx->stats.text_sent++;
+            ctx->stats.text_style_reused++;
+        }
+        return ret;
+    }
+
     // Allocate buffer for command + text
     size_t total_size = sizeof(fmrb_link_graphics_text_t) + text_len;
     uint8_t *cmd_buffer = fmrb_sys_malloc(total_size);
@@ -349,6 +479,14 @@ fmrb_gfx_err_t fmrb_gfx_draw_text(fmrb_gfx_context_t context, fmrb_canvas_handle
     fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_DRAW_STRING, cmd_buffer, total_size);
     fmrb_sys_free(cmd_buffer);
 
+    // DRAW_STRING leaves its color set on the host canvas
+    ctx->text_fg = color;
+    ctx->text_bg = effective_bg;
+    ctx->text_color_valid = (ret == FMRB_GFX_OK);
+    if (ret == FMRB_GFX_OK) {
+        ctx->stats.text_sent++;
+    }
+
     return ret;
 }
 
@@ -692,6 +830,134 @@ fmrb_gfx_err_t fmrb_gfx_fill_triangle(fmrb_gfx_context_t context, fmrb_canvas_ha
     return send_graphics_command(ctx, FMRB_LINK_GFX_FILL_TRIANGLE, &cmd, sizeof(cmd));
 }
 
+// Helper function to encode and send one point-list command
+// Uses FMRB_LINK_GFX_POINTS_DELTA8 when every step between points fits in int8
+static fmrb_gfx_err_t send_points_command(fmrb_gfx_context_impl_t *ctx, uint8_t cmd_type, fmrb_canvas_handle_t canvas_id,
+                                          const fmrb_point_t *points, uint16_t count, fmrb_color_t color) {
+    bool use_delta = true;
+    for (uint16_t i = 1; i < count; i++) {
+        int32_t dx = (int32_t)points[i].x - points[i - 1].x;
+        int32_t dy = (int32_t)points[i].y - points[i - 1].y;
+        if (dx < INT8_MIN || dx > INT8_MAX || dy < INT8_MIN || dy > INT8_MAX) {
+            use_delta = false;
+            break;
+        }
+    }
+
+    size_t data_size = use_delta ? (sizeof(int16_t) * 2 + (size_t)(count - 1) * 2)
+                                 : (sizeof(int16_t) * 2 * (size_t)count);
+    size_t total_size = sizeof(fmrb_link_graphics_points_t) + data_size;
+    uint8_t *cmd_buffer = fmrb_sys_malloc(total_size);
+    if (!cmd_buffer) {
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    fmrb_link_graphics_points_t *cmd = (fmrb_link_graphics_points_t*)cmd_buffer;
+    cmd->canvas_id = canvas_id;
+    cmd->color = color;
+    cmd->encoding = use_delta ? FMRB_LINK_GFX_POINTS_DELTA8 : FMRB_LINK_GFX_POINTS_ABS16;
+    cmd->point_count = count;
+
+    uint8_t *p = cmd_buffer + sizeof(fmrb_link_graphics_points_t);
+    memcpy(p, &points[0].x, sizeof(int16_t));
+    memcpy(p + 2, &points[0].y, sizeof(int16_t));
+    p += 4;
+    for (uint16_t i = 1; i < count; i++) {
+        if (use_delta) {
+            *p++ = (uint8_t)(int8_t)(points[i].x - points[i - 1].x);
+            *p++ = (uint8_t)(int8_t)(points[i].y - points[i - 1].y);
+        } else {
+            memcpy(p, &points[i].x, sizeof(int16_t));
+            memcpy(p + 2, &points[i].y, sizeof(int16_t));
+            p += 4;
+        }
+    }
+
+    fmrb_gfx_err_t ret = send_graphics_command(ctx, cmd_type, cmd_buffer, total_size);
+    fmrb_sys_free(cmd_buffer);
+
+    return ret;
+}
+
+fmrb_gfx_err_t fmrb_gfx_draw_polyline(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color) {
+    if (!context || !points || count < 2) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    // Split long lists; consecutive parts share their boundary point
+    uint16_t start = 0;
+    while (start + 1 < count) {
+        uint16_t n = count - start;
+        if (n > FMRB_LINK_GFX_MAX_POINTS) {
+            n = FMRB_LINK_GFX_MAX_POINTS;
+        }
+        fmrb_gfx_err_t ret = send_points_command(ctx, FMRB_LINK_GFX_DRAW_POLYLINE, canvas_id, &points[start], n, color);
+        if (ret != FMRB_GFX_OK) {
+            return ret;
+        }
+        start += n - 1;
+    }
+
+    return FMRB_GFX_OK;
+}
+
+fmrb_gfx_err_t fmrb_gfx_draw_polygon(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color) {
+    if (!context || !points || count < 2 || count > FMRB_LINK_GFX_MAX_POINTS) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    return send_points_command(ctx, FMRB_LINK_GFX_DRAW_POLYGON, canvas_id, points, count, color);
+}
+
+fmrb_gfx_err_t fmrb_gfx_fill_polygon(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color) {
+    if (!context || !points || count < 3 || count > FMRB_LINK_GFX_MAX_POINTS) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    return send_points_command(ctx, FMRB_LINK_GFX_FILL_POLYGON, canvas_id, points, count, color);
+}
+
+fmrb_gfx_err_t fmrb_gfx_draw_points(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color) {
+    if (!context || !points) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    uint16_t start = 0;
+    while (start < count) {
+        uint16_t n = count - start;
+        if (n > FMRB_LINK_GFX_MAX_POINTS) {
+            n = FMRB_LINK_GFX_MAX_POINTS;
+        }
+        fmrb_gfx_err_t ret = send_points_command(ctx, FMRB_LINK_GFX_DRAW_POINTS, canvas_id, &points[start], n, color);
+        if (ret != FMRB_GFX_OK) {
+            return ret;
+        }
+        start += n;
+    }
+
+    return FMRB_GFX_OK;
+}
+
 fmrb_gfx_err_t fmrb_gfx_draw_arc(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, int32_t x, int32_t y, int32_t r0, int32_t r1, float angle0, float angle1, fmrb_color_t color) {
     if (!context) {
         return FMRB_GFX_ERR_INVALID_PARAM;
@@ -785,6 +1051,12 @@ fmrb_gfx_err_t fmrb_gfx_draw_string(fmrb_gfx_context_t context, fmrb_canvas_hand
     fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_DRAW_STRING, cmd_buffer, total_size);
     fmrb_sys_free(cmd_buffer);
 
+    // DRAW_STRING leaves its color (transparent background) set on the host canvas
+    text_state_select(ctx, canvas_id);
+    ctx->text_fg = color;
+    ctx->text_bg = color;
+    ctx->text_color_valid = (ret == FMRB_GFX_OK);
+
     return ret;
 }
 
@@ -803,16 +1075,21 @@ fmrb_gfx_err_t fmrb_gfx_set_text_size(fmrb_gfx_context_t context, fmrb_canvas_ha
         return FMRB_GFX_ERR_NOT_INITIALIZED;
     }
 
-    typedef struct __attribute__((packed)) {
-        uint8_t cmd_type;
-        float size;
-    } text_size_cmd_t;
+    text_state_select(ctx, canvas_id);
+    if (ctx->text_size_valid && ctx->text_size == size) {
+        ctx->stats.state_elided++;
+        return FMRB_GFX_OK;
+    }
 
-    text_size_cmd_t cmd = {
+    fmrb_link_graphics_text_size_t cmd = {
+        .canvas_id = canvas_id,
         .size = size
     };
 
-    return send_graphics_command(ctx, FMRB_LINK_GFX_SET_TEXT_SIZE, &cmd, sizeof(cmd));
+    fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_SET_TEXT_SIZE, &cmd, sizeof(cmd));
+    ctx->text_size = size;
+    ctx->text_size_valid = (ret == FMRB_GFX_OK);
+    return ret;
 }
 
 fmrb_gfx_err_t fmrb_gfx_set_text_color(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, fmrb_color_t fg, fmrb_color_t bg) {
@@ -825,18 +1102,23 @@ fmrb_gfx_err_t fmrb_gfx_set_text_color(fmrb_gfx_context_t context, fmrb_canvas_h
         return FMRB_GFX_ERR_NOT_INITIALIZED;
     }
 
-    typedef struct __attribute__((packed)) {
-        uint8_t cmd_type;
-        uint8_t fg;
-        uint8_t bg;
-    } text_color_cmd_t;
+    text_state_select(ctx, canvas_id);
+    if (ctx->text_color_valid && ctx->text_fg == fg && ctx->text_bg == bg) {
+        ctx->stats.state_elided++;
+        return FMRB_GFX_OK;
+    }
 
-    text_color_cmd_t cmd = {
+    fmrb_link_graphics_text_color_t cmd = {
+        .canvas_id = canvas_id,
         .fg = fg,
         .bg = bg
     };
 
-    return send_graphics_command(ctx, FMRB_LINK_GFX_SET_TEXT_COLOR, &cmd, sizeof(cmd));
+    fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_SET_TEXT_COLOR, &cmd, sizeof(cmd));
+    ctx->text_fg = fg;
+    ctx->text_bg = bg;
+    ctx->text_color_valid = (ret == FMRB_GFX_OK);
+    return ret;
 }
 
 fmrb_gfx_err_t fmrb_gfx_fill_screen(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, fmrb_color_t color) {
@@ -917,6 +1199,10 @@ fmrb_gfx_err_t fmrb_gfx_delete_canvas(
     // If deleting current target, switch back to screen
     if (ctx->current_target == canvas_handle) {
         ctx->current_target = FMRB_CANVAS_SCREEN;
+        ctx->target_sent = false;
+    }
+    if (ctx->text_canvas == canvas_handle) {
+        ctx->text_canvas = FMRB_CANVAS_INVALID;
     }
 
     // Send delete canvas command to host
@@ -932,6 +1218,102 @@ fmrb_gfx_err_t fmrb_gfx_delete_canvas(
     return ret;
 }
 
+// Frame commands carry the title inline after the fixed header
+static size_t copy_frame_title(uint8_t *dst, const char *title) {
+    size_t len = title ? strlen(title) : 0;
+    if (len > FMRB_LINK_GFX_FRAME_TITLE_MAX) {
+        len = FMRB_LINK_GFX_FRAME_TITLE_MAX;
+    }
+    if (len > 0) {
+        memcpy(dst, title, len);
+    }
+    return len;
+}
+
+fmrb_gfx_err_t fmrb_gfx_set_window_frame(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    uint8_t style,
+    uint8_t flags,
+    const char *title)
+{
+    if (!context || canvas_handle == FMRB_CANVAS_SCREEN || canvas_handle == FMRB_CANVAS_INVALID ||
+        style > FMRB_LINK_GFX_FRAME_TITLED) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    uint8_t buf[sizeof(fmrb_link_graphics_window_frame_t) + FMRB_LINK_GFX_FRAME_TITLE_MAX];
+    fmrb_link_graphics_window_frame_t cmd = {
+        .canvas_id = canvas_handle,
+        .style = style,
+        .flags = flags,
+        .title_len = (uint8_t)copy_frame_title(buf + sizeof(cmd), title)
+    };
+    memcpy(buf, &cmd, sizeof(cmd));
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_SET_WINDOW_FRAME, buf, sizeof(cmd) + cmd.title_len);
+}
+
+fmrb_gfx_err_t fmrb_gfx_set_window_title(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    const char *title)
+{
+    if (!context || canvas_handle == FMRB_CANVAS_SCREEN || canvas_handle == FMRB_CANVAS_INVALID) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    uint8_t buf[sizeof(fmrb_link_graphics_window_title_t) + FMRB_LINK_GFX_FRAME_TITLE_MAX];
+    fmrb_link_graphics_window_title_t cmd = {
+        .canvas_id = canvas_handle,
+        .title_len = (uint8_t)copy_frame_title(buf + sizeof(cmd), title)
+    };
+    memcpy(buf, &cmd, sizeof(cmd));
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_SET_WINDOW_TITLE, buf, sizeof(cmd) + cmd.title_len);
+}
+
+fmrb_gfx_frame_hit_t fmrb_gfx_frame_hit_test(
+    uint8_t style, uint8_t flags,
+    int32_t width, int32_t height,
+    int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+        return FMRB_GFX_FRAME_HIT_NONE;
+    }
+    if (style != FMRB_LINK_GFX_FRAME_TITLED) {
+        return FMRB_GFX_FRAME_HIT_CLIENT;
+    }
+
+    // Grip and close button sit on top of the border and title bar, so test them first
+    if ((flags & FMRB_LINK_GFX_FRAME_FLAG_RESIZE) &&
+        x >= width - FMRB_LINK_GFX_FRAME_GRIP_SIZE && y >= height - FMRB_LINK_GFX_FRAME_GRIP_SIZE) {
+        return FMRB_GFX_FRAME_HIT_RESIZE;
+    }
+    if (y < FMRB_LINK_GFX_FRAME_TITLE_HEIGHT) {
+        const int32_t close_x = width - FMRB_LINK_GFX_FRAME_BUTTON_SIZE - 2;
+        if ((flags & FMRB_LINK_GFX_FRAME_FLAG_CLOSE) && x >= close_x - 2) {
+            return FMRB_GFX_FRAME_HIT_CLOSE;  // Button plus its margin, so a near miss doesn't start a drag
+        }
+        return FMRB_GFX_FRAME_HIT_TITLE;
+    }
+    if (x < FMRB_LINK_GFX_FRAME_BORDER || x >= width - FMRB_LINK_GFX_FRAME_BORDER ||
+        y >= height - FMRB_LINK_GFX_FRAME_BORDER) {
+        return FMRB_GFX_FRAME_HIT_BORDER;
+    }
+    return FMRB_GFX_FRAME_HIT_CLIENT;
+}
+
 fmrb_gfx_err_t fmrb_gfx_set_target(
     fmrb_gfx_context_t context,
     fmrb_canvas_handle_t target)
@@ -948,6 +1330,12 @@ fmrb_gfx_err_t fmrb_gfx_set_target(
         return FMRB_GFX_ERR_NOT_INITIALIZED;
     }
 
+    // Host already draws to this target
+    if (ctx->target_sent && ctx->current_target == target) {
+        ctx->stats.state_elided++;
+        return FMRB_GFX_OK;
+    }
+
     // Update local state
     ctx->current_target = target;
 
@@ -957,6 +1345,7 @@ fmrb_gfx_err_t fmrb_gfx_set_target(
     };
 
     fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_SET_TARGET, &cmd, sizeof(cmd));
+    ctx->target_sent = (ret == FMRB_GFX_OK);
     if (ret == FMRB_GFX_OK) {
         ESP_LOGD(TAG, "Drawing target set: ID=%u %s", target,
                  target == FMRB_CANVAS_SCREEN ? "(screen)" : "(canvas)");
@@ -996,7 +1385,126 @@ fmrb_gfx_err_t fmrb_gfx_push_canvas(
         .use_transparency = (transparent_color == 0xFF) ? 0 : 1
     };
 
-    return send_graphics_command(ctx, FMRB_LINK_GFX_PUSH_CANVAS, &cmd, sizeof(cmd));
+    fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_PUSH_CANVAS, &cmd, sizeof(cmd));
+    if (ret == FMRB_GFX_OK && dest_canvas == FMRB_CANVAS_RENDER) {
+        ctx->render_pushes++;
+    }
+    return ret;
+}
+
+fmrb_gfx_err_t fmrb_gfx_copy_rect(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t src_canvas,
+    const fmrb_rect_t *src_rect,
+    fmrb_canvas_handle_t dst_canvas,
+    int16_t dst_x, int16_t dst_y)
+{
+    if (!context || !src_rect || src_canvas == FMRB_CANVAS_INVALID || dst_canvas == FMRB_CANVAS_INVALID) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_copy_rect_t cmd = {
+        .src_canvas_id = src_canvas,
+        .dst_canvas_id = dst_canvas,
+        .src_x = src_rect->x,
+        .src_y = src_rect->y,
+        .width = src_rect->width,
+        .height = src_rect->height,
+        .dst_x = dst_x,
+        .dst_y = dst_y
+    };
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_COPY_RECT, &cmd, sizeof(cmd));
+}
+
+fmrb_gfx_err_t fmrb_gfx_scroll_rect(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    const fmrb_rect_t *rect,
+    int16_t dx, int16_t dy,
+    fmrb_color_t fill_color)
+{
+    if (!context || !rect) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_scroll_rect_t cmd = {
+        .canvas_id = canvas_id,
+        .x = rect->x,
+        .y = rect->y,
+        .width = rect->width,
+        .height = rect->height,
+        .dx = dx,
+        .dy = dy,
+        .fill_color = fill_color
+    };
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_SCROLL_RECT, &cmd, sizeof(cmd));
+}
+
+fmrb_gfx_err_t fmrb_gfx_set_palette(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    const fmrb_color_t *palette)
+{
+    if (!context || canvas_handle == FMRB_CANVAS_SCREEN || canvas_handle == FMRB_CANVAS_INVALID) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    uint8_t cmd_buffer[sizeof(fmrb_link_graphics_set_palette_t) + FMRB_LINK_GFX_PALETTE_SIZE];
+    fmrb_link_graphics_set_palette_t *cmd = (fmrb_link_graphics_set_palette_t*)cmd_buffer;
+    cmd->canvas_id = canvas_handle;
+    cmd->indexed = palette ? 1 : 0;
+
+    size_t total_size = sizeof(fmrb_link_graphics_set_palette_t);
+    if (palette) {
+        memcpy(cmd_buffer + total_size, palette, FMRB_LINK_GFX_PALETTE_SIZE);
+        total_size += FMRB_LINK_GFX_PALETTE_SIZE;
+    }
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_SET_PALETTE, cmd_buffer, total_size);
+}
+
+fmrb_gfx_err_t fmrb_gfx_set_palette_range(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    uint8_t start,
+    uint16_t count,
+    const fmrb_color_t *colors)
+{
+    if (!context || !colors || count == 0 || start + count > FMRB_LINK_GFX_PALETTE_SIZE) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    uint8_t cmd_buffer[sizeof(fmrb_link_graphics_set_palette_range_t) + FMRB_LINK_GFX_PALETTE_SIZE];
+    fmrb_link_graphics_set_palette_range_t *cmd = (fmrb_link_graphics_set_palette_range_t*)cmd_buffer;
+    cmd->canvas_id = canvas_handle;
+    cmd->start = start;
+    cmd->count = count;
+    memcpy(cmd_buffer + sizeof(fmrb_link_graphics_set_palette_range_t), colors, count);
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_SET_PALETTE_RANGE, cmd_buffer,
+                                 sizeof(fmrb_link_graphics_set_palette_range_t) + count);
 }
 
 // Cursor control API
@@ -1053,3 +1561,358 @@ fmrb_gfx_err_t fmrb_gfx_set_cursor_visible(
 
     return ret;
 }
+
+fmrb_gfx_err_t fmrb_gfx_set_cursor_shape(
+    fmrb_gfx_context_t context,
+    fmrb_gfx_cursor_shape_t shape)
+{
+    if (!context || (unsigned)shape >= FMRB_LINK_GFX_CURSOR_SHAPES) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_cursor_shape_t cmd = {
+        .shape = (uint8_t)shape
+    };
+
+    fmrb_gfx_err_t ret = send_graphics_command(ctx, FMRB_LINK_GFX_CURSOR_SET_SHAPE, &cmd, sizeof(cmd));
+    if (ret == FMRB_GFX_OK) {
+        ESP_LOGD(TAG, "Cursor shape set: %d", shape);
+    }
+
+    return ret;
+}
+
+// Tile layer API
+
+fmrb_gfx_err_t fmrb_gfx_tilemap_create(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    uint8_t tile_w, uint8_t tile_h,
+    uint16_t map_w, uint16_t map_h,
+    fmrb_color_t transparent_color)
+{
+    if (!context || canvas_id == FMRB_CANVAS_SCREEN || layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS ||
+        tile_w == 0 || tile_h == 0 || map_w == 0 || map_h == 0) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_tilemap_create_t cmd = {
+        .canvas_id = canvas_id,
+        .layer = layer,
+        .tile_w = tile_w,
+        .tile_h = tile_h,
+        .map_w = map_w,
+        .map_h = map_h,
+        .transparent_color = transparent_color
+    };
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_TILEMAP_CREATE, &cmd, sizeof(cmd));
+}
+
+fmrb_gfx_err_t fmrb_gfx_tilemap_delete(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer)
+{
+    if (!context || layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_tilemap_delete_t cmd = {
+        .canvas_id = canvas_id,
+        .layer = layer
+    };
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_TILEMAP_DELETE, &cmd, sizeof(cmd));
+}
+
+fmrb_gfx_err_t fmrb_gfx_tilemap_set_sheet(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    const uint8_t *pixels,
+    uint16_t sheet_w, uint16_t sheet_h)
+{
+    if (!context || !pixels || layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS || sheet_w == 0 || sheet_h == 0) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    uint8_t *cmd_buffer = fmrb_sys_malloc(sizeof(fmrb_link_graphics_tilemap_sheet_t) + FMRB_LINK_GFX_TILE_CHUNK_SIZE);
+    if (!cmd_buffer) {
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    fmrb_link_graphics_tilemap_sheet_t *cmd = (fmrb_link_graphics_tilemap_sheet_t*)cmd_buffer;
+    cmd->canvas_id = canvas_id;
+    cmd->layer = layer;
+    cmd->sheet_w = sheet_w;
+    cmd->sheet_h = sheet_h;
+
+    // The first chunk (offset 0) makes the host (re)allocate the sheet
+    uint32_t total = (uint32_t)sheet_w * sheet_h;
+    fmrb_gfx_err_t ret = FMRB_GFX_OK;
+    for (uint32_t offset = 0; offset < total && ret == FMRB_GFX_OK; offset += FMRB_LINK_GFX_TILE_CHUNK_SIZE) {
+        uint32_t length = total - offset;
+        if (length > FMRB_LINK_GFX_TILE_CHUNK_SIZE) {
+            length = FMRB_LINK_GFX_TILE_CHUNK_SIZE;
+        }
+        cmd->offset = offset;
+        cmd->length = (uint16_t)length;
+        memcpy(cmd_buffer + sizeof(fmrb_link_graphics_tilemap_sheet_t), pixels + offset, length);
+        ret = send_graphics_command(ctx, FMRB_LINK_GFX_TILEMAP_SET_SHEET, cmd_buffer,
+                                    sizeof(fmrb_link_graphics_tilemap_sheet_t) + length);
+    }
+
+    fmrb_sys_free(cmd_buffer);
+    return ret;
+}
+
+fmrb_gfx_err_t fmrb_gfx_tilemap_set_cells(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    uint16_t x, uint16_t y,
+    uint16_t w, uint16_t h,
+    const uint8_t *tiles)
+{
+    if (!context || !tiles || layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS ||
+        w == 0 || h == 0 || w > FMRB_LINK_GFX_TILE_CHUNK_SIZE) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    // Send as bands of whole rows that fit one chunk
+    uint16_t rows_per_cmd = FMRB_LINK_GFX_TILE_CHUNK_SIZE / w;
+    if (rows_per_cmd > h) {
+        rows_per_cmd = h;
+    }
+
+    uint8_t *cmd_buffer = fmrb_sys_malloc(sizeof(fmrb_link_graphics_tilemap_cells_t) + (size_t)w * rows_per_cmd);
+    if (!cmd_buffer) {
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    fmrb_link_graphics_tilemap_cells_t *cmd = (fmrb_link_graphics_tilemap_cells_t*)cmd_buffer;
+    cmd->canvas_id = canvas_id;
+    cmd->layer = layer;
+    cmd->x = x;
+    cmd->w = w;
+
+    fmrb_gfx_err_t ret = FMRB_GFX_OK;
+    for (uint16_t row = 0; row < h && ret == FMRB_GFX_OK; row += rows_per_cmd) {
+        uint16_t rows = h - row;
+        if (rows > rows_per_cmd) {
+            rows = rows_per_cmd;
+        }
+        cmd->y = y + row;
+        cmd->h = rows;
+        size_t length = (size_t)w * rows;
+        memcpy(cmd_buffer + sizeof(fmrb_link_graphics_tilemap_cells_t), tiles + (size_t)w * row, length);
+        ret = send_graphics_command(ctx, FMRB_LINK_GFX_TILEMAP_SET_CELLS, cmd_buffer,
+                                    sizeof(fmrb_link_graphics_tilemap_cells_t) + length);
+    }
+
+    fmrb_sys_free(cmd_buffer);
+    return ret;
+}
+
+fmrb_gfx_err_t fmrb_gfx_tilemap_scroll(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    int16_t scroll_x, int16_t scroll_y)
+{
+    if (!context || layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_tilemap_scroll_t cmd = {
+        .canvas_id = canvas_id,
+        .layer = layer,
+        .scroll_x = scroll_x,
+        .scroll_y = scroll_y
+    };
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_TILEMAP_SCROLL, &cmd, sizeof(cmd));
+}
+
+fmrb_gfx_err_t fmrb_gfx_list_begin(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t list_id,
+    const fmrb_color_t *slot_colors,
+    uint8_t slot_count,
+    fmrb_gfx_list_recorder_t **recorder)
+{
+    if (!context || !recorder || list_id >= FMRB_LINK_GFX_MAX_LISTS ||
+        slot_count > FMRB_LINK_GFX_LIST_MAX_SLOTS || (slot_count > 0 && !slot_colors)) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+    if (ctx->recorder) {
+        return FMRB_GFX_ERR_INVALID_PARAM;  // Lists do not nest
+    }
+
+    fmrb_gfx_list_recorder_t *rec = fmrb_sys_malloc(sizeof(fmrb_gfx_list_recorder_t));
+    if (!rec) {
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    rec->ctx = *ctx;
+    rec->ctx.recorder = rec;
+    // A replay starts from whatever text state the canvas has, so record it explicitly
+    rec->ctx.text_canvas = FMRB_CANVAS_INVALID;
+    rec->base = ctx;
+    rec->canvas_id = canvas_id;
+    rec->list_id = list_id;
+    rec->slot_count = slot_count;
+    memset(rec->slot_colors, 0, sizeof(rec->slot_colors));
+    if (slot_count > 0) {
+        memcpy(rec->slot_colors, slot_colors, slot_count);
+    }
+    rec->len = 0;
+    rec->overflow = false;
+
+    *recorder = rec;
+    return FMRB_GFX_OK;
+}
+
+fmrb_gfx_context_t fmrb_gfx_list_context(fmrb_gfx_list_recorder_t *recorder) {
+    return recorder ? &recorder->ctx : NULL;
+}
+
+void fmrb_gfx_list_abort(fmrb_gfx_list_recorder_t *recorder) {
+    if (recorder) {
+        fmrb_sys_free(recorder);
+    }
+}
+
+fmrb_gfx_err_t fmrb_gfx_list_end(fmrb_gfx_list_recorder_t *recorder) {
+    if (!recorder) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_list_recorder_t *rec = recorder;
+    if (rec->overflow) {
+        ESP_LOGE(TAG, "Display list %u exceeds %d bytes", rec->list_id, FMRB_LINK_GFX_LIST_MAX_SIZE);
+        fmrb_gfx_list_abort(rec);
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    size_t total_size = sizeof(fmrb_link_graphics_define_list_t) + rec->len;
+    uint8_t *cmd_buffer = fmrb_sys_malloc(total_size);
+    if (!cmd_buffer) {
+        fmrb_gfx_list_abort(rec);
+        return FMRB_GFX_ERR_NO_MEMORY;
+    }
+
+    fmrb_link_graphics_define_list_t *cmd = (fmrb_link_graphics_define_list_t*)cmd_buffer;
+    cmd->canvas_id = rec->canvas_id;
+    cmd->list_id = rec->list_id;
+    cmd->slot_count = rec->slot_count;
+    memcpy(cmd->slot_colors, rec->slot_colors, sizeof(cmd->slot_colors));
+    cmd->data_len = rec->len;
+    memcpy(cmd_buffer + sizeof(fmrb_link_graphics_define_list_t), rec->data, rec->len);
+
+    fmrb_gfx_err_t ret = send_graphics_command(rec->base, FMRB_LINK_GFX_DEFINE_LIST, cmd_buffer, total_size);
+    if (ret == FMRB_GFX_OK) {
+        ESP_LOGD(TAG, "Display list defined: canvas=%u id=%u (%u bytes)", rec->canvas_id, rec->list_id, rec->len);
+    }
+
+    fmrb_sys_free(cmd_buffer);
+    fmrb_gfx_list_abort(rec);
+    return ret;
+}
+
+fmrb_gfx_err_t fmrb_gfx_call_list(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t list_id,
+    int16_t dx, int16_t dy,
+    const fmrb_color_t *colors,
+    uint8_t color_count)
+{
+    if (!context || list_id >= FMRB_LINK_GFX_MAX_LISTS ||
+        color_count > FMRB_LINK_GFX_LIST_MAX_SLOTS || (color_count > 0 && !colors)) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_call_list_t cmd = {
+        .canvas_id = canvas_id,
+        .list_id = list_id,
+        .color_count = color_count,
+        .dx = dx,
+        .dy = dy
+    };
+    if (color_count > 0) {
+        memcpy(cmd.colors, colors, color_count);
+    }
+
+    // The list may change the canvas text state
+    if (ctx->text_canvas == canvas_id) {
+        ctx->text_canvas = FMRB_CANVAS_INVALID;
+    }
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_CALL_LIST, &cmd, sizeof(cmd));
+}
+
+fmrb_gfx_err_t fmrb_gfx_delete_list(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t list_id)
+{
+    if (!context || list_id >= FMRB_LINK_GFX_MAX_LISTS) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_context_impl_t *ctx = context;
+    if (!ctx->initialized) {
+        return FMRB_GFX_ERR_NOT_INITIALIZED;
+    }
+
+    fmrb_link_graphics_delete_list_t cmd = {
+        .canvas_id = canvas_id,
+        .list_id = list_id
+    };
+
+    return send_graphics_command(ctx, FMRB_LINK_GFX_DELETE_LIST, &cmd, sizeof(cmd));
+}
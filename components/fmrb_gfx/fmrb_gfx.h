@@ -33,6 +33,42 @@ typedef enum {
 // Text buffer size for draw_text commands
 #define FMRB_GFX_MAX_TEXT_LEN 256
 
+// Point buffer size for buffered point-list commands (polyline, polygon, points)
+#define FMRB_GFX_MAX_CMD_POINTS 64
+
+// Display list ids per canvas and color slots per list (match fmrb_link_protocol.h)
+#define FMRB_GFX_MAX_LISTS 16
+#define FMRB_GFX_LIST_MAX_SLOTS 8
+
+// Buffered display list operations (see fmrb_gfx_list_begin)
+typedef enum {
+    FMRB_GFX_LIST_BEGIN,   // Following commands are recorded
+    FMRB_GFX_LIST_END,     // Send the recorded list
+    FMRB_GFX_LIST_CALL,
+    FMRB_GFX_LIST_DELETE
+} fmrb_gfx_list_op_t;
+
+// Window frame styles, flags and geometry (match fmrb_link_protocol.h)
+#define FMRB_GFX_FRAME_NONE          0
+#define FMRB_GFX_FRAME_TITLED        1
+#define FMRB_GFX_FRAME_FLAG_CLOSE    0x01
+#define FMRB_GFX_FRAME_FLAG_RESIZE   0x02
+#define FMRB_GFX_FRAME_BORDER        1
+#define FMRB_GFX_FRAME_TITLE_HEIGHT  11
+#define FMRB_GFX_FRAME_BUTTON_SIZE   8
+#define FMRB_GFX_FRAME_GRIP_SIZE     10
+#define FMRB_GFX_FRAME_TITLE_MAX     31
+
+// Window frame hit-test result (see fmrb_gfx_frame_hit_test)
+typedef enum {
+    FMRB_GFX_FRAME_HIT_NONE,     // Outside the window
+    FMRB_GFX_FRAME_HIT_CLIENT,   // App-drawn area
+    FMRB_GFX_FRAME_HIT_TITLE,    // Title bar (drag)
+    FMRB_GFX_FRAME_HIT_CLOSE,    // Close button
+    FMRB_GFX_FRAME_HIT_RESIZE,   // Resize grip
+    FMRB_GFX_FRAME_HIT_BORDER    // Border pixels
+} fmrb_gfx_frame_hit_t;
+
 // Graphics error codes
 typedef enum {
     FMRB_GFX_OK = 0,
@@ -63,6 +99,17 @@ typedef struct {
 typedef void* fmrb_link_transport_handle_t;
 #endif
 
+// Encoder statistics (state commands sent vs. dropped as redundant)
+typedef struct {
+    uint32_t commands_sent;      // Commands handed to the transport
+    uint32_t state_elided;       // SET_TARGET / SET_TEXT_* changes that matched the current state
+    uint32_t text_sent;          // Strings sent in either form
+    uint32_t text_style_reused;  // Strings sent in the compact form that reuses the current text color
+} fmrb_gfx_stats_t;
+
+// Display list recorder (see fmrb_gfx_list_begin)
+typedef struct fmrb_gfx_list_recorder fmrb_gfx_list_recorder_t;
+
 // Graphics context implementation structure
 typedef struct {
     fmrb_gfx_config_t config;
@@ -72,6 +119,17 @@ typedef struct {
     bool initialized;
     fmrb_canvas_handle_t current_target;  // 0=screen, other=canvas
     uint16_t next_canvas_id;              // Canvas ID generator
+    // Shadow of the state last sent to the host, used to drop redundant state changes
+    bool target_sent;                     // current_target has been sent to the host
+    fmrb_canvas_handle_t text_canvas;     // Canvas the text state belongs to (FMRB_CANVAS_INVALID = unknown)
+    fmrb_color_t text_fg;
+    fmrb_color_t text_bg;                 // Equal to text_fg for a transparent background
+    bool text_color_valid;
+    float text_size;
+    bool text_size_valid;
+    fmrb_gfx_stats_t stats;
+    uint32_t render_pushes;               // Canvases pushed to FMRB_CANVAS_RENDER (matches the host's FRAME_DONE count)
+    fmrb_gfx_list_recorder_t *recorder;   // Non-NULL: draw commands are recorded instead of sent
 } fmrb_gfx_context_impl_t;
 
 // Graphics context handle
@@ -128,6 +186,17 @@ fmrb_gfx_err_t fmrb_gfx_deinit(void);
  */
 fmrb_gfx_context_t fmrb_gfx_get_global_context(void);
 
+/**
+ * @brief Get encoder statistics
+ * @param context Graphics context
+ * @param stats Output statistics
+ * @return Graphics error code
+ *
+ * Reports how many commands were sent and how many state changes were
+ * dropped because the host already had that state.
+ */
+fmrb_gfx_err_t fmrb_gfx_get_stats(fmrb_gfx_context_t context, fmrb_gfx_stats_t *stats);
+
 /**
  * @brief Clear screen with specified color
  * @param context Graphics context
@@ -389,6 +458,54 @@ fmrb_gfx_err_t fmrb_gfx_draw_triangle(fmrb_gfx_context_t context, fmrb_canvas_ha
  */
 fmrb_gfx_err_t fmrb_gfx_fill_triangle(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, fmrb_color_t color);
 
+/**
+ * @brief Draw connected line segments through a list of points
+ * @param context Graphics context
+ * @param canvas_id Target canvas ID
+ * @param points Point array
+ * @param count Number of points (at least 2)
+ * @param color Line color
+ * @return Graphics error code
+ *
+ * Sent as a single point-list command; the point array is delta-encoded
+ * on the link when every step fits in int8. Lists longer than
+ * FMRB_LINK_GFX_MAX_POINTS are split with one shared point per split.
+ */
+fmrb_gfx_err_t fmrb_gfx_draw_polyline(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color);
+
+/**
+ * @brief Draw closed polygon outline
+ * @param context Graphics context
+ * @param canvas_id Target canvas ID
+ * @param points Vertex array
+ * @param count Number of vertices (2 to FMRB_LINK_GFX_MAX_POINTS)
+ * @param color Outline color
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_draw_polygon(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color);
+
+/**
+ * @brief Draw filled polygon (even-odd rule)
+ * @param context Graphics context
+ * @param canvas_id Target canvas ID
+ * @param points Vertex array
+ * @param count Number of vertices (3 to FMRB_LINK_GFX_MAX_POINTS)
+ * @param color Fill color
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_fill_polygon(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color);
+
+/**
+ * @brief Draw a list of individual pixels in one color
+ * @param context Graphics context
+ * @param canvas_id Target canvas ID
+ * @param points Point array
+ * @param count Number of points
+ * @param color Pixel color
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_draw_points(fmrb_gfx_context_t context, fmrb_canvas_handle_t canvas_id, const fmrb_point_t *points, uint16_t count, fmrb_color_t color);
+
 /**
  * @brief Draw arc (LovyanGFX compatible)
  * @param context Graphics context
@@ -499,6 +616,52 @@ fmrb_gfx_err_t fmrb_gfx_delete_canvas(
     fmrb_gfx_context_t context,
     fmrb_canvas_handle_t canvas_handle);
 
+/**
+ * @brief Set the compositor-drawn frame of a canvas window
+ * @param context Graphics context
+ * @param canvas_handle Canvas handle
+ * @param style FMRB_GFX_FRAME_NONE or FMRB_GFX_FRAME_TITLED
+ * @param flags FMRB_GFX_FRAME_FLAG_* bits
+ * @param title Title text (truncated to FMRB_GFX_FRAME_TITLE_MAX bytes, NULL for none)
+ * @return Graphics error code
+ *
+ * The host draws the frame over the canvas edges when compositing, so it
+ * survives resizes and app redraws. Sent immediately, never buffered or recorded.
+ */
+fmrb_gfx_err_t fmrb_gfx_set_window_frame(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    uint8_t style,
+    uint8_t flags,
+    const char *title);
+
+/**
+ * @brief Change the title shown in a canvas window frame
+ * @param context Graphics context
+ * @param canvas_handle Canvas handle
+ * @param title Title text (truncated to FMRB_GFX_FRAME_TITLE_MAX bytes)
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_set_window_title(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    const char *title);
+
+/**
+ * @brief Classify a window-relative point against a frame
+ * @param style Frame style
+ * @param flags Frame flags
+ * @param width Outer window width
+ * @param height Outer window height
+ * @param x X relative to the window origin
+ * @param y Y relative to the window origin
+ * @return Frame part under the point
+ */
+fmrb_gfx_frame_hit_t fmrb_gfx_frame_hit_test(
+    uint8_t style, uint8_t flags,
+    int32_t width, int32_t height,
+    int32_t x, int32_t y);
+
 /**
  * @brief Set drawing target (screen or canvas)
  * @param context Graphics context
@@ -531,16 +694,97 @@ fmrb_gfx_err_t fmrb_gfx_push_canvas(
     int32_t x, int32_t y,
     fmrb_color_t transparent_color);
 
+/**
+ * @brief Copy a rectangle of pixels within a canvas or between canvases
+ * @param context Graphics context
+ * @param src_canvas Source canvas
+ * @param src_rect Source rectangle
+ * @param dst_canvas Destination canvas (may be the source canvas; overlap is handled)
+ * @param dst_x Destination X coordinate
+ * @param dst_y Destination Y coordinate
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_copy_rect(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t src_canvas,
+    const fmrb_rect_t *src_rect,
+    fmrb_canvas_handle_t dst_canvas,
+    int16_t dst_x, int16_t dst_y);
+
+/**
+ * @brief Scroll the pixels inside a rectangle and fill the exposed area
+ * @param context Graphics context
+ * @param canvas_id Target canvas
+ * @param rect Region to scroll
+ * @param dx Horizontal shift (negative = left)
+ * @param dy Vertical shift (negative = up)
+ * @param fill_color Color of the area uncovered by the shift
+ * @return Graphics error code
+ *
+ * Use case: terminal and list scrolling, where only the newly exposed
+ * line has to be drawn afterwards.
+ */
+fmrb_gfx_err_t fmrb_gfx_scroll_rect(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    const fmrb_rect_t *rect,
+    int16_t dx, int16_t dy,
+    fmrb_color_t fill_color);
+
+/**
+ * @brief Switch a canvas between direct color and indexed mode
+ * @param context Graphics context
+ * @param canvas_handle Canvas to configure
+ * @param palette 256 RGB332 entries to enable indexed mode, or NULL for direct color
+ * @return Graphics error code
+ *
+ * In indexed mode each canvas pixel is a palette index, resolved when the
+ * canvas is composited to the screen, so palette changes recolor the whole
+ * canvas without redrawing it. The bottom (system) canvas is always direct.
+ */
+fmrb_gfx_err_t fmrb_gfx_set_palette(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    const fmrb_color_t *palette);
+
+/**
+ * @brief Update part of an indexed canvas palette
+ * @param context Graphics context
+ * @param canvas_handle Canvas to update
+ * @param start First palette index
+ * @param count Number of entries (start + count <= 256)
+ * @param colors RGB332 entries
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_set_palette_range(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_handle,
+    uint8_t start,
+    uint16_t count,
+    const fmrb_color_t *colors);
+
 // Cursor control API (global resource)
+//
+// The host draws the cursor where its own pointer input puts it, so mouse
+// motion never has to round-trip through the core. The core only warps it,
+// shows or hides it and picks its shape.
+
+// Cursor shapes (match fmrb_link_protocol.h)
+typedef enum {
+    FMRB_GFX_CURSOR_ARROW = 0,
+    FMRB_GFX_CURSOR_MOVE = 1,
+    FMRB_GFX_CURSOR_RESIZE = 2
+} fmrb_gfx_cursor_shape_t;
 
 /**
- * @brief Set cursor position
+ * @brief Warp the cursor to a position
  * @param context Graphics context
  * @param x Cursor X coordinate
  * @param y Cursor Y coordinate
  * @return Graphics error code
  *
- * Note: Cursor is a global resource shared across all canvases
+ * Note: Cursor is a global resource shared across all canvases.
+ * The next pointer motion on the host moves it again.
  */
 fmrb_gfx_err_t fmrb_gfx_set_cursor_position(
     fmrb_gfx_context_t context,
@@ -558,6 +802,200 @@ fmrb_gfx_err_t fmrb_gfx_set_cursor_visible(
     fmrb_gfx_context_t context,
     bool visible);
 
+/**
+ * @brief Set cursor shape
+ * @param context Graphics context
+ * @param shape Cursor shape
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_set_cursor_shape(
+    fmrb_gfx_context_t context,
+    fmrb_gfx_cursor_shape_t shape);
+
+// Tile layer API
+//
+// Up to FMRB_LINK_GFX_MAX_TILE_LAYERS tile layers can be attached to a canvas.
+// The host keeps the tile sheet and the map, and composites the layers under
+// the canvas draw buffer each time the canvas is pushed. An app uploads them
+// once, then sends cell deltas and scroll offsets per frame.
+
+/**
+ * @brief Create (or recreate) a tile layer on a canvas
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the layer
+ * @param layer Layer index (0 = back, drawn opaque)
+ * @param tile_w Tile width in pixels
+ * @param tile_h Tile height in pixels
+ * @param map_w Map width in cells
+ * @param map_h Map height in cells
+ * @param transparent_color Key color for upper layers and the draw buffer (0xFF = none)
+ * @return Graphics error code
+ *
+ * The key color is shared by the whole canvas: pixels of that color in the
+ * sheets of layers above 0, and in the draw buffer, show what lies beneath.
+ * All map cells start as FMRB_LINK_GFX_TILE_EMPTY.
+ */
+fmrb_gfx_err_t fmrb_gfx_tilemap_create(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    uint8_t tile_w, uint8_t tile_h,
+    uint16_t map_w, uint16_t map_h,
+    fmrb_color_t transparent_color);
+
+/**
+ * @brief Delete a tile layer
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the layer
+ * @param layer Layer index
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_tilemap_delete(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer);
+
+/**
+ * @brief Upload the tile sheet of a layer
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the layer
+ * @param layer Layer index
+ * @param pixels RGB332 pixels, sheet_w * sheet_h bytes
+ * @param sheet_w Sheet width in pixels (a multiple of the tile width)
+ * @param sheet_h Sheet height in pixels (a multiple of the tile height)
+ * @return Graphics error code
+ *
+ * Tiles are numbered left to right, top to bottom. The sheet is sent in
+ * FMRB_LINK_GFX_TILE_CHUNK_SIZE pieces.
+ */
+fmrb_gfx_err_t fmrb_gfx_tilemap_set_sheet(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    const uint8_t *pixels,
+    uint16_t sheet_w, uint16_t sheet_h);
+
+/**
+ * @brief Update a rectangle of map cells
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the layer
+ * @param layer Layer index
+ * @param x Left cell
+ * @param y Top cell
+ * @param w Width in cells (at most FMRB_LINK_GFX_TILE_CHUNK_SIZE)
+ * @param h Height in cells
+ * @param tiles Tile indices, w * h bytes in row-major order
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_tilemap_set_cells(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    uint16_t x, uint16_t y,
+    uint16_t w, uint16_t h,
+    const uint8_t *tiles);
+
+/**
+ * @brief Set the scroll offset of a tile layer
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the layer
+ * @param layer Layer index
+ * @param scroll_x Map pixel shown at the canvas left edge
+ * @param scroll_y Map pixel shown at the canvas top edge
+ * @return Graphics error code
+ *
+ * Takes effect at the next push of the canvas.
+ */
+fmrb_gfx_err_t fmrb_gfx_tilemap_scroll(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t layer,
+    int16_t scroll_x, int16_t scroll_y);
+
+// ============================================================================
+// Display lists
+// ============================================================================
+//
+// A display list is a sequence of draw commands kept by the host under a
+// small id (0..FMRB_LINK_GFX_MAX_LISTS-1) per canvas. It is recorded once and
+// replayed with a single CALL_LIST that carries an offset and replacement
+// colors, so static chrome costs a few bytes per redraw instead of a
+// command per primitive. Lists are freed with their canvas.
+
+/**
+ * @brief Start recording a display list
+ * @param context Graphics context the finished list is sent through
+ * @param canvas_id Canvas that owns the list
+ * @param list_id List id (redefining an id replaces the old list)
+ * @param slot_colors Recorded colors that fmrb_gfx_call_list may replace (can be NULL)
+ * @param slot_count Number of slot colors (at most FMRB_LINK_GFX_LIST_MAX_SLOTS)
+ * @param recorder Receives the recorder handle
+ * @return Graphics error code
+ *
+ * Draw on fmrb_gfx_list_context(recorder) to record; the canvas ids passed
+ * to those calls are ignored because a list always replays into its own
+ * canvas. Only primitives, text and point lists can be recorded.
+ */
+fmrb_gfx_err_t fmrb_gfx_list_begin(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t list_id,
+    const fmrb_color_t *slot_colors,
+    uint8_t slot_count,
+    fmrb_gfx_list_recorder_t **recorder);
+
+/**
+ * @brief Get the context that records into a display list
+ * @param recorder Recorder handle
+ * @return Graphics context to draw on while recording
+ */
+fmrb_gfx_context_t fmrb_gfx_list_context(fmrb_gfx_list_recorder_t *recorder);
+
+/**
+ * @brief Finish recording and send the list to the host
+ * @param recorder Recorder handle (freed by this call)
+ * @return Graphics error code (FMRB_GFX_ERR_NO_MEMORY if the list exceeded
+ *         FMRB_LINK_GFX_LIST_MAX_SIZE bytes)
+ */
+fmrb_gfx_err_t fmrb_gfx_list_end(fmrb_gfx_list_recorder_t *recorder);
+
+/**
+ * @brief Discard a recording without sending it
+ * @param recorder Recorder handle (freed by this call)
+ */
+void fmrb_gfx_list_abort(fmrb_gfx_list_recorder_t *recorder);
+
+/**
+ * @brief Replay a display list
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the list
+ * @param list_id List id
+ * @param dx Horizontal offset added to every recorded coordinate
+ * @param dy Vertical offset added to every recorded coordinate
+ * @param colors Replacement for the first color_count slot colors (can be NULL)
+ * @param color_count Number of replacement colors
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_call_list(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t list_id,
+    int16_t dx, int16_t dy,
+    const fmrb_color_t *colors,
+    uint8_t color_count);
+
+/**
+ * @brief Delete a display list
+ * @param context Graphics context
+ * @param canvas_id Canvas that owns the list
+ * @param list_id List id
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_delete_list(
+    fmrb_gfx_context_t context,
+    fmrb_canvas_handle_t canvas_id,
+    uint8_t list_id);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
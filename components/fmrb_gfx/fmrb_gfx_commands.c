@@ -13,7 +13,16 @@ typedef enum {
     FMRB_GFX_CMD_LINE,
     FMRB_GFX_CMD_RECT,
     FMRB_GFX_CMD_CIRCLE,
-    FMRB_GFX_CMD_TEXT
+    FMRB_GFX_CMD_TEXT,
+    FMRB_GFX_CMD_ROUND_RECT,
+    FMRB_GFX_CMD_ELLIPSE,
+    FMRB_GFX_CMD_TRIANGLE,
+    FMRB_GFX_CMD_POLYLINE,
+    FMRB_GFX_CMD_POLYGON,
+    FMRB_GFX_CMD_POINTS,
+    FMRB_GFX_CMD_COPY_RECT,
+    FMRB_GFX_CMD_SCROLL_RECT,
+    FMRB_GFX_CMD_LIST
 } fmrb_gfx_command_type_t;
 
 // Command structures
@@ -59,6 +68,61 @@ typedef struct {
     char text[256]; // Maximum text length
 } text_command_t;
 
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;
+    fmrb_rect_t rect;
+    int16_t radius;
+    fmrb_color_t color;
+    bool filled;
+} round_rect_command_t;
+
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;
+    int16_t x, y;
+    int16_t rx, ry;
+    fmrb_color_t color;
+    bool filled;
+} ellipse_command_t;
+
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;
+    int16_t x0, y0, x1, y1, x2, y2;
+    fmrb_color_t color;
+    bool filled;
+} triangle_command_t;
+
+// Shared by POLYLINE, POLYGON and POINTS
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;
+    fmrb_color_t color;
+    bool filled;
+    uint16_t count;
+    fmrb_point_t points[FMRB_GFX_MAX_CMD_POINTS];
+} points_command_t;
+
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;   // Source
+    fmrb_rect_t src_rect;
+    fmrb_canvas_handle_t dst_canvas_id;
+    int16_t dst_x, dst_y;
+} copy_rect_command_t;
+
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;
+    fmrb_rect_t rect;
+    int16_t dx, dy;
+    fmrb_color_t fill_color;
+} scroll_rect_command_t;
+
+typedef struct {
+    fmrb_canvas_handle_t canvas_id;
+    fmrb_gfx_list_op_t op;
+    uint8_t list_id;
+    uint8_t color_count;
+    int16_t dx, dy;
+    fmrb_color_t colors[FMRB_GFX_LIST_MAX_SLOTS];
+} list_command_t;
+
 // Generic command
 typedef struct {
     fmrb_gfx_command_type_t type;
@@ -69,6 +133,13 @@ typedef struct {
         rect_command_t rect;
         circle_command_t circle;
         text_command_t text;
+        round_rect_command_t round_rect;
+        ellipse_command_t ellipse;
+        triangle_command_t triangle;
+        points_command_t points;
+        copy_rect_command_t copy_rect;
+        scroll_rect_command_t scroll_rect;
+        list_command_t list;
     } data;
 } fmrb_gfx_command_t;
 
@@ -211,16 +282,170 @@ fmrb_gfx_err_t fmrb_gfx_command_buffer_add_text(fmrb_gfx_command_buffer_t* buffe
     return add_command(buffer, &cmd);
 }
 
-fmrb_gfx_err_t fmrb_gfx_command_buffer_execute(fmrb_gfx_command_buffer_t* buffer, fmrb_gfx_context_t context) {
-    if (!buffer || !context) {
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_round_rect(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_rect_t* rect, int16_t radius, fmrb_color_t color, bool filled) {
+    if (!rect) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_command_t cmd = {
+        .type = FMRB_GFX_CMD_ROUND_RECT,
+        .data.round_rect = { .canvas_id = canvas_id, .rect = *rect, .radius = radius, .color = color, .filled = filled }
+    };
+
+    return add_command(buffer, &cmd);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_ellipse(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, int16_t x, int16_t y, int16_t rx, int16_t ry, fmrb_color_t color, bool filled) {
+    fmrb_gfx_command_t cmd = {
+        .type = FMRB_GFX_CMD_ELLIPSE,
+        .data.ellipse = { .canvas_id = canvas_id, .x = x, .y = y, .rx = rx, .ry = ry, .color = color, .filled = filled }
+    };
+
+    return add_command(buffer, &cmd);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_triangle(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, fmrb_color_t color, bool filled) {
+    fmrb_gfx_command_t cmd = {
+        .type = FMRB_GFX_CMD_TRIANGLE,
+        .data.triangle = {
+            .canvas_id = canvas_id,
+            .x0 = x0, .y0 = y0,
+            .x1 = x1, .y1 = y1,
+            .x2 = x2, .y2 = y2,
+            .color = color,
+            .filled = filled
+        }
+    };
+
+    return add_command(buffer, &cmd);
+}
+
+static fmrb_gfx_err_t add_points_command(fmrb_gfx_command_buffer_t* buffer, fmrb_gfx_command_type_t type, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color, bool filled) {
+    if (!points || count == 0 || count > FMRB_GFX_MAX_CMD_POINTS) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_command_t cmd = {
+        .type = type,
+        .data.points = { .canvas_id = canvas_id, .color = color, .filled = filled, .count = count }
+    };
+    memcpy(cmd.data.points.points, points, sizeof(fmrb_point_t) * count);
+
+    return add_command(buffer, &cmd);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_polyline(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color) {
+    return add_points_command(buffer, FMRB_GFX_CMD_POLYLINE, canvas_id, points, count, color, false);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_polygon(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color, bool filled) {
+    return add_points_command(buffer, FMRB_GFX_CMD_POLYGON, canvas_id, points, count, color, filled);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_points(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color) {
+    return add_points_command(buffer, FMRB_GFX_CMD_POINTS, canvas_id, points, count, color, false);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_copy_rect(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t src_canvas_id, const fmrb_rect_t* src_rect, fmrb_canvas_handle_t dst_canvas_id, int16_t dst_x, int16_t dst_y) {
+    if (!src_rect) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_command_t cmd = {
+        .type = FMRB_GFX_CMD_COPY_RECT,
+        .data.copy_rect = { .canvas_id = src_canvas_id, .src_rect = *src_rect, .dst_canvas_id = dst_canvas_id, .dst_x = dst_x, .dst_y = dst_y }
+    };
+
+    return add_command(buffer, &cmd);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_scroll_rect(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_rect_t* rect, int16_t dx, int16_t dy, fmrb_color_t fill_color) {
+    if (!rect) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_command_t cmd = {
+        .type = FMRB_GFX_CMD_SCROLL_RECT,
+        .data.scroll_rect = { .canvas_id = canvas_id, .rect = *rect, .dx = dx, .dy = dy, .fill_color = fill_color }
+    };
+
+    return add_command(buffer, &cmd);
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_list(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, fmrb_gfx_list_op_t op, uint8_t list_id, int16_t dx, int16_t dy, const fmrb_color_t* colors, uint8_t color_count) {
+    if (color_count > FMRB_GFX_LIST_MAX_SLOTS || (color_count > 0 && !colors)) {
+        return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+
+    fmrb_gfx_command_t cmd = {
+        .type = FMRB_GFX_CMD_LIST,
+        .data.list = { .canvas_id = canvas_id, .op = op, .list_id = list_id, .color_count = color_count, .dx = dx, .dy = dy }
+    };
+    if (color_count > 0) {
+        memcpy(cmd.data.list.colors, colors, color_count);
+    }
+
+    return add_command(buffer, &cmd);
+}
+
+// Run one display list operation; BEGIN/END open and close *recorder for *recorder_canvas
+static fmrb_gfx_err_t execute_list_command(const list_command_t *lc, fmrb_gfx_context_t base_context,
+                                           fmrb_gfx_list_recorder_t **recorder,
+                                           fmrb_canvas_handle_t *recorder_canvas) {
+    switch (lc->op) {
+        case FMRB_GFX_LIST_BEGIN: {
+            if (*recorder) {
+                return FMRB_GFX_ERR_INVALID_PARAM;  // One recording at a time
+            }
+            fmrb_gfx_err_t ret = fmrb_gfx_list_begin(base_context, lc->canvas_id, lc->list_id,
+                                                     lc->colors, lc->color_count, recorder);
+            if (ret == FMRB_GFX_OK) {
+                *recorder_canvas = lc->canvas_id;
+            }
+            return ret;
+        }
+
+        case FMRB_GFX_LIST_END: {
+            if (!*recorder || *recorder_canvas != lc->canvas_id) {
+                return FMRB_GFX_ERR_INVALID_PARAM;
+            }
+            fmrb_gfx_err_t ret = fmrb_gfx_list_end(*recorder);
+            *recorder = NULL;
+            *recorder_canvas = FMRB_CANVAS_INVALID;
+            return ret;
+        }
+
+        case FMRB_GFX_LIST_CALL:
+            return fmrb_gfx_call_list(base_context, lc->canvas_id, lc->list_id, lc->dx, lc->dy,
+                                      lc->colors, lc->color_count);
+
+        case FMRB_GFX_LIST_DELETE:
+            return fmrb_gfx_delete_list(base_context, lc->canvas_id, lc->list_id);
+
+        default:
+            return FMRB_GFX_ERR_INVALID_PARAM;
+    }
+}
+
+fmrb_gfx_err_t fmrb_gfx_command_buffer_execute(fmrb_gfx_command_buffer_t* buffer, fmrb_gfx_context_t base_context) {
+    if (!buffer || !base_context) {
         return FMRB_GFX_ERR_INVALID_PARAM;
     }
 
     ESP_LOGD(TAG, "Executing %zu commands", buffer->count);
 
+    // Open display list; commands for its canvas between LIST_BEGIN and LIST_END
+    // draw into it. Other canvases (apps share this buffer) keep drawing normally.
+    fmrb_gfx_list_recorder_t *recorder = NULL;
+    fmrb_canvas_handle_t recorder_canvas = FMRB_CANVAS_INVALID;
+
     for (size_t i = 0; i < buffer->count; i++) {
         fmrb_gfx_command_t *cmd = &buffer->commands[i];
         fmrb_gfx_err_t ret = FMRB_GFX_OK;
+        // Every command structure starts with canvas_id
+        bool recording = recorder && cmd->type != FMRB_GFX_CMD_LIST &&
+                         cmd->data.clear.canvas_id == recorder_canvas;
+        fmrb_gfx_context_t context = recording ? fmrb_gfx_list_context(recorder) : base_context;
 
         switch (cmd->type) {
             case FMRB_GFX_CMD_CLEAR:
@@ -276,6 +501,101 @@ fmrb_gfx_err_t fmrb_gfx_command_buffer_execute(fmrb_gfx_command_buffer_t* buffer
                                        cmd->data.text.bg_transparent, cmd->data.text.font_size);
                 break;
 
+            case FMRB_GFX_CMD_ROUND_RECT: {
+                const round_rect_command_t *rr = &cmd->data.round_rect;
+                ESP_LOGD(TAG, "Executing ROUND_RECT command [%zu]: canvas_id=%d, x=%d, y=%d, w=%d, h=%d, r=%d, color=0x%02X, filled=%d",
+                         i, rr->canvas_id, rr->rect.x, rr->rect.y, rr->rect.width, rr->rect.height,
+                         rr->radius, rr->color, rr->filled);
+                if (rr->filled) {
+                    ret = fmrb_gfx_fill_round_rect(context, rr->canvas_id, rr->rect.x, rr->rect.y,
+                                                 rr->rect.width, rr->rect.height, rr->radius, rr->color);
+                } else {
+                    ret = fmrb_gfx_draw_round_rect(context, rr->canvas_id, rr->rect.x, rr->rect.y,
+                                                 rr->rect.width, rr->rect.height, rr->radius, rr->color);
+                }
+                break;
+            }
+
+            case FMRB_GFX_CMD_ELLIPSE:
+                ESP_LOGD(TAG, "Executing ELLIPSE command [%zu]: canvas_id=%d, x=%d, y=%d, rx=%d, ry=%d, color=0x%02X, filled=%d",
+                         i, cmd->data.ellipse.canvas_id, cmd->data.ellipse.x, cmd->data.ellipse.y,
+                         cmd->data.ellipse.rx, cmd->data.ellipse.ry, cmd->data.ellipse.color, cmd->data.ellipse.filled);
+                if (cmd->data.ellipse.filled) {
+                    ret = fmrb_gfx_fill_ellipse(context, cmd->data.ellipse.canvas_id, cmd->data.ellipse.x, cmd->data.ellipse.y,
+                                              cmd->data.ellipse.rx, cmd->data.ellipse.ry, cmd->data.ellipse.color);
+                } else {
+                    ret = fmrb_gfx_draw_ellipse(context, cmd->data.ellipse.canvas_id, cmd->data.ellipse.x, cmd->data.ellipse.y,
+                                              cmd->data.ellipse.rx, cmd->data.ellipse.ry, cmd->data.ellipse.color);
+                }
+                break;
+
+            case FMRB_GFX_CMD_TRIANGLE: {
+                const triangle_command_t *tri = &cmd->data.triangle;
+                ESP_LOGD(TAG, "Executing TRIANGLE command [%zu]: canvas_id=%d, (%d,%d) (%d,%d) (%d,%d), color=0x%02X, filled=%d",
+                         i, tri->canvas_id, tri->x0, tri->y0, tri->x1, tri->y1, tri->x2, tri->y2,
+                         tri->color, tri->filled);
+                if (tri->filled) {
+                    ret = fmrb_gfx_fill_triangle(context, tri->canvas_id, tri->x0, tri->y0,
+                                               tri->x1, tri->y1, tri->x2, tri->y2, tri->color);
+                } else {
+                    ret = fmrb_gfx_draw_triangle(context, tri->canvas_id, tri->x0, tri->y0,
+                                               tri->x1, tri->y1, tri->x2, tri->y2, tri->color);
+                }
+                break;
+            }
+
+            case FMRB_GFX_CMD_POLYLINE:
+                ESP_LOGD(TAG, "Executing POLYLINE command [%zu]: canvas_id=%d, count=%u, color=0x%02X",
+                         i, cmd->data.points.canvas_id, cmd->data.points.count, cmd->data.points.color);
+                ret = fmrb_gfx_draw_polyline(context, cmd->data.points.canvas_id, cmd->data.points.points,
+                                             cmd->data.points.count, cmd->data.points.color);
+                break;
+
+            case FMRB_GFX_CMD_POLYGON:
+                ESP_LOGD(TAG, "Executing POLYGON command [%zu]: canvas_id=%d, count=%u, color=0x%02X, filled=%d",
+                         i, cmd->data.points.canvas_id, cmd->data.points.count, cmd->data.points.color,
+                         cmd->data.points.filled);
+                if (cmd->data.points.filled) {
+                    ret = fmrb_gfx_fill_polygon(context, cmd->data.points.canvas_id, cmd->data.points.points,
+                                                cmd->data.points.count, cmd->data.points.color);
+                } else {
+                    ret = fmrb_gfx_draw_polygon(context, cmd->data.points.canvas_id, cmd->data.points.points,
+                                                cmd->data.points.count, cmd->data.points.color);
+                }
+                break;
+
+            case FMRB_GFX_CMD_POINTS:
+                ESP_LOGD(TAG, "Executing POINTS command [%zu]: canvas_id=%d, count=%u, color=0x%02X",
+                         i, cmd->data.points.canvas_id, cmd->data.points.count, cmd->data.points.color);
+                ret = fmrb_gfx_draw_points(context, cmd->data.points.canvas_id, cmd->data.points.points,
+                                           cmd->data.points.count, cmd->data.points.color);
+                break;
+
+            case FMRB_GFX_CMD_COPY_RECT: {
+                const copy_rect_command_t *cp = &cmd->data.copy_rect;
+                ESP_LOGD(TAG, "Executing COPY_RECT command [%zu]: canvas %d (%d,%d %dx%d) -> canvas %d (%d,%d)",
+                         i, cp->canvas_id, cp->src_rect.x, cp->src_rect.y, cp->src_rect.width, cp->src_rect.height,
+                         cp->dst_canvas_id, cp->dst_x, cp->dst_y);
+                ret = fmrb_gfx_copy_rect(context, cp->canvas_id, &cp->src_rect, cp->dst_canvas_id, cp->dst_x, cp->dst_y);
+                break;
+            }
+
+            case FMRB_GFX_CMD_SCROLL_RECT: {
+                const scroll_rect_command_t *sc = &cmd->data.scroll_rect;
+                ESP_LOGD(TAG, "Executing SCROLL_RECT command [%zu]: canvas_id=%d, (%d,%d %dx%d), d=(%d,%d), fill=0x%02X",
+                         i, sc->canvas_id, sc->rect.x, sc->rect.y, sc->rect.width, sc->rect.height,
+                         sc->dx, sc->dy, sc->fill_color);
+                ret = fmrb_gfx_scroll_rect(context, sc->canvas_id, &sc->rect, sc->dx, sc->dy, sc->fill_color);
+                break;
+            }
+
+            case FMRB_GFX_CMD_LIST:
+                ESP_LOGD(TAG, "Executing LIST command [%zu]: canvas_id=%d, op=%d, id=%u, d=(%d,%d), colors=%u",
+                         i, cmd->data.list.canvas_id, cmd->data.list.op, cmd->data.list.list_id,
+                         cmd->data.list.dx, cmd->data.list.dy, cmd->data.list.color_count);
+                ret = execute_list_command(&cmd->data.list, base_context, &recorder, &recorder_canvas);
+                break;
+
             default:
                 ESP_LOGW(TAG, "Unknown command type: %d", cmd->type);
                 ret = FMRB_GFX_ERR_INVALID_PARAM;
@@ -284,12 +604,19 @@ fmrb_gfx_err_t fmrb_gfx_command_buffer_execute(fmrb_gfx_command_buffer_t* buffer
 
         if (ret != FMRB_GFX_OK) {
             ESP_LOGE(TAG, "Command %zu execution failed: %d", i, ret);
+            fmrb_gfx_list_abort(recorder);
             return ret;
         } else {
             ESP_LOGD(TAG, "Command %zu executed successfully", i);
         }
     }
 
+    // A list is only defined once its LIST_END is in the same frame
+    if (recorder) {
+        ESP_LOGW(TAG, "Display list recording not closed, discarded");
+        fmrb_gfx_list_abort(recorder);
+    }
+
     return FMRB_GFX_OK;
 }
 
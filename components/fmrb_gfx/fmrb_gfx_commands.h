@@ -101,6 +101,123 @@ fmrb_gfx_err_t fmrb_gfx_command_buffer_add_circle(fmrb_gfx_command_buffer_t* buf
  */
 fmrb_gfx_err_t fmrb_gfx_command_buffer_add_text(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, int16_t x, int16_t y, const char* text, fmrb_color_t color, fmrb_color_t bg_color, bool bg_transparent, fmrb_font_size_t font_size);
 
+/**
+ * @brief Add rounded rectangle command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param rect Rectangle
+ * @param radius Corner radius
+ * @param color Rectangle color
+ * @param filled Whether to fill the rectangle
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_round_rect(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_rect_t* rect, int16_t radius, fmrb_color_t color, bool filled);
+
+/**
+ * @brief Add ellipse command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param x Center X coordinate
+ * @param y Center Y coordinate
+ * @param rx X radius
+ * @param ry Y radius
+ * @param color Ellipse color
+ * @param filled Whether to fill the ellipse
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_ellipse(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, int16_t x, int16_t y, int16_t rx, int16_t ry, fmrb_color_t color, bool filled);
+
+/**
+ * @brief Add triangle command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param x0 First vertex X coordinate
+ * @param y0 First vertex Y coordinate
+ * @param x1 Second vertex X coordinate
+ * @param y1 Second vertex Y coordinate
+ * @param x2 Third vertex X coordinate
+ * @param y2 Third vertex Y coordinate
+ * @param color Triangle color
+ * @param filled Whether to fill the triangle
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_triangle(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, fmrb_color_t color, bool filled);
+
+/**
+ * @brief Add polyline command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param points Point array (copied, at most FMRB_GFX_MAX_CMD_POINTS)
+ * @param count Number of points
+ * @param color Line color
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_polyline(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color);
+
+/**
+ * @brief Add polygon command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param points Vertex array (copied, at most FMRB_GFX_MAX_CMD_POINTS)
+ * @param count Number of vertices
+ * @param color Polygon color
+ * @param filled Whether to fill the polygon
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_polygon(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color, bool filled);
+
+/**
+ * @brief Add point list command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param points Point array (copied, at most FMRB_GFX_MAX_CMD_POINTS)
+ * @param count Number of points
+ * @param color Point color
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_points(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_point_t* points, uint16_t count, fmrb_color_t color);
+
+/**
+ * @brief Add copy rect command to buffer
+ * @param buffer Command buffer handle
+ * @param src_canvas_id Source canvas ID
+ * @param src_rect Source rectangle
+ * @param dst_canvas_id Destination canvas ID
+ * @param dst_x Destination X coordinate
+ * @param dst_y Destination Y coordinate
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_copy_rect(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t src_canvas_id, const fmrb_rect_t* src_rect, fmrb_canvas_handle_t dst_canvas_id, int16_t dst_x, int16_t dst_y);
+
+/**
+ * @brief Add scroll rect command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Target canvas ID
+ * @param rect Region to scroll
+ * @param dx Horizontal shift
+ * @param dy Vertical shift
+ * @param fill_color Color of the exposed area
+ * @return Graphics error code
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_scroll_rect(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, const fmrb_rect_t* rect, int16_t dx, int16_t dy, fmrb_color_t fill_color);
+
+/**
+ * @brief Add display list command to buffer
+ * @param buffer Command buffer handle
+ * @param canvas_id Canvas that owns the list
+ * @param op List operation
+ * @param list_id List id
+ * @param dx Replay X offset (FMRB_GFX_LIST_CALL)
+ * @param dy Replay Y offset (FMRB_GFX_LIST_CALL)
+ * @param colors Slot colors (FMRB_GFX_LIST_BEGIN) or replacement colors (FMRB_GFX_LIST_CALL)
+ * @param color_count Number of colors (at most FMRB_GFX_LIST_MAX_SLOTS)
+ * @return Graphics error code
+ *
+ * Commands added between FMRB_GFX_LIST_BEGIN and FMRB_GFX_LIST_END are
+ * recorded into the list when the buffer is executed instead of being drawn.
+ */
+fmrb_gfx_err_t fmrb_gfx_command_buffer_add_list(fmrb_gfx_command_buffer_t* buffer, fmrb_canvas_handle_t canvas_id, fmrb_gfx_list_op_t op, uint8_t list_id, int16_t dx, int16_t dy, const fmrb_color_t* colors, uint8_t color_count);
+
 /**
  * @brief Execute all commands in buffer
  * @param buffer Command buffer handle
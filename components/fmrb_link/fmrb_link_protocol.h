@@ -64,6 +64,10 @@ typedef enum {
     FMRB_LINK_GFX_CREATE_IMAGE_FROM_FILE = 0x07,
     FMRB_LINK_GFX_DELETE_IMAGE = 0x08,
 
+    // Window decorations (drawn by the host compositor)
+    FMRB_LINK_GFX_SET_WINDOW_FRAME = 0x09,
+    FMRB_LINK_GFX_SET_WINDOW_TITLE = 0x0A,
+
     // Basic drawing (LovyanGFX compatible)
     FMRB_LINK_GFX_DRAW_PIXEL = 0x10,
     FMRB_LINK_GFX_DRAW_LINE = 0x11,
@@ -91,11 +95,13 @@ typedef enum {
     FMRB_LINK_GFX_DRAW_CHAR = 0x21,
     FMRB_LINK_GFX_SET_TEXT_SIZE = 0x22,
     FMRB_LINK_GFX_SET_TEXT_COLOR = 0x23,
+    FMRB_LINK_GFX_DRAW_STRING_CURRENT = 0x24,  // DRAW_STRING with the canvas' current text color
 
     // Clear and fill
     FMRB_LINK_GFX_CLEAR = 0x30,
     FMRB_LINK_GFX_FILL_SCREEN = 0x31,
     FMRB_LINK_GFX_PRESENT = 0x32,
+    FMRB_LINK_GFX_FRAME_DONE = 0x33,  // Host -> core: a frame has been displayed
 
     // Image/bitmap drawing
     FMRB_LINK_GFX_DRAW_IMAGE = 0x40,
@@ -106,10 +112,31 @@ typedef enum {
     FMRB_LINK_GFX_DELETE_CANVAS = 0x51,
     FMRB_LINK_GFX_SET_TARGET = 0x52,
     FMRB_LINK_GFX_PUSH_CANVAS = 0x53,
+    FMRB_LINK_GFX_SET_PALETTE = 0x54,
+    FMRB_LINK_GFX_SET_PALETTE_RANGE = 0x55,
+    FMRB_LINK_GFX_COPY_RECT = 0x56,
+    FMRB_LINK_GFX_SCROLL_RECT = 0x57,
+    FMRB_LINK_GFX_DEFINE_LIST = 0x58,
+    FMRB_LINK_GFX_CALL_LIST = 0x59,
+    FMRB_LINK_GFX_DELETE_LIST = 0x5A,
 
     // Cursor control (global resource, no canvas_id)
     FMRB_LINK_GFX_CURSOR_SET_POSITION = 0x60,
-    FMRB_LINK_GFX_CURSOR_SET_VISIBLE = 0x61
+    FMRB_LINK_GFX_CURSOR_SET_VISIBLE = 0x61,
+    FMRB_LINK_GFX_CURSOR_SET_SHAPE = 0x62,
+
+    // Point-list drawing (fmrb_link_graphics_points_t + packed point array)
+    FMRB_LINK_GFX_DRAW_POLYLINE = 0x70,
+    FMRB_LINK_GFX_DRAW_POLYGON = 0x71,
+    FMRB_LINK_GFX_FILL_POLYGON = 0x72,
+    FMRB_LINK_GFX_DRAW_POINTS = 0x73,
+
+    // Tile layers (composited under the canvas draw buffer on PUSH_CANVAS)
+    FMRB_LINK_GFX_TILEMAP_CREATE = 0x80,
+    FMRB_LINK_GFX_TILEMAP_DELETE = 0x81,
+    FMRB_LINK_GFX_TILEMAP_SET_SHEET = 0x82,
+    FMRB_LINK_GFX_TILEMAP_SET_CELLS = 0x83,
+    FMRB_LINK_GFX_TILEMAP_SCROLL = 0x84
 } fmrb_link_graphics_cmd_t;
 
 // Audio sub-commands
@@ -201,6 +228,25 @@ typedef struct __attribute__((packed)) {
     // Followed by text data
 } fmrb_link_graphics_text_t;
 
+// Compact DRAW_STRING that reuses the text color last set on the canvas
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;  // Target canvas ID (0=screen)
+    int16_t x, y;
+    uint16_t text_len;
+    // Followed by text data
+} fmrb_link_graphics_text_current_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;  // Target canvas ID (0=screen)
+    uint8_t fg;          // RGB332 format
+    uint8_t bg;          // RGB332 format (bg == fg means transparent background)
+} fmrb_link_graphics_text_color_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;  // Target canvas ID (0=screen)
+    float size;          // Text size multiplier
+} fmrb_link_graphics_text_size_t;
+
 // Additional shape structures (LovyanGFX compatible)
 typedef struct __attribute__((packed)) {
     uint16_t canvas_id;  // Target canvas ID (0=screen)
@@ -232,6 +278,61 @@ typedef struct __attribute__((packed)) {
     uint8_t color;  // RGB332 format
 } fmrb_link_graphics_triangle_t;
 
+// Point array encodings (fmrb_link_graphics_points_t.encoding)
+#define FMRB_LINK_GFX_POINTS_ABS16   0  // int16 x, y for every point
+#define FMRB_LINK_GFX_POINTS_DELTA8  1  // int16 x, y for the first point, then int8 dx, dy from the previous point
+
+// Maximum points carried by one point-list command
+#define FMRB_LINK_GFX_MAX_POINTS 512
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;  // Target canvas ID (0=screen)
+    uint8_t color;  // RGB332 format
+    uint8_t encoding;  // FMRB_LINK_GFX_POINTS_*
+    uint16_t point_count;
+    // Followed by point data (little endian, see encoding)
+} fmrb_link_graphics_points_t;
+
+// Tile layer structures
+#define FMRB_LINK_GFX_MAX_TILE_LAYERS 2
+#define FMRB_LINK_GFX_TILE_EMPTY 0xFF          // Map cell value that draws nothing
+#define FMRB_LINK_GFX_TILE_CHUNK_SIZE 2048     // Max sheet/cell bytes per command
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t layer;              // 0 = back (opaque), higher = front
+    uint8_t tile_w, tile_h;
+    uint16_t map_w, map_h;      // Map size in cells (the map wraps when scrolled)
+    uint8_t transparent_color;  // Canvas-wide key for upper layers and the draw buffer (0xFF = none)
+} fmrb_link_graphics_tilemap_create_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t layer;
+} fmrb_link_graphics_tilemap_delete_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t layer;
+    uint16_t sheet_w, sheet_h;  // Whole sheet size in pixels (RGB332, tiles in row-major order)
+    uint32_t offset;            // Byte offset of this chunk within the sheet
+    uint16_t length;
+    // Followed by length bytes of pixel data
+} fmrb_link_graphics_tilemap_sheet_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t layer;
+    uint16_t x, y, w, h;        // Cell rectangle
+    // Followed by w * h tile indices (uint8, row-major)
+} fmrb_link_graphics_tilemap_cells_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t layer;
+    int16_t scroll_x, scroll_y;
+} fmrb_link_graphics_tilemap_scroll_t;
+
 // Canvas management structures
 typedef struct __attribute__((packed)) {
     uint16_t canvas_id;
@@ -254,6 +355,34 @@ typedef struct __attribute__((packed)) {
     int32_t width, height; // Size
 } fmrb_link_graphics_update_window_t;
 
+// Window frame: drawn by the compositor over the canvas edges, so apps draw only the client area.
+// The canvas keeps the outer window size; the client area is inset by the border and title bar.
+#define FMRB_LINK_GFX_FRAME_NONE          0     // No decorations
+#define FMRB_LINK_GFX_FRAME_TITLED        1     // Title bar + border
+
+#define FMRB_LINK_GFX_FRAME_FLAG_CLOSE    0x01  // Close button at the right of the title bar
+#define FMRB_LINK_GFX_FRAME_FLAG_RESIZE   0x02  // Resize grip at the bottom-right corner
+
+#define FMRB_LINK_GFX_FRAME_BORDER        1     // Border width in pixels
+#define FMRB_LINK_GFX_FRAME_TITLE_HEIGHT  11    // Title bar height, border included
+#define FMRB_LINK_GFX_FRAME_BUTTON_SIZE   8     // Menu and close buttons (2px from the top)
+#define FMRB_LINK_GFX_FRAME_GRIP_SIZE     10    // Resize grip (square at the bottom-right)
+#define FMRB_LINK_GFX_FRAME_TITLE_MAX     31    // Max title bytes
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t style;              // FMRB_LINK_GFX_FRAME_*
+    uint8_t flags;              // FMRB_LINK_GFX_FRAME_FLAG_*
+    uint8_t title_len;
+    // Followed by title_len bytes of title (not NUL-terminated)
+} fmrb_link_graphics_window_frame_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t title_len;
+    // Followed by title_len bytes of title (not NUL-terminated)
+} fmrb_link_graphics_window_title_t;
+
 typedef struct __attribute__((packed)) {
     uint16_t target_id;  // 0=screen, other=canvas ID
 } fmrb_link_graphics_set_target_t;
@@ -266,7 +395,73 @@ typedef struct __attribute__((packed)) {
     uint8_t use_transparency;  // 0=no, 1=yes
 } fmrb_link_graphics_push_canvas_t;
 
+// Pixel move structures
+typedef struct __attribute__((packed)) {
+    uint16_t src_canvas_id;     // Source canvas (0=screen only when dst is also the screen)
+    uint16_t dst_canvas_id;     // Destination canvas (may equal src; overlap is handled)
+    int16_t src_x, src_y;
+    uint16_t width, height;
+    int16_t dst_x, dst_y;
+} fmrb_link_graphics_copy_rect_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    int16_t x, y;
+    uint16_t width, height;     // Region that scrolls; pixels never move outside it
+    int16_t dx, dy;             // Shift in pixels (negative = left/up)
+    uint8_t fill_color;         // RGB332 color for the exposed area
+} fmrb_link_graphics_scroll_rect_t;
+
+// Display lists: draw commands recorded on the host per canvas and replayed by id.
+// Allowed items: pixel, line, rect, round rect, circle, ellipse, triangle, string and point-list commands.
+#define FMRB_LINK_GFX_MAX_LISTS      16    // List ids per canvas (0..15)
+#define FMRB_LINK_GFX_LIST_MAX_SLOTS 8     // Color parameters per list
+#define FMRB_LINK_GFX_LIST_MAX_SIZE  2048  // Max bytes of recorded items
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;         // Owning canvas; the list is freed with it
+    uint8_t list_id;
+    uint8_t slot_count;
+    uint8_t slot_colors[FMRB_LINK_GFX_LIST_MAX_SLOTS];  // Recorded colors that CALL_LIST may replace
+    uint16_t data_len;
+    // Followed by data_len bytes of items: fmrb_link_graphics_list_item_t + command payload
+} fmrb_link_graphics_define_list_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t cmd_type;           // FMRB_LINK_GFX_* draw command
+    uint16_t len;               // Payload bytes that follow
+} fmrb_link_graphics_list_item_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t list_id;
+    uint8_t color_count;        // Leading slots to replace (the rest keep their recorded color)
+    int16_t dx, dy;             // Offset added to every coordinate
+    uint8_t colors[FMRB_LINK_GFX_LIST_MAX_SLOTS];
+} fmrb_link_graphics_call_list_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t list_id;
+} fmrb_link_graphics_delete_list_t;
+
+// Palette structures (indexed canvases are remapped when composited to the screen)
+#define FMRB_LINK_GFX_PALETTE_SIZE 256
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t indexed;            // 0 = direct RGB332, 1 = indexed (followed by 256 RGB332 entries)
+} fmrb_link_graphics_set_palette_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t canvas_id;
+    uint8_t start;
+    uint16_t count;             // start + count <= 256
+    // Followed by count RGB332 entries
+} fmrb_link_graphics_set_palette_range_t;
+
 // Cursor control structures (no canvas_id - cursor is global)
+// The host moves the cursor from its own pointer input; CURSOR_SET_POSITION only warps it.
 typedef struct __attribute__((packed)) {
     int32_t x, y;
 } fmrb_link_graphics_cursor_position_t;
@@ -275,11 +470,26 @@ typedef struct __attribute__((packed)) {
     bool visible;
 } fmrb_link_graphics_cursor_visible_t;
 
+#define FMRB_LINK_GFX_CURSOR_ARROW   0
+#define FMRB_LINK_GFX_CURSOR_MOVE    1  // Window drag
+#define FMRB_LINK_GFX_CURSOR_RESIZE  2  // Window resize
+#define FMRB_LINK_GFX_CURSOR_SHAPES  3
+
+typedef struct __attribute__((packed)) {
+    uint8_t shape;              // FMRB_LINK_GFX_CURSOR_*
+} fmrb_link_graphics_cursor_shape_t;
+
 // Present command structure
 typedef struct __attribute__((packed)) {
     uint16_t canvas_id;  // Canvas to present (0=screen/back_buffer, other=canvas ID)
 } fmrb_link_graphics_present_t;
 
+// Sent by the host after displaying a frame, when new canvases were pushed to RENDER since the last one
+typedef struct __attribute__((packed)) {
+    uint32_t frame;         // Host frame number
+    uint32_t render_pushes; // PUSH_CANVAS commands to FMRB_CANVAS_RENDER received so far
+} fmrb_link_graphics_frame_done_t;
+
 // Audio message structures
 typedef struct __attribute__((packed)) {
     uint32_t sample_rate;
@@ -293,6 +503,18 @@ typedef struct __attribute__((packed)) {
     uint8_t volume; // 0-100
 } fmrb_link_audio_volume_t;
 
+// ACK payload of FMRB_LINK_MSG_AUDIO_QUEUE_SAMPLES (fmrb_link_audio_play_t + PCM): the host's
+// stream buffer after the samples were queued, for flow control. Frames are at the host's
+// output rate; keep queued_frames near target_frames.
+typedef struct __attribute__((packed)) {
+    uint32_t queued_frames;  // Buffered and not yet played
+    uint32_t target_frames;  // Latency target (playback starts once this much is buffered)
+    uint32_t free_frames;    // Room left before samples are dropped
+    uint32_t output_rate;    // Host output sample rate
+    uint32_t underruns;      // Times playback ran dry (counted since the stream opened)
+    uint32_t overruns;       // Times queued samples were dropped because the buffer was full
+} fmrb_link_audio_queue_status_t;
+
 // Response structures
 typedef struct __attribute__((packed)) {
     uint16_t original_sequence;
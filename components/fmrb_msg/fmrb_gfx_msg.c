@@ -0,0 +1,101 @@
+#include "fmrb_gfx_msg.h"
+#include "fmrb_app.h"
+#include "fmrb_log.h"
+#include <string.h>
+
+static const char *TAG = "gfx_msg";
+
+fmrb_err_t fmrb_gfx_msg_send(const gfx_cmd_t *cmd)
+{
+    if (!cmd) {
+        return FMRB_ERR_INVALID_PARAM;
+    }
+
+    fmrb_app_task_context_t *ctx = fmrb_current();
+    if (!ctx) {
+        FMRB_LOGE(TAG, "Failed to get current task context");
+        return FMRB_ERR_INVALID_STATE;
+    }
+
+    fmrb_msg_t msg = {
+        .type = FMRB_MSG_TYPE_APP_GFX,
+        .src_pid = ctx->app_id,
+        .size = sizeof(gfx_cmd_t)
+    };
+    memcpy(msg.data, cmd, sizeof(gfx_cmd_t));
+
+    // Number presents so the Host Task can report when each one reaches the display
+    uint32_t present_seq = ctx->frames_presented + 1;
+    if (cmd->cmd_type == GFX_CMD_PRESENT) {
+        ((gfx_cmd_t*)msg.data)->params.present.seq = present_seq;
+    }
+
+    fmrb_err_t ret = fmrb_msg_send(PROC_ID_HOST, &msg, 100);
+    if (ret != FMRB_OK) {
+        FMRB_LOGE(TAG, "Failed to send graphics command %d: %d", cmd->cmd_type, ret);
+    } else if (cmd->cmd_type == GFX_CMD_PRESENT) {
+        ctx->frames_presented = present_seq;
+    }
+    return ret;
+}
+
+fmrb_err_t fmrb_gfx_msg_send_points(gfx_cmd_type_t cmd_type, fmrb_canvas_handle_t canvas_id,
+                                    const fmrb_point_t *points, uint16_t count,
+                                    fmrb_color_t color, bool filled)
+{
+    if (!points) {
+        return FMRB_ERR_INVALID_PARAM;
+    }
+
+    uint16_t overlap = 0;
+    uint16_t min_count = 1;
+    switch (cmd_type) {
+        case GFX_CMD_POLYLINE:
+            overlap = 1;
+            min_count = 2;
+            break;
+        case GFX_CMD_POLYGON:
+            min_count = filled ? 3 : 2;
+            if (count > FMRB_GFX_MAX_CMD_POINTS) {
+                FMRB_LOGE(TAG, "Polygon has too many vertices: %u (max %d)", count, FMRB_GFX_MAX_CMD_POINTS);
+                return FMRB_ERR_INVALID_PARAM;
+            }
+            break;
+        case GFX_CMD_POINTS:
+            break;
+        default:
+            return FMRB_ERR_INVALID_PARAM;
+    }
+    if (count < min_count) {
+        return FMRB_ERR_INVALID_PARAM;
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = cmd_type,
+        .canvas_id = canvas_id,
+        .params.points.color = color,
+        .params.points.filled = filled,
+    };
+
+    uint16_t start = 0;
+    while (start < count) {
+        uint16_t n = count - start;
+        if (n > FMRB_GFX_MAX_CMD_POINTS) {
+            n = FMRB_GFX_MAX_CMD_POINTS;
+        }
+        cmd.params.points.count = n;
+        memcpy(cmd.params.points.points, &points[start], sizeof(fmrb_point_t) * n);
+
+        fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+        if (ret != FMRB_OK) {
+            return ret;
+        }
+
+        start += n;
+        if (start < count) {
+            start -= overlap;
+        }
+    }
+
+    return FMRB_OK;
+}
@@ -24,6 +24,15 @@ typedef enum {
     GFX_CMD_RECT,
     GFX_CMD_CIRCLE,
     GFX_CMD_TEXT,
+    GFX_CMD_ROUND_RECT,
+    GFX_CMD_ELLIPSE,
+    GFX_CMD_TRIANGLE,
+    GFX_CMD_POLYLINE,
+    GFX_CMD_POLYGON,
+    GFX_CMD_POINTS,
+    GFX_CMD_COPY_RECT,
+    GFX_CMD_SCROLL_RECT,
+    GFX_CMD_LIST,
     GFX_CMD_PRESENT
 } gfx_cmd_type_t;
 
@@ -68,14 +77,102 @@ typedef struct {
             bool bg_transparent;  // true = no background, false = use bg_color
             fmrb_font_size_t font_size;
         } text;
+        struct {
+            fmrb_rect_t rect;
+            int16_t radius;
+            fmrb_color_t color;
+            bool filled;
+        } round_rect;
+        struct {
+            int16_t x;
+            int16_t y;
+            int16_t rx;
+            int16_t ry;
+            fmrb_color_t color;
+            bool filled;
+        } ellipse;
+        struct {
+            int16_t x0;
+            int16_t y0;
+            int16_t x1;
+            int16_t y1;
+            int16_t x2;
+            int16_t y2;
+            fmrb_color_t color;
+            bool filled;
+        } triangle;
+        struct {
+            fmrb_color_t color;
+            bool filled;     // GFX_CMD_POLYGON only
+            uint16_t count;
+            fmrb_point_t points[FMRB_GFX_MAX_CMD_POINTS];
+        } points;
+        struct {
+            fmrb_rect_t src_rect;
+            fmrb_canvas_handle_t dst_canvas_id;  // canvas_id is the source
+            int16_t dst_x;
+            int16_t dst_y;
+        } copy_rect;
+        struct {
+            fmrb_rect_t rect;
+            int16_t dx;
+            int16_t dy;
+            fmrb_color_t fill_color;
+        } scroll_rect;
+        struct {
+            fmrb_gfx_list_op_t op;
+            uint8_t list_id;
+            uint8_t color_count;
+            int16_t dx;  // Replay offset (FMRB_GFX_LIST_CALL)
+            int16_t dy;
+            fmrb_color_t colors[FMRB_GFX_LIST_MAX_SLOTS];  // Slot colors (BEGIN) or replacements (CALL)
+        } list;
         struct {
             int16_t x;  // Screen X position
             int16_t y;  // Screen Y position
             fmrb_color_t transparent_color;  // Transparent color (0xFF = no transparency)
+            uint32_t seq;  // Per-app present number, set by fmrb_gfx_msg_send() (0 = no frame notification)
         } present;
     } params;
 } gfx_cmd_t;
 
+/**
+ * @brief Frame-complete notification (Host Task -> app, FMRB_MSG_TYPE_APP_GFX)
+ *
+ * Sent once the host has displayed a frame containing the app's latest PRESENT.
+ */
+typedef struct {
+    uint32_t frame;      // Host frame number
+    uint32_t presented;  // seq of the newest PRESENT now on screen
+} gfx_frame_event_t;
+
+/**
+ * @brief Send a graphics command from the current app task to the Host Task
+ * @param cmd Graphics command
+ * @return FMRB_OK on success, error code otherwise
+ *
+ * Shared by the mruby and Lua bindings so both languages go through the same
+ * encoding and the same Host Task command buffer (flushed on GFX_CMD_PRESENT).
+ */
+fmrb_err_t fmrb_gfx_msg_send(const gfx_cmd_t *cmd);
+
+/**
+ * @brief Send a point-list command, split into FMRB_GFX_MAX_CMD_POINTS chunks
+ * @param cmd_type GFX_CMD_POLYLINE, GFX_CMD_POLYGON or GFX_CMD_POINTS
+ * @param canvas_id Target canvas
+ * @param points Point array
+ * @param count Number of points
+ * @param color Drawing color
+ * @param filled Fill the polygon (GFX_CMD_POLYGON only)
+ * @return FMRB_OK on success, error code otherwise
+ *
+ * Polylines are split with one shared point between chunks so the line stays
+ * connected. A polygon cannot be split and is limited to FMRB_GFX_MAX_CMD_POINTS.
+ */
+fmrb_err_t fmrb_gfx_msg_send_points(gfx_cmd_type_t cmd_type, fmrb_canvas_handle_t canvas_id,
+                                    const fmrb_point_t *points, uint16_t count,
+                                    fmrb_color_t color, bool filled);
+
 #ifdef __cplusplus
 }
 #endif
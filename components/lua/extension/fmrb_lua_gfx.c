@@ -6,6 +6,7 @@
 #include "fmrb_msg.h"
 #include "fmrb_log.h"
 #include "fmrb_rtos.h"
+#include <stdbool.h>
 #include <string.h>
 
 static const char *TAG = "lua_gfx";
@@ -16,28 +17,6 @@ typedef struct {
     fmrb_canvas_handle_t canvas_id;
 } lua_gfx_data;
 
-// Helper function to send GFX command message to Host Task
-static fmrb_err_t send_gfx_command(const gfx_cmd_t *cmd) {
-    fmrb_app_task_context_t *ctx = fmrb_current();
-    if (!ctx) {
-        FMRB_LOGE(TAG, "Failed to get current task context");
-        return FMRB_ERR_INVALID_STATE;
-    }
-
-    fmrb_msg_t msg = {
-        .type = FMRB_MSG_TYPE_APP_GFX,
-        .src_pid = ctx->app_id,
-        .size = sizeof(gfx_cmd_t)
-    };
-    memcpy(msg.data, cmd, sizeof(gfx_cmd_t));
-
-    fmrb_err_t ret = fmrb_msg_send(PROC_ID_HOST, &msg, 100);
-    if (ret != FMRB_OK) {
-        FMRB_LOGE(TAG, "Failed to send graphics command: %d", ret);
-    }
-    return ret;
-}
-
 // Create new graphics object: gfx = FmrbGfx.new(canvas_id)
 static int lua_gfx_new(lua_State* L) {
     int canvas_id = luaL_checkinteger(L, 1);
@@ -91,7 +70,7 @@ static int lua_gfx_fill_rect(lua_State* L) {
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         return luaL_error(L, "fillRect failed: %d", ret);
     }
@@ -124,7 +103,7 @@ static int lua_gfx_draw_rect(lua_State* L) {
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         return luaL_error(L, "drawRect failed: %d", ret);
     }
@@ -133,6 +112,564 @@ static int lua_gfx_draw_rect(lua_State* L) {
     return 1;
 }
 
+// gfx:set_pixel(x, y, color)
+static int lua_gfx_set_pixel(lua_State* L) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x = luaL_checkinteger(L, 2);
+    int y = luaL_checkinteger(L, 3);
+    int color = luaL_checkinteger(L, 4);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_PIXEL,
+        .canvas_id = data->canvas_id,
+        .params.pixel = {.x = (int16_t)x, .y = (int16_t)y, .color = (fmrb_color_t)color}
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "set_pixel failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:draw_line(x1, y1, x2, y2, color)
+static int lua_gfx_draw_line(lua_State* L) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x1 = luaL_checkinteger(L, 2);
+    int y1 = luaL_checkinteger(L, 3);
+    int x2 = luaL_checkinteger(L, 4);
+    int y2 = luaL_checkinteger(L, 5);
+    int color = luaL_checkinteger(L, 6);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_LINE,
+        .canvas_id = data->canvas_id,
+        .params.line = {
+            .x1 = (int16_t)x1, .y1 = (int16_t)y1,
+            .x2 = (int16_t)x2, .y2 = (int16_t)y2,
+            .color = (fmrb_color_t)color
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "draw_line failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// Shared body of gfx:draw_circle / gfx:fill_circle (x, y, r, color)
+static int lua_gfx_circle_common(lua_State* L, bool filled) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x = luaL_checkinteger(L, 2);
+    int y = luaL_checkinteger(L, 3);
+    int r = luaL_checkinteger(L, 4);
+    int color = luaL_checkinteger(L, 5);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_CIRCLE,
+        .canvas_id = data->canvas_id,
+        .params.circle = {
+            .x = (int16_t)x,
+            .y = (int16_t)y,
+            .radius = (int16_t)r,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "%s failed: %d", filled ? "fill_circle" : "draw_circle", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+static int lua_gfx_draw_circle(lua_State* L) {
+    return lua_gfx_circle_common(L, false);
+}
+
+static int lua_gfx_fill_circle(lua_State* L) {
+    return lua_gfx_circle_common(L, true);
+}
+
+// Shared body of gfx:draw_round_rect / gfx:fill_round_rect (x, y, w, h, r, color)
+static int lua_gfx_round_rect_common(lua_State* L, bool filled) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x = luaL_checkinteger(L, 2);
+    int y = luaL_checkinteger(L, 3);
+    int w = luaL_checkinteger(L, 4);
+    int h = luaL_checkinteger(L, 5);
+    int r = luaL_checkinteger(L, 6);
+    int color = luaL_checkinteger(L, 7);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_ROUND_RECT,
+        .canvas_id = data->canvas_id,
+        .params.round_rect = {
+            .rect = {.x = (int16_t)x, .y = (int16_t)y, .width = (uint16_t)w, .height = (uint16_t)h},
+            .radius = (int16_t)r,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "%s failed: %d", filled ? "fill_round_rect" : "draw_round_rect", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+static int lua_gfx_draw_round_rect(lua_State* L) {
+    return lua_gfx_round_rect_common(L, false);
+}
+
+static int lua_gfx_fill_round_rect(lua_State* L) {
+    return lua_gfx_round_rect_common(L, true);
+}
+
+// Shared body of gfx:draw_ellipse / gfx:fill_ellipse (x, y, rx, ry, color)
+static int lua_gfx_ellipse_common(lua_State* L, bool filled) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x = luaL_checkinteger(L, 2);
+    int y = luaL_checkinteger(L, 3);
+    int rx = luaL_checkinteger(L, 4);
+    int ry = luaL_checkinteger(L, 5);
+    int color = luaL_checkinteger(L, 6);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_ELLIPSE,
+        .canvas_id = data->canvas_id,
+        .params.ellipse = {
+            .x = (int16_t)x,
+            .y = (int16_t)y,
+            .rx = (int16_t)rx,
+            .ry = (int16_t)ry,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "%s failed: %d", filled ? "fill_ellipse" : "draw_ellipse", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+static int lua_gfx_draw_ellipse(lua_State* L) {
+    return lua_gfx_ellipse_common(L, false);
+}
+
+static int lua_gfx_fill_ellipse(lua_State* L) {
+    return lua_gfx_ellipse_common(L, true);
+}
+
+// Shared body of gfx:draw_triangle / gfx:fill_triangle (x0, y0, x1, y1, x2, y2, color)
+static int lua_gfx_triangle_common(lua_State* L, bool filled) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x0 = luaL_checkinteger(L, 2);
+    int y0 = luaL_checkinteger(L, 3);
+    int x1 = luaL_checkinteger(L, 4);
+    int y1 = luaL_checkinteger(L, 5);
+    int x2 = luaL_checkinteger(L, 6);
+    int y2 = luaL_checkinteger(L, 7);
+    int color = luaL_checkinteger(L, 8);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_TRIANGLE,
+        .canvas_id = data->canvas_id,
+        .params.triangle = {
+            .x0 = (int16_t)x0, .y0 = (int16_t)y0,
+            .x1 = (int16_t)x1, .y1 = (int16_t)y1,
+            .x2 = (int16_t)x2, .y2 = (int16_t)y2,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "%s failed: %d", filled ? "fill_triangle" : "draw_triangle", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+static int lua_gfx_draw_triangle(lua_State* L) {
+    return lua_gfx_triangle_common(L, false);
+}
+
+static int lua_gfx_fill_triangle(lua_State* L) {
+    return lua_gfx_triangle_common(L, true);
+}
+
+// Shared body of the point-list methods (points, color); points is a flat
+// table {x0, y0, x1, y1, ...}
+static int lua_gfx_points_common(lua_State* L, gfx_cmd_type_t cmd_type, bool filled, const char *name) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    luaL_checktype(L, 2, LUA_TTABLE);
+    int color = luaL_checkinteger(L, 3);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    lua_Integer len = (lua_Integer)lua_rawlen(L, 2);
+    if (len % 2 != 0 || len / 2 > UINT16_MAX) {
+        return luaL_error(L, "%s: points must be a flat table of x, y pairs", name);
+    }
+    uint16_t count = (uint16_t)(len / 2);
+
+    // Scratch buffer as userdata so luaL_error below does not leak it
+    fmrb_point_t *points = (fmrb_point_t *)lua_newuserdata(L, sizeof(fmrb_point_t) * (count ? count : 1));
+    for (lua_Integer i = 0; i < len; i++) {
+        lua_rawgeti(L, 2, i + 1);
+        if (!lua_isinteger(L, -1)) {
+            return luaL_error(L, "%s: point coordinates must be integers", name);
+        }
+        if (i % 2 == 0) {
+            points[i / 2].x = (int16_t)lua_tointeger(L, -1);
+        } else {
+            points[i / 2].y = (int16_t)lua_tointeger(L, -1);
+        }
+        lua_pop(L, 1);
+    }
+
+    fmrb_err_t ret = fmrb_gfx_msg_send_points(cmd_type, data->canvas_id, points, count,
+                                              (fmrb_color_t)color, filled);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "%s failed: %d", name, ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+static int lua_gfx_draw_polyline(lua_State* L) {
+    return lua_gfx_points_common(L, GFX_CMD_POLYLINE, false, "draw_polyline");
+}
+
+static int lua_gfx_draw_polygon(lua_State* L) {
+    return lua_gfx_points_common(L, GFX_CMD_POLYGON, false, "draw_polygon");
+}
+
+static int lua_gfx_fill_polygon(lua_State* L) {
+    return lua_gfx_points_common(L, GFX_CMD_POLYGON, true, "fill_polygon");
+}
+
+static int lua_gfx_draw_points(lua_State* L) {
+    return lua_gfx_points_common(L, GFX_CMD_POINTS, false, "draw_points");
+}
+
+// gfx:copy_rect(src_x, src_y, w, h, dst_x, dst_y [, dst_canvas])
+static int lua_gfx_copy_rect(lua_State* L) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int src_x = luaL_checkinteger(L, 2);
+    int src_y = luaL_checkinteger(L, 3);
+    int w = luaL_checkinteger(L, 4);
+    int h = luaL_checkinteger(L, 5);
+    int dst_x = luaL_checkinteger(L, 6);
+    int dst_y = luaL_checkinteger(L, 7);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+    int dst_canvas = luaL_optinteger(L, 8, data->canvas_id);
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_COPY_RECT,
+        .canvas_id = data->canvas_id,
+        .params.copy_rect = {
+            .src_rect = { .x = (int16_t)src_x, .y = (int16_t)src_y, .width = (uint16_t)w, .height = (uint16_t)h },
+            .dst_canvas_id = (fmrb_canvas_handle_t)dst_canvas,
+            .dst_x = (int16_t)dst_x,
+            .dst_y = (int16_t)dst_y
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "copy_rect failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:scroll_rect(x, y, w, h, dx, dy, fill_color)
+static int lua_gfx_scroll_rect(lua_State* L) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    int x = luaL_checkinteger(L, 2);
+    int y = luaL_checkinteger(L, 3);
+    int w = luaL_checkinteger(L, 4);
+    int h = luaL_checkinteger(L, 5);
+    int dx = luaL_checkinteger(L, 6);
+    int dy = luaL_checkinteger(L, 7);
+    int fill_color = luaL_checkinteger(L, 8);
+
+    if (!data || !data->ctx) {
+        return luaL_error(L, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_SCROLL_RECT,
+        .canvas_id = data->canvas_id,
+        .params.scroll_rect = {
+            .rect = { .x = (int16_t)x, .y = (int16_t)y, .width = (uint16_t)w, .height = (uint16_t)h },
+            .dx = (int16_t)dx,
+            .dy = (int16_t)dy,
+            .fill_color = (fmrb_color_t)fill_color
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        return luaL_error(L, "scroll_rect failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// Tile layers are long-lived host resources, so these call fmrb_gfx directly
+// (like canvas creation) instead of going through the per-frame command buffer.
+
+static lua_gfx_data *lua_gfx_check_data(lua_State* L) {
+    lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
+    if (!data || !data->ctx) {
+        luaL_error(L, "Graphics not initialized");
+    }
+    return data;
+}
+
+// gfx:tilemap_create(layer, tile_w, tile_h, map_w, map_h [, transparent_color])
+static int lua_gfx_tilemap_create(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int layer = luaL_checkinteger(L, 2);
+    int tile_w = luaL_checkinteger(L, 3);
+    int tile_h = luaL_checkinteger(L, 4);
+    int map_w = luaL_checkinteger(L, 5);
+    int map_h = luaL_checkinteger(L, 6);
+    int transparent_color = luaL_optinteger(L, 7, 0xFF);
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_create(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                 (uint8_t)tile_w, (uint8_t)tile_h,
+                                                 (uint16_t)map_w, (uint16_t)map_h,
+                                                 (fmrb_color_t)transparent_color);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "tilemap_create failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:tilemap_sheet(layer, sheet_w, sheet_h, pixels)  pixels: RGB332 string
+static int lua_gfx_tilemap_sheet(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int layer = luaL_checkinteger(L, 2);
+    int sheet_w = luaL_checkinteger(L, 3);
+    int sheet_h = luaL_checkinteger(L, 4);
+    size_t len;
+    const char *pixels = luaL_checklstring(L, 5, &len);
+
+    if (sheet_w <= 0 || sheet_h <= 0 || len != (size_t)sheet_w * sheet_h) {
+        return luaL_error(L, "tilemap_sheet: pixels must be sheet_w * sheet_h bytes");
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_set_sheet(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                    (const uint8_t *)pixels,
+                                                    (uint16_t)sheet_w, (uint16_t)sheet_h);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "tilemap_sheet failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:tilemap_set_cells(layer, x, y, w, tiles)  tiles: table of w * h tile indices
+static int lua_gfx_tilemap_set_cells(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int layer = luaL_checkinteger(L, 2);
+    int x = luaL_checkinteger(L, 3);
+    int y = luaL_checkinteger(L, 4);
+    int w = luaL_checkinteger(L, 5);
+    luaL_checktype(L, 6, LUA_TTABLE);
+
+    lua_Integer len = (lua_Integer)lua_rawlen(L, 6);
+    if (w <= 0 || len == 0 || len % w != 0) {
+        return luaL_error(L, "tilemap_set_cells: tiles must hold whole rows of w cells");
+    }
+
+    // Scratch buffer as userdata so luaL_error below does not leak it
+    uint8_t *tiles = (uint8_t *)lua_newuserdata(L, (size_t)len);
+    for (lua_Integer i = 0; i < len; i++) {
+        lua_rawgeti(L, 6, i + 1);
+        if (!lua_isinteger(L, -1)) {
+            return luaL_error(L, "tilemap_set_cells: tile indices must be integers");
+        }
+        tiles[i] = (uint8_t)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_set_cells(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                    (uint16_t)x, (uint16_t)y,
+                                                    (uint16_t)w, (uint16_t)(len / w), tiles);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "tilemap_set_cells failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:tilemap_set_cell(layer, x, y, tile)
+static int lua_gfx_tilemap_set_cell(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int layer = luaL_checkinteger(L, 2);
+    int x = luaL_checkinteger(L, 3);
+    int y = luaL_checkinteger(L, 4);
+    uint8_t cell = (uint8_t)luaL_checkinteger(L, 5);
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_set_cells(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                    (uint16_t)x, (uint16_t)y, 1, 1, &cell);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "tilemap_set_cell failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:tilemap_scroll(layer, x, y)
+static int lua_gfx_tilemap_scroll(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int layer = luaL_checkinteger(L, 2);
+    int x = luaL_checkinteger(L, 3);
+    int y = luaL_checkinteger(L, 4);
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_scroll(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                 (int16_t)x, (int16_t)y);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "tilemap_scroll failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:tilemap_delete(layer)
+static int lua_gfx_tilemap_delete(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int layer = luaL_checkinteger(L, 2);
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_delete(data->ctx, data->canvas_id, (uint8_t)layer);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "tilemap_delete failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// Copy count integers from the table at idx into buf
+static void lua_gfx_colors_from_table(lua_State* L, int idx, fmrb_color_t *buf, lua_Integer count) {
+    for (lua_Integer i = 0; i < count; i++) {
+        lua_rawgeti(L, idx, i + 1);
+        if (!lua_isinteger(L, -1)) {
+            luaL_error(L, "colors must be integers");
+        }
+        buf[i] = (fmrb_color_t)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+    }
+}
+
+// gfx:set_palette(colors)  colors: table of 256 RGB332 values, or nil for direct color
+static int lua_gfx_set_palette(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    fmrb_color_t palette[256];
+    const fmrb_color_t *p = NULL;
+
+    if (!lua_isnoneornil(L, 2)) {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        if (lua_rawlen(L, 2) != 256) {
+            return luaL_error(L, "set_palette: palette must have 256 entries");
+        }
+        lua_gfx_colors_from_table(L, 2, palette, 256);
+        p = palette;
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_palette(data->ctx, data->canvas_id, p);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "set_palette failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:set_palette_range(start, colors)
+static int lua_gfx_set_palette_range(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    int start = luaL_checkinteger(L, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+
+    lua_Integer len = (lua_Integer)lua_rawlen(L, 3);
+    if (start < 0 || len == 0 || start + len > 256) {
+        return luaL_error(L, "set_palette_range: range out of bounds");
+    }
+
+    fmrb_color_t colors[256];
+    lua_gfx_colors_from_table(L, 3, colors, len);
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_palette_range(data->ctx, data->canvas_id, (uint8_t)start,
+                                                    (uint16_t)len, colors);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "set_palette_range failed: %d", ret);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
 // gfx:drawString(text, x, y, color [, bg_color])
 static int lua_gfx_draw_string(lua_State* L) {
     lua_gfx_data *data = (lua_gfx_data *)luaL_checkudata(L, 1, "FmrbGfx");
@@ -171,7 +708,7 @@ static int lua_gfx_draw_string(lua_State* L) {
     strncpy(cmd.params.text.text, text, sizeof(cmd.params.text.text) - 1);
     cmd.params.text.text[sizeof(cmd.params.text.text) - 1] = '\0';
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         return luaL_error(L, "drawString failed: %d", ret);
     }
@@ -205,7 +742,7 @@ static int lua_gfx_present(lua_State* L) {
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         return luaL_error(L, "present failed: %d", ret);
     }
@@ -230,7 +767,7 @@ static int lua_gfx_clear(lua_State* L) {
         .params.clear.color = (fmrb_color_t)color
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         return luaL_error(L, "clear failed: %d", ret);
     }
@@ -240,9 +777,115 @@ static int lua_gfx_clear(lua_State* L) {
 }
 
 // Method table
+// Send one GFX_CMD_LIST operation; colors is a table index or 0 for none
+static void lua_gfx_send_list_op(lua_State* L, lua_gfx_data *data, fmrb_gfx_list_op_t op, lua_Integer list_id,
+                                 int dx, int dy, int colors_idx) {
+    if (list_id < 0 || list_id >= FMRB_GFX_MAX_LISTS) {
+        luaL_error(L, "list id out of range");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_LIST,
+        .canvas_id = data->canvas_id,
+        .params.list = {
+            .op = op,
+            .list_id = (uint8_t)list_id,
+            .dx = (int16_t)dx,
+            .dy = (int16_t)dy
+        }
+    };
+    if (colors_idx != 0 && !lua_isnoneornil(L, colors_idx)) {
+        luaL_checktype(L, colors_idx, LUA_TTABLE);
+        lua_Integer len = (lua_Integer)lua_rawlen(L, colors_idx);
+        if (len > FMRB_GFX_LIST_MAX_SLOTS) {
+            luaL_error(L, "too many list colors");
+        }
+        lua_gfx_colors_from_table(L, colors_idx, cmd.params.list.colors, len);
+        cmd.params.list.color_count = (uint8_t)len;
+    }
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        luaL_error(L, "display list command failed: %d", ret);
+    }
+}
+
+// gfx:define_list(id, fn [, slot_colors])  records the drawing done by fn(gfx)
+static int lua_gfx_define_list(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    lua_Integer list_id = luaL_checkinteger(L, 2);
+    luaL_checktype(L, 3, LUA_TFUNCTION);
+
+    lua_gfx_send_list_op(L, data, FMRB_GFX_LIST_BEGIN, list_id, 0, 0, 4);
+
+    lua_pushvalue(L, 3);
+    lua_pushvalue(L, 1);
+    int status = lua_pcall(L, 1, 0, 0);
+
+    // Always close the recording so later drawing is not captured
+    lua_gfx_send_list_op(L, data, FMRB_GFX_LIST_END, 0, 0, 0, 0);
+    if (status != LUA_OK) {
+        return lua_error(L);
+    }
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:call_list(id [, x, y [, colors]])  colors replace the list's slot colors in order
+static int lua_gfx_call_list(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    lua_Integer list_id = luaL_checkinteger(L, 2);
+    int x = (int)luaL_optinteger(L, 3, 0);
+    int y = (int)luaL_optinteger(L, 4, 0);
+
+    lua_gfx_send_list_op(L, data, FMRB_GFX_LIST_CALL, list_id, x, y, 5);
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
+// gfx:delete_list(id)
+static int lua_gfx_delete_list(lua_State* L) {
+    lua_gfx_data *data = lua_gfx_check_data(L);
+    lua_Integer list_id = luaL_checkinteger(L, 2);
+
+    lua_gfx_send_list_op(L, data, FMRB_GFX_LIST_DELETE, list_id, 0, 0, 0);
+
+    lua_pushvalue(L, 1);  // Return self
+    return 1;
+}
+
 static const luaL_Reg gfx_methods[] = {
+    {"set_pixel", lua_gfx_set_pixel},
+    {"draw_line", lua_gfx_draw_line},
     {"fill_rect", lua_gfx_fill_rect},
     {"draw_rect", lua_gfx_draw_rect},
+    {"draw_circle", lua_gfx_draw_circle},
+    {"fill_circle", lua_gfx_fill_circle},
+    {"draw_round_rect", lua_gfx_draw_round_rect},
+    {"fill_round_rect", lua_gfx_fill_round_rect},
+    {"draw_ellipse", lua_gfx_draw_ellipse},
+    {"fill_ellipse", lua_gfx_fill_ellipse},
+    {"draw_triangle", lua_gfx_draw_triangle},
+    {"fill_triangle", lua_gfx_fill_triangle},
+    {"draw_polyline", lua_gfx_draw_polyline},
+    {"draw_polygon", lua_gfx_draw_polygon},
+    {"fill_polygon", lua_gfx_fill_polygon},
+    {"draw_points", lua_gfx_draw_points},
+    {"copy_rect", lua_gfx_copy_rect},
+    {"scroll_rect", lua_gfx_scroll_rect},
+    {"tilemap_create", lua_gfx_tilemap_create},
+    {"tilemap_sheet", lua_gfx_tilemap_sheet},
+    {"tilemap_set_cells", lua_gfx_tilemap_set_cells},
+    {"tilemap_set_cell", lua_gfx_tilemap_set_cell},
+    {"tilemap_scroll", lua_gfx_tilemap_scroll},
+    {"tilemap_delete", lua_gfx_tilemap_delete},
+    {"set_palette", lua_gfx_set_palette},
+    {"set_palette_range", lua_gfx_set_palette_range},
+    {"define_list", lua_gfx_define_list},
+    {"call_list", lua_gfx_call_list},
+    {"delete_list", lua_gfx_delete_list},
     {"draw_text", lua_gfx_draw_string},
     {"present", lua_gfx_present},
     {"clear", lua_gfx_clear},
@@ -304,10 +947,38 @@ static int lua_app_create_canvas(lua_State* L) {
     FMRB_LOGI(TAG, "Created canvas %u (%dx%d) for app %s",
              canvas_id, width, height, ctx->app_name);
 
+    // Frame is drawn by the host compositor; no close button since Lua apps don't receive APP_CONTROL
+    ret = fmrb_gfx_set_window_frame(gfx_ctx, canvas_id, FMRB_GFX_FRAME_TITLED,
+                                    FMRB_GFX_FRAME_FLAG_RESIZE, ctx->app_name);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "Failed to set window frame: %d", ret);
+    }
+    ctx->frame_style = FMRB_GFX_FRAME_TITLED;
+    ctx->frame_flags = FMRB_GFX_FRAME_FLAG_RESIZE;
+
     lua_pushinteger(L, canvas_id);
     return 1;
 }
 
+// FmrbApp.set_title(title) - Change the title drawn in the window frame
+static int lua_app_set_title(lua_State* L) {
+    const char* title = luaL_checkstring(L, 1);
+
+    fmrb_app_task_context_t* ctx = fmrb_current();
+    if (!ctx) {
+        return luaL_error(L, "No app context available");
+    }
+    if (ctx->frame_style == FMRB_GFX_FRAME_NONE) {
+        return luaL_error(L, "Window has no title bar");
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_window_title(fmrb_gfx_get_global_context(), ctx->canvas_id, title);
+    if (ret != FMRB_GFX_OK) {
+        return luaL_error(L, "Failed to set window title: %d", ret);
+    }
+    return 0;
+}
+
 // FmrbGfx table with constructor
 static const luaL_Reg gfx_functions[] = {
     {"new", lua_gfx_new},
@@ -317,6 +988,7 @@ static const luaL_Reg gfx_functions[] = {
 // FmrbApp table with helper functions
 static const luaL_Reg app_functions[] = {
     {"create_canvas", lua_app_create_canvas},
+    {"set_title", lua_app_set_title},
     {"sleep", lua_app_sleep},
     {NULL, NULL}
 };
@@ -353,6 +1025,8 @@ void fmrb_lua_register_gfx(lua_State* L) {
     lua_setfield(L, -2, "MAGENTA");
     lua_pushinteger(L, 0x1F);  // Cyan
     lua_setfield(L, -2, "CYAN");
+    lua_pushinteger(L, 0x6D);  // Gray
+    lua_setfield(L, -2, "GRAY");
 
     lua_setglobal(L, "FmrbGfx");
 
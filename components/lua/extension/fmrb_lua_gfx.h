@@ -9,16 +9,34 @@ extern "C" {
 /**
  * Register FmrbGfx module to Lua state
  *
- * Provides graphics drawing functions for Lua applications:
+ * Provides graphics drawing functions for Lua applications, matching the
+ * mruby FmrbGfx surface. Commands are sent with fmrb_gfx_msg_send() and
+ * batched by the Host Task until present() like the mruby binding:
  * - FmrbGfx.new(canvas_id) - Create graphics object
- * - gfx:fillRect(x, y, w, h, color) - Draw filled rectangle
- * - gfx:drawString(text, x, y, color) - Draw text string
- * - gfx:present(x, y) - Present canvas to screen
  * - gfx:clear(color) - Clear canvas with color
+ * - gfx:set_pixel(x, y, color)
+ * - gfx:draw_line(x1, y1, x2, y2, color)
+ * - gfx:draw_rect / fill_rect(x, y, w, h, color)
+ * - gfx:draw_round_rect / fill_round_rect(x, y, w, h, r, color)
+ * - gfx:draw_circle / fill_circle(x, y, r, color)
+ * - gfx:draw_ellipse / fill_ellipse(x, y, rx, ry, color)
+ * - gfx:draw_triangle / fill_triangle(x0, y0, x1, y1, x2, y2, color)
+ * - gfx:draw_polyline / draw_polygon / fill_polygon / draw_points(points, color)
+ *   where points is a flat table {x0, y0, x1, y1, ...}
+ * - gfx:draw_text(text, x, y, color [, bg_color]) - Draw text string
+ * - gfx:copy_rect(src_x, src_y, w, h, dst_x, dst_y [, dst_canvas]) - Move pixels on the host
+ * - gfx:scroll_rect(x, y, w, h, dx, dy, fill_color) - Scroll a region, filling the exposed part
+ * - gfx:tilemap_create(layer, tile_w, tile_h, map_w, map_h [, transparent_color])
+ * - gfx:tilemap_sheet(layer, sheet_w, sheet_h, pixels) - RGB332 string
+ * - gfx:tilemap_set_cells(layer, x, y, w, tiles) / tilemap_set_cell(layer, x, y, tile)
+ * - gfx:tilemap_scroll(layer, x, y) / tilemap_delete(layer)
+ *   Tile layers live on the host and are composited under the canvas at present()
+ * - gfx:set_palette(colors | nil) - 256 RGB332 entries switch the canvas to indexed mode
+ * - gfx:set_palette_range(start, colors) - Update part of the palette (fades, cycling)
+ * - gfx:present() - Present canvas to screen at the window position
  *
  * Color constants (RGB332 format):
- * - FmrbGfx.COLOR_BLACK, COLOR_WHITE, COLOR_RED, COLOR_GREEN,
- *   COLOR_BLUE, COLOR_YELLOW, COLOR_MAGENTA, COLOR_CYAN
+ * - FmrbGfx.BLACK, WHITE, RED, GREEN, BLUE, YELLOW, MAGENTA, CYAN, GRAY
  */
 void fmrb_lua_register_gfx(lua_State* L);
 
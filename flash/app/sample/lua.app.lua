@@ -13,17 +13,11 @@ print("Hello from Lua!")
 print("Lua version: " .. _VERSION)
 print("Sample Lua app is running successfully")
 
-function draw_window_frame()
-    gfx:fill_rect(0, 0, FmrbApp.WINDOW_WIDTH, 12, 0xC5)
-    gfx:fill_rect(2, 2, 8, 8, 0x60)
-    gfx:draw_rect(0, 0, FmrbApp.WINDOW_WIDTH, FmrbApp.WINDOW_HEIGHT, 0x60)
-    gfx:draw_rect(0, 0, FmrbApp.WINDOW_WIDTH, 12, 0x60)
-    gfx:draw_text("Lua App", 12, 2, FmrbGfx.WHITE)
-end
+-- Title bar and border are drawn by the host compositor
+FmrbApp.set_title("Lua App")
 
 -- Clear screen with BG clolor
 gfx:clear(FmrbGfx.WHITE)
-draw_window_frame()
 gfx:present()
 
 -- Print window info from FmrbApp
@@ -65,7 +59,6 @@ while running do
 
         gfx:fill_rect(0, 54, FmrbApp.WINDOW_WIDTH-1, 64, FmrbGfx.WHITE)
         gfx:draw_text("Running: " .. tostring(seconds) .. "s", 10, 54, 0x60)
-        draw_window_frame()
         gfx:present()
         print("Running: " .. tostring(seconds) .. "s")
     end
@@ -73,7 +73,6 @@ class BouncingBallApp < FmrbApp
 
   def draw_full_screen()
     @gfx.clear(FmrbGfx::WHITE)
-    draw_window_frame
     draw_balls
     @gfx.present
   end
@@ -132,7 +131,7 @@ class BouncingBallApp < FmrbApp
   end
 
   # def on_event(ev)
-  #   # Call parent class handler (for close button, etc.)
+  #   # Call parent class handler
   #   super(ev)
   # end
 
@@ -31,6 +31,14 @@ Porting for SDL:
 #include <list>
 #include <vector>
 #include <math.h>
+
+// Family mruby host: SIMD RGB332 -> ARGB8888 expansion for the texture upload
+#if defined(__has_include)
+ #if __has_include("pixel_kernels.h")
+  #include "pixel_kernels.h"
+  #define LGFX_SDL_PIXEL_KERNELS 1
+ #endif
+#endif
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -178,13 +186,17 @@ namespace lgfx
         auto monitor = getMonitorByWindowID(event.window.windowID);
         if (monitor) {
           if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
-            int mw, mh;
-            SDL_GetRendererOutputSize(monitor->renderer, &mw, &mh);
-            if (monitor->frame_rotation & 1) {
-              std::swap(mw, mh);
+            if (monitor->integer_scaling) {
+              monitor->scaling_x = monitor->scaling_y = _fit_scaling(monitor);
+            } else {
+              int mw, mh;
+              SDL_GetRendererOutputSize(monitor->renderer, &mw, &mh);
+              if (monitor->frame_rotation & 1) {
+                std::swap(mw, mh);
+              }
+              monitor->scaling_x = (mw * 2 / monitor->frame_width) / 2.0f;
+              monitor->scaling_y = (mh * 2 / monitor->frame_height) / 2.0f;
             }
-            monitor->scaling_x = (mw * 2 / monitor->frame_width) / 2.0f;
-            monitor->scaling_y = (mh * 2 / monitor->frame_height) / 2.0f;
             monitor->panel->sdl_invalidate();
           }
           else
@@ -338,6 +350,16 @@ namespace lgfx
     monitor.frame_angle = (monitor.frame_rotation) * 90;
   }
 
+  void Panel_sdl::setIntegerScaling(bool enable)
+  {
+    monitor.integer_scaling = enable;
+  }
+
+  void Panel_sdl::setFullscreen(bool fullscreen)
+  {
+    monitor.fullscreen = fullscreen;
+  }
+
   Panel_sdl::~Panel_sdl(void)
   {
     _list_monitor.remove(&monitor);
@@ -398,39 +420,59 @@ namespace lgfx
     }
   };
 
+  /// 描画された行をテクスチャ転送の対象に加える (_sdl_mutex を保持した状態で呼ぶこと)
+  void Panel_sdl::_mark_dirty(uint_fast16_t y, uint_fast16_t h)
+  {
+    if (_internal_rotation)
+    { // 回転時は行の対応が変わるため全体を転送する
+      y = 0;
+      h = _cfg.panel_height;
+    }
+    if (_dirty_y0 > y) { _dirty_y0 = y; }
+    if (_dirty_y1 < y + h) { _dirty_y1 = y + h; }
+  }
+
   void Panel_sdl::drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
   {
     lock_t lock(this);
+    _mark_dirty(y, 1);
     Panel_FrameBufferBase::drawPixelPreclipped(x, y, rawcolor);
   }
 
   void Panel_sdl::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
   {
     lock_t lock(this);
+    _mark_dirty(y, h);
     Panel_FrameBufferBase::writeFillRectPreclipped(x, y, w, h, rawcolor);
   }
 
   void Panel_sdl::writeBlock(uint32_t rawcolor, uint32_t length)
   {
 //    lock_t lock(this);
+    SDL_LockMutex(_sdl_mutex);
+    _mark_dirty(_ys, _ye - _ys + 1);
+    SDL_UnlockMutex(_sdl_mutex);
     Panel_FrameBufferBase::writeBlock(rawcolor, length);
   }
 
   void Panel_sdl::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma)
   {
     lock_t lock(this);
+    _mark_dirty(y, h);
     Panel_FrameBufferBase::writeImage(x, y, w, h, param, use_dma);
   }
 
   void Panel_sdl::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
   {
     lock_t lock(this);
+    _mark_dirty(y, h);
     Panel_FrameBufferBase::writeImageARGB(x, y, w, h, param);
   }
 
   void Panel_sdl::writePixels(pixelcopy_t* param, uint32_t len, bool use_dma)
   {
     lock_t lock(this);
+    _mark_dirty(_ys, _ye - _ys + 1);
     Panel_FrameBufferBase::writePixels(param, len, use_dma);
   }
 
@@ -470,8 +512,28 @@ namespace lgfx
     }
   }
 
+  /// 出力サイズに収まる最大の整数拡大率
+  uint_fast8_t Panel_sdl::_fit_scaling(monitor_t * mon)
+  {
+    int mw, mh;
+    SDL_GetRendererOutputSize(mon->renderer, &mw, &mh);
+    if (mon->frame_rotation & 1) {
+      std::swap(mw, mh);
+    }
+    int s = std::min<int>(mw / mon->frame_width, mh / mon->frame_height);
+    return s < 1 ? 1 : (s > 255 ? 255 : s);
+  }
+
   void Panel_sdl::_update_scaling(monitor_t * mon, float sx, float sy)
   {
+    if (mon->fullscreen)
+    { // ウィンドウサイズは変えず、画面に収まる範囲で拡大率だけ変える
+      float fit = _fit_scaling(mon);
+      mon->scaling_x = std::min(sx, fit);
+      mon->scaling_y = std::min(sy, fit);
+      mon->panel->sdl_invalidate();
+      return;
+    }
     mon->scaling_x = sx;
     mon->scaling_y = sy;
     int nw = mon->frame_width;
@@ -497,13 +559,16 @@ namespace lgfx
     int flag = SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
 #if SDL_FULLSCREEN
     flag |= SDL_WINDOW_FULLSCREEN;
+#else
+    if (m->fullscreen) { flag |= SDL_WINDOW_FULLSCREEN_DESKTOP; }
 #endif
 
     if (m->frame_width < _cfg.panel_width) { m->frame_width = _cfg.panel_width; }
     if (m->frame_height < _cfg.panel_height) { m->frame_height = _cfg.panel_height; }
 
-    int window_width = m->frame_width * m->scaling_x;
-    int window_height = m->frame_height * m->scaling_y;
+    // 全画面ではウィンドウサイズは使われないので、拡大率は作成後に画面に合わせる
+    int window_width = m->frame_width * (m->fullscreen ? 1 : m->scaling_x);
+    int window_height = m->frame_height * (m->fullscreen ? 1 : m->scaling_y);
     int scaling_x = m->scaling_x;
     int scaling_y = m->scaling_y;
     if (m->frame_rotation & 1) {
@@ -517,7 +582,12 @@ namespace lgfx
                                 window_width, window_height, flag);       /*last param. SDL_WINDOW_BORDERLESS to hide borders*/
     }
     m->renderer = SDL_CreateRenderer(m->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    m->texture = SDL_CreateTexture(m->renderer, SDL_PIXELFORMAT_RGB24,
+    if (m->integer_scaling) {
+      // 拡大はレンダラ側で行う。整数倍なので最近傍補間でドットが崩れない
+      SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    }
+    // ARGB8888 は多くのレンダラのネイティブ形式で、ロックしたテクスチャへ直接展開できる
+    m->texture = SDL_CreateTexture(m->renderer, SDL_PIXELFORMAT_ARGB8888,
                      SDL_TEXTUREACCESS_STREAMING, _cfg.panel_width, _cfg.panel_height);
     SDL_SetTextureBlendMode(m->texture, SDL_BLENDMODE_NONE);
 
@@ -544,28 +614,50 @@ namespace lgfx
     bool step_exec = _in_step_exec;
 
     if (_texupdate_counter != _modified_counter) {
-      pixelcopy_t pc(nullptr, color_depth_t::rgb888_3Byte, _write_depth, false);
+      pixelcopy_t pc(nullptr, color_depth_t::argb8888_4Byte, _write_depth, false);
       if (_write_depth == rgb565_2Byte) {
-        pc.fp_copy = pixelcopy_t::copy_rgb_fast<bgr888_t, swap565_t>;
+        pc.fp_copy = pixelcopy_t::copy_rgb_fast<argb8888_t, swap565_t>;
       } else if (_write_depth == rgb888_3Byte) {
-        pc.fp_copy = pixelcopy_t::copy_rgb_fast<bgr888_t, bgr888_t>;
+        pc.fp_copy = pixelcopy_t::copy_rgb_fast<argb8888_t, bgr888_t>;
       } else if (_write_depth == rgb332_1Byte) {
-        pc.fp_copy = pixelcopy_t::copy_rgb_fast<bgr888_t, rgb332_t>;
+        pc.fp_copy = pixelcopy_t::copy_rgb_fast<argb8888_t, rgb332_t>;
       } else if (_write_depth == grayscale_8bit) {
-        pc.fp_copy = pixelcopy_t::copy_rgb_fast<bgr888_t, grayscale_t>;
+        pc.fp_copy = pixelcopy_t::copy_rgb_fast<argb8888_t, grayscale_t>;
       }
 
       if (0 == SDL_LockMutex(_sdl_mutex))
       {
         _texupdate_counter = _modified_counter;
-        for (int y = 0; y < _cfg.panel_height; ++y)
+        // 描画された行だけをロックしたテクスチャへ直接展開する
+        uint_fast16_t y0 = _dirty_y0;
+        uint_fast16_t y1 = std::min<uint_fast16_t>(_dirty_y1, _cfg.panel_height);
+        _dirty_y0 = UINT16_MAX;
+        _dirty_y1 = 0;
+        void* pixels;
+        int pitch;
+        SDL_Rect rect = { 0, (int)y0, (int)_cfg.panel_width, (int)(y1 - y0) };
+        if (y0 < y1 && 0 == SDL_LockTexture(monitor.texture, &rect, &pixels, &pitch))
         {
-          pc.src_x32 = 0;
-          pc.src_data = _lines_buffer[y];
-          pc.fp_copy(&_texturebuf[y * _cfg.panel_width], 0, _cfg.panel_width, &pc);
+#if defined(LGFX_SDL_PIXEL_KERNELS)
+          if (_write_depth == rgb332_1Byte)
+          {
+            for (uint_fast16_t y = y0; y < y1; ++y)
+            {
+              pixel_rgb332_to_argb8888((uint32_t*)((uint8_t*)pixels + (y - y0) * pitch),
+                                       (const uint8_t*)_lines_buffer[y], _cfg.panel_width);
+            }
+          }
+          else
+#endif
+          for (uint_fast16_t y = y0; y < y1; ++y)
+          {
+            pc.src_x32 = 0;
+            pc.src_data = _lines_buffer[y];
+            pc.fp_copy((uint8_t*)pixels + (y - y0) * pitch, 0, _cfg.panel_width, &pc);
+          }
+          SDL_UnlockTexture(monitor.texture);
         }
         SDL_UnlockMutex(_sdl_mutex);
-        SDL_UpdateTexture(monitor.texture, nullptr, _texturebuf, _cfg.panel_width * sizeof(rgb888_t));
       }
     }
 
@@ -642,13 +734,36 @@ namespace lgfx
     SDL_RenderCopyEx(monitor.renderer, texture, nullptr, &dstrect, angle, &pivot, SDL_RendererFlip::SDL_FLIP_NONE);
   }
 
+  bool Panel_sdl::windowToPanel(int* x, int* y)
+  {
+    if (monitor.renderer == nullptr) { return false; }
+
+    int w, h, mw, mh;
+    SDL_GetWindowSize(monitor.window, &w, &h);
+    SDL_GetRendererOutputSize(monitor.renderer, &mw, &mh);
+    if (w <= 0 || h <= 0) { return false; }
+
+    // render_texture の逆変換: 出力画素へ換算し、中心まわりの回転と拡大を戻す
+    float ox = *x * (float)mw / w - mw / 2.0f;
+    float oy = *y * (float)mh / h - mh / 2.0f;
+    float sf = sinf(monitor.frame_angle * M_PI / 180);
+    float cf = cosf(monitor.frame_angle * M_PI / 180);
+    float nx = oy * sf + ox * cf;
+    float ny = oy * cf - ox * sf;
+    int px = (int)floorf(nx / monitor.scaling_x + monitor.frame_width  / 2.0f) - monitor.frame_inner_x;
+    int py = (int)floorf(ny / monitor.scaling_y + monitor.frame_height / 2.0f) - monitor.frame_inner_y;
+
+    // 余白部分は画面の端に寄せる
+    *x = std::max<int>(0, std::min<int>(_cfg.panel_width  - 1, px));
+    *y = std::max<int>(0, std::min<int>(_cfg.panel_height - 1, py));
+    return true;
+  }
+
   bool Panel_sdl::initFrameBuffer(size_t width, size_t height)
   {
     uint8_t** lineArray = (uint8_t**)heap_alloc_dma(height * sizeof(uint8_t*));
     if ( nullptr == lineArray ) { return false; }
 
-    _texturebuf = (rgb888_t*)heap_alloc_dma(width * height * sizeof(rgb888_t));
-
     /// 8byte alignment;
     width = (width + 7) & ~7u;
 
@@ -677,10 +792,6 @@ namespace lgfx
       heap_free(lines[0]);
       heap_free(lines);
     }
-    if (_texturebuf) {
-      heap_free(_texturebuf);
-      _texturebuf = nullptr;
-    }
   }
 
 //----------------------------------------------------------------------------
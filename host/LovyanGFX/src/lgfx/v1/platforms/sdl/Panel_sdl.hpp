@@ -51,6 +51,8 @@ namespace lgfx
 
     float scaling_x = 1;
     float scaling_y = 1;
+    bool integer_scaling = false; // 拡大率を整数倍に限定し、余白は背景色で埋める
+    bool fullscreen = false;
     int_fast16_t touch_x, touch_y;
     bool touched = false;
     bool closing = false;
@@ -94,6 +96,10 @@ namespace lgfx
     void setScaling(uint_fast8_t scaling_x, uint_fast8_t scaling_y);
     void setFrameImage(const void* frame_image, int frame_width, int frame_height, int inner_x, int inner_y);
     void setFrameRotation(uint_fast16_t frame_rotaion);
+    void setIntegerScaling(bool enable);
+    void setFullscreen(bool fullscreen);
+    /// ウィンドウ座標をパネル座標へ変換する (SDLのメインスレッドから呼ぶこと)
+    bool windowToPanel(int* x, int* y);
 
     static int setup(void);
     static int loop(void);
@@ -121,7 +127,8 @@ namespace lgfx
     touch_point_t _touch_point;
     monitor_t monitor;
 
-    rgb888_t* _texturebuf = nullptr;
+    uint_fast16_t _dirty_y0 = 0;          // テクスチャへ未転送の行範囲 [y0, y1)
+    uint_fast16_t _dirty_y1 = UINT16_MAX;
     uint_fast16_t _modified_counter;
     uint_fast16_t _texupdate_counter;
     uint_fast16_t _display_counter;
@@ -130,6 +137,8 @@ namespace lgfx
     static void _event_proc(void);
     static void _update_proc(void);
     static void _update_scaling(monitor_t * m, float sx, float sy);
+    static uint_fast8_t _fit_scaling(monitor_t * m);
+    void _mark_dirty(uint_fast16_t y, uint_fast16_t h);
     void sdl_invalidate(void) { _invalidated = true; }
     void render_texture(SDL_Texture* texture, int tx, int ty, int tw, int th, float angle);
     bool initFrameBuffer(size_t width, size_t height);
@@ -15,7 +15,11 @@ typedef enum {
     FMRB_AUDIO_CMD_PAUSE = 0x04,
     FMRB_AUDIO_CMD_RESUME = 0x05,
     FMRB_AUDIO_CMD_SET_VOLUME = 0x06,
-    FMRB_AUDIO_CMD_GET_STATUS = 0x07
+    FMRB_AUDIO_CMD_GET_STATUS = 0x07,
+    FMRB_AUDIO_CMD_SET_FOCUS = 0x08,
+    FMRB_AUDIO_CMD_SFX_LOAD = 0x09,
+    FMRB_AUDIO_CMD_SFX_TRIGGER = 0x0A,
+    FMRB_AUDIO_CMD_SFX_UNLOAD = 0x0B
 } fmrb_audio_cmd_type_t;
 
 // Audio status
@@ -26,9 +30,11 @@ typedef enum {
     FMRB_AUDIO_STATUS_ERROR = 3
 } fmrb_audio_status_t;
 
-// Audio command structures
+// Audio command structures. Every command names the app (proc_id) it belongs to: each app has
+// its own player, track table and volume on the host, so apps never stop or retune each other.
 typedef struct {
     uint8_t cmd_type;
+    uint8_t proc_id;
     uint32_t music_id;
     uint32_t data_size;
     // music binary data follows
@@ -36,35 +42,131 @@ typedef struct {
 
 typedef struct {
     uint8_t cmd_type;
+    uint8_t proc_id;
     uint32_t music_id;
 } __attribute__((packed)) fmrb_audio_play_cmd_t;
 
 typedef struct {
     uint8_t cmd_type;
+    uint8_t proc_id;
 } __attribute__((packed)) fmrb_audio_stop_cmd_t;
 
 typedef struct {
     uint8_t cmd_type;
+    uint8_t proc_id;
 } __attribute__((packed)) fmrb_audio_pause_cmd_t;
 
 typedef struct {
     uint8_t cmd_type;
+    uint8_t proc_id;
 } __attribute__((packed)) fmrb_audio_resume_cmd_t;
 
 typedef struct {
     uint8_t cmd_type;
-    uint8_t volume;  // 0-255
+    uint8_t proc_id;
+    uint8_t volume;  // 0-255, the app's gain in the mix
 } __attribute__((packed)) fmrb_audio_volume_cmd_t;
 
 typedef struct {
     uint8_t cmd_type;
+    uint8_t proc_id;
 } __attribute__((packed)) fmrb_audio_status_cmd_t;
 
+// The focused app plays at its own volume; every other app is ducked (FMRB_AUDIO_NO_FOCUS: none)
+typedef struct {
+    uint8_t cmd_type;
+    uint8_t proc_id;
+} __attribute__((packed)) fmrb_audio_focus_cmd_t;
+
+// Sound effects: PCM uploaded once into the app's bank, then played by id with SFX_TRIGGER.
+// An upload is a series of SFX_LOAD chunks at increasing offsets (offset 0 starts it); the
+// effect becomes playable once total_size bytes have arrived.
+typedef struct {
+    uint8_t cmd_type;
+    uint8_t proc_id;
+    uint8_t sfx_id;           // 0 - FMRB_SFX_MAX_EFFECTS-1
+    uint8_t bits_per_sample;  // 8 (unsigned) or 16 (signed little endian), mono
+    uint8_t max_voices;       // Polyphony limit for this effect (0: FMRB_SFX_DEFAULT_VOICES)
+    uint8_t priority;         // Higher-priority effects steal voices from lower ones
+    uint32_t sample_rate;
+    uint32_t total_size;      // Whole effect in bytes
+    uint32_t offset;          // Of this chunk
+    // chunk data follows
+} __attribute__((packed)) fmrb_audio_sfx_load_cmd_t;
+
+// Kept tiny: the host handles it on its receive thread, so it reaches the audio thread at
+// its next buffer
+typedef struct {
+    uint8_t cmd_type;
+    uint8_t proc_id;
+    uint8_t sfx_id;
+    uint8_t volume;           // 0-255
+    int8_t pan;               // -127 (left) .. 127 (right)
+    int16_t pitch;            // Cents, -2400 .. 2400
+} __attribute__((packed)) fmrb_audio_sfx_trigger_cmd_t;
+
+typedef struct {
+    uint8_t cmd_type;
+    uint8_t proc_id;
+    uint8_t sfx_id;           // FMRB_SFX_ALL: every effect of the app
+} __attribute__((packed)) fmrb_audio_sfx_unload_cmd_t;
+
+// APU music binary (FMRB_AUDIO_CMD_LOAD_BINARY data), multi-byte values little endian
+//
+//   header: "FAPU", uint8 version (FMRB_APU_FORMAT_VERSION), uint8 reserved, uint16 tick rate (Hz)
+//   then a stream of events, played from the start on FMRB_AUDIO_CMD_PLAY:
+//
+//   0x00-0x7F                 WAIT      wait (n + 1) ticks
+//   0x80+ch note vel          NOTE_ON   MIDI note number, velocity 0-127
+//   0x90+ch                   NOTE_OFF  start the release stage
+//   0xA0+ch wave a d s r      INSTR     wave parameter (pulse duty 0-3 = 12.5/25/50/75%,
+//                                       noise 0 = white / 1 = periodic), attack/decay/release
+//                                       in 4 ms steps, sustain level 0-255
+//   0xB0+ch vol               VOLUME    channel volume 0-255
+//   0xC0 ticks16              WAIT_LONG wait ticks16 ticks
+//   0xD0 rate16 len32 loop32 pcm[len]
+//                             SAMPLE    signed 8-bit PCM for the sample channel at rate16 Hz
+//                                       (note 60 plays at that rate), loop32 = loop start or
+//                                       0xFFFFFFFF for one-shot
+//   0xE0                      LOOP_MARK
+//   0xE1                      LOOP      jump back to the mark (or the first event)
+//   0xFF                      END
+#define FMRB_APU_FORMAT_VERSION 1
+#define FMRB_APU_HEADER_SIZE    8
+
+typedef enum {
+    FMRB_APU_CH_PULSE1 = 0,
+    FMRB_APU_CH_PULSE2 = 1,
+    FMRB_APU_CH_TRIANGLE = 2,
+    FMRB_APU_CH_NOISE = 3,
+    FMRB_APU_CH_SAMPLE = 4,
+    FMRB_APU_CH_COUNT = 5
+} fmrb_apu_channel_t;
+
+typedef enum {
+    FMRB_APU_OP_NOTE_ON = 0x80,
+    FMRB_APU_OP_NOTE_OFF = 0x90,
+    FMRB_APU_OP_INSTR = 0xA0,
+    FMRB_APU_OP_VOLUME = 0xB0,
+    FMRB_APU_OP_WAIT_LONG = 0xC0,
+    FMRB_APU_OP_SAMPLE = 0xD0,
+    FMRB_APU_OP_LOOP_MARK = 0xE0,
+    FMRB_APU_OP_LOOP = 0xE1,
+    FMRB_APU_OP_END = 0xFF
+} fmrb_apu_op_t;
+
 // Audio configuration
 #define FMRB_AUDIO_SAMPLE_RATE 44100
 #define FMRB_AUDIO_CHANNELS    2
-#define FMRB_AUDIO_BUFFER_SIZE 1024
-#define FMRB_MAX_MUSIC_TRACKS  16
+#define FMRB_AUDIO_BUFFER_SIZE 512   // ~12 ms: effects start within a 60 Hz frame
+#define FMRB_MAX_MUSIC_TRACKS  16     // Per app
+#define FMRB_AUDIO_MAX_APPS    8      // proc_id range with its own player
+#define FMRB_AUDIO_NO_FOCUS    0xFF
+#define FMRB_SFX_MAX_EFFECTS   32     // Per app
+#define FMRB_SFX_MAX_VOICES    16     // Shared by all apps
+#define FMRB_SFX_DEFAULT_VOICES 4
+#define FMRB_SFX_MAX_SIZE      (1024 * 1024)
+#define FMRB_SFX_ALL           0xFF
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,274 @@
+/**
+ * Replays a link recording (FMRB_RECORD=<file> fmrb_host_sdl2, see link_recorder.h) into
+ * graphics_handler_process_command() against an in-memory framebuffer and reports command
+ * throughput, time per graphics sub_cmd and frame render times. Audio commands drive the APU
+ * synthesizer and the PCM stream, which render the recording's duration of audio; the CPU cost
+ * is reported per second of audio, along with stream underruns and overruns.
+ *
+ *   fmrb_link_replay [--realtime] [--frame-ms N] <recording>
+ *
+ * Frames are cut from the recorded timestamps (one every --frame-ms, default 16), so the same
+ * recording always renders the same frames; --realtime also waits for each message's time.
+ */
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+extern "C" {
+#include "graphics_handler.h"
+#include "input_handler.h"
+#include "link_recorder.h"
+#include "audio_handler.h"
+#include "apu_synth.h"
+#include "audio_mixer.h"
+#include "pcm_stream.h"
+#include "sfx_bank.h"
+#include "fmrb_link_protocol.h"
+#include "fmrb_gfx.h"
+}
+
+LovyanGFX* g_lgfx = nullptr; // Display graphics_handler draws to (shared with graphics_handler.cpp)
+static LGFX_Sprite* framebuffer = nullptr;
+
+// graphics_handler talks back to the core and reads the pointer; a replay has neither
+extern "C" int socket_server_send_ack(uint8_t, uint8_t, const uint8_t*, uint16_t) { return 0; }
+extern "C" int socket_server_send_message(uint8_t, uint8_t, const uint8_t*, uint16_t) { return 0; }
+extern "C" int input_handler_get_cursor(int*, int*, uint64_t*) { return -1; }
+extern "C" uint64_t input_handler_find_motion(int, int) { return 0; }
+
+#define DEFAULT_FRAME_MS 16
+
+typedef struct {
+    unsigned long count;
+    double total_us;
+    double max_us;
+} cmd_stats_t;
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int display_init(uint16_t width, uint16_t height, uint8_t color_depth) {
+    if (framebuffer) {
+        return 0;
+    }
+    framebuffer = new LGFX_Sprite();
+    framebuffer->setColorDepth(color_depth);
+    if (!framebuffer->createSprite(width, height)) {
+        fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        delete framebuffer;
+        framebuffer = nullptr;
+        return -1;
+    }
+    g_lgfx = framebuffer;
+    return graphics_handler_init(nullptr);
+}
+
+// Synthesize audio up to a point on the recording's timeline, in device-sized buffers
+static uint64_t audio_start = 0;    // Frame of the first audio command
+static uint64_t audio_frames = 0;
+static double audio_us = 0.0;
+
+static void audio_render_until(uint64_t time_us) {
+    static int16_t buffer[FMRB_AUDIO_BUFFER_SIZE * FMRB_AUDIO_CHANNELS];
+    const uint64_t target = time_us * FMRB_AUDIO_SAMPLE_RATE / 1000000u;
+    while (audio_frames < target) {
+        int frames = (int)std::min<uint64_t>(target - audio_frames, FMRB_AUDIO_BUFFER_SIZE);
+        double t0 = now_us();
+        audio_handler_render(buffer, frames);
+        audio_us += now_us() - t0;
+        audio_frames += frames;
+    }
+}
+
+static double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+int main(int argc, char* argv[]) {
+    int realtime = 0;
+    double frame_us = DEFAULT_FRAME_MS * 1000.0;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--realtime") == 0) {
+            realtime = 1;
+        } else if (strcmp(argv[i], "--frame-ms") == 0 && i + 1 < argc) {
+            frame_us = atof(argv[++i]) * 1000.0;
+        } else if (!path && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (!path || frame_us <= 0) {
+        fprintf(stderr, "Usage: %s [--realtime] [--frame-ms N] <recording>\n", argv[0]);
+        return 2;
+    }
+
+    link_recording_t rec;
+    if (link_recording_open(&rec, path) < 0) {
+        return 1;
+    }
+    graphics_handler_set_log_level(GFX_LOG_NONE);
+    apu_synth_init(FMRB_AUDIO_SAMPLE_RATE);
+    audio_mixer_init(FMRB_AUDIO_SAMPLE_RATE);
+    sfx_bank_init(FMRB_AUDIO_SAMPLE_RATE);
+    pcm_stream_init(FMRB_AUDIO_SAMPLE_RATE, 0);
+    int audio_seen = 0;
+    uint64_t last_time_us = 0;
+
+    static cmd_stats_t stats[256];
+    std::vector<double> frame_times;
+    unsigned long messages = 0, commands = 0, failed = 0;
+    double command_us = 0.0, render_us = 0.0;
+    double next_frame = frame_us;
+
+    link_record_t msg;
+    int ret;
+    const double start = now_us();
+    while ((ret = link_recording_next(&rec, &msg)) > 0) {
+        messages++;
+        last_time_us = msg.time_us;
+        if (audio_seen) {
+            audio_render_until(msg.time_us);
+        }
+
+        // Everything recorded before the frame tick is on screen before this message is applied
+        if (framebuffer && (double)msg.time_us >= next_frame) {
+            if (graphics_handler_frame_pending()) {
+                double t0 = now_us();
+                graphics_handler_render_frame();
+                double t = now_us() - t0;
+                graphics_handler_frame_done();
+                frame_times.push_back(t);
+                render_us += t;
+            }
+            next_frame = (std::floor((double)msg.time_us / frame_us) + 1.0) * frame_us;
+        }
+
+        if (realtime) {
+            double wait = start + (double)msg.time_us - now_us();
+            if (wait > 0) {
+                struct timespec ts = { (time_t)(wait / 1e6), (long)((uint64_t)wait % 1000000u) * 1000 };
+                nanosleep(&ts, nullptr);
+            }
+        }
+
+        const uint8_t type = msg.type & 0x7F;
+        if (type == FMRB_LINK_TYPE_CONTROL && msg.sub_cmd == FMRB_LINK_CONTROL_INIT_DISPLAY &&
+            msg.len >= sizeof(fmrb_control_init_display_t)) {
+            const fmrb_control_init_display_t* init_cmd = (const fmrb_control_init_display_t*)msg.payload;
+            if (display_init(init_cmd->width, init_cmd->height, init_cmd->color_depth) < 0) {
+                break;
+            }
+        } else if (type == FMRB_LINK_TYPE_AUDIO) {
+            if (!audio_seen) {
+                audio_seen = 1;
+                audio_start = msg.time_us * FMRB_AUDIO_SAMPLE_RATE / 1000000u;
+                audio_frames = audio_start;
+            }
+            int r = msg.sub_cmd == FMRB_LINK_MSG_AUDIO_QUEUE_SAMPLES
+                        ? audio_handler_queue_samples(msg.payload, msg.len, nullptr)
+                        : audio_handler_process_command(msg.payload, msg.len, nullptr);
+            if (r != 0) {
+                failed++;
+            }
+        } else if (type == FMRB_LINK_TYPE_GRAPHICS) {
+            // Recording started after INIT_DISPLAY: assume the core's default screen
+            if (!framebuffer && display_init(480, 320, 8) < 0) {
+                break;
+            }
+            double t0 = now_us();
+            if (graphics_handler_process_command(msg.type, msg.sub_cmd, msg.seq, msg.payload, msg.len) != 0) {
+                failed++;
+            }
+            double t = now_us() - t0;
+            cmd_stats_t* s = &stats[msg.sub_cmd];
+            s->count++;
+            s->total_us += t;
+            if (t > s->max_us) {
+                s->max_us = t;
+            }
+            command_us += t;
+            commands++;
+        }
+    }
+    // Last frame: whatever the final messages changed
+    if (framebuffer && graphics_handler_frame_pending()) {
+        double t0 = now_us();
+        graphics_handler_render_frame();
+        double t = now_us() - t0;
+        frame_times.push_back(t);
+        render_us += t;
+    }
+    if (audio_seen) {
+        audio_render_until(last_time_us);
+    }
+    const double wall_us = now_us() - start;
+    if (ret < 0) {
+        fprintf(stderr, "Recording is truncated or corrupt after %lu messages\n", messages);
+    }
+    link_recording_close(&rec);
+
+    printf("Replayed %lu messages (%lu graphics commands, %lu failed) in %.1f ms%s\n",
+           messages, commands, failed, wall_us / 1000.0, realtime ? " (real time)" : "");
+    if (command_us > 0) {
+        printf("  Commands: %.0f/s (%.1f ms handling)\n", commands * 1e6 / command_us, command_us / 1000.0);
+    }
+    if (!frame_times.empty()) {
+        const size_t frames = frame_times.size();
+        const double max_us = *std::max_element(frame_times.begin(), frame_times.end());
+        printf("  Frames: %zu, render avg %.3f ms, p50 %.3f ms, p95 %.3f ms, max %.3f ms\n",
+               frames, render_us / frames / 1000.0, percentile(frame_times, 0.50) / 1000.0,
+               percentile(frame_times, 0.95) / 1000.0, max_us / 1000.0);
+    }
+
+    if (audio_us > 0) {
+        const double audio_seconds = (double)(audio_frames - audio_start) / FMRB_AUDIO_SAMPLE_RATE;
+        printf("  Audio: %.1f s synthesized, %.3f ms CPU per second of audio (%.2f%% of a core)\n",
+               audio_seconds, audio_us / 1000.0 / audio_seconds, audio_us / 1e4 / audio_seconds);
+        fmrb_link_audio_queue_status_t stream;
+        pcm_stream_get_status(&stream);
+        if (stream.underruns || stream.overruns) {
+            printf("  PCM stream: %u underruns, %u overruns\n", stream.underruns, stream.overruns);
+        }
+    }
+
+    // Graphics sub_cmds, most expensive first
+    std::vector<int> order;
+    for (int i = 0; i < 256; i++) {
+        if (stats[i].count > 0) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [](int a, int b) { return stats[a].total_us > stats[b].total_us; });
+    printf("  sub_cmd      count   total ms    avg us    max us\n");
+    for (int i : order) {
+        printf("  0x%02x    %9lu %10.2f %9.2f %9.1f\n", i, stats[i].count, stats[i].total_us / 1000.0,
+               stats[i].total_us / stats[i].count, stats[i].max_us);
+    }
+
+    graphics_handler_cleanup();
+    apu_synth_cleanup();
+    sfx_bank_cleanup();
+    pcm_stream_cleanup();
+    delete framebuffer;
+    framebuffer = nullptr;
+    g_lgfx = nullptr;
+    return ret < 0 ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+#ifndef APU_SYNTH_H
+#define APU_SYNTH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../../common/audio_commands.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Chip-style synthesizer behind the APU commands: two pulse channels, a triangle, a noise
+ * channel and an 8-bit sample channel, each with an ADSR envelope, driven by the music
+ * binary format described in audio_commands.h. Every app (proc_id below FMRB_AUDIO_MAX_APPS)
+ * has its own player and track table; audio_mixer.c mixes the players.
+ *
+ * Threading: load/play/stop/pause/resume are called from one control thread (the host loop)
+ * and only post to a lock-free queue; apu_synth_update() and apu_synth_render() run on the
+ * audio thread and never block or allocate. Songs the audio thread stops using are handed back
+ * through a second queue and freed on the control thread.
+ */
+
+/**
+ * @brief Initialize the synthesizer
+ * @param sample_rate Output rate in Hz
+ * @return 0 on success, -1 on error
+ */
+int apu_synth_init(int sample_rate);
+
+/**
+ * @brief Free all songs; the audio thread must no longer call apu_synth_render()
+ */
+void apu_synth_cleanup(void);
+
+/**
+ * @brief Store a music binary under an app's track ID (replaces an existing one; a playing copy
+ *        finishes its current play)
+ * @param app App (proc_id)
+ * @param music_id Track ID
+ * @param data Music binary
+ * @param size Binary size
+ * @return 0 on success, -1 on error (bad app or header, table full, no memory)
+ */
+int apu_synth_load(int app, uint32_t music_id, const uint8_t *data, size_t size);
+
+/**
+ * @brief Start one of the app's tracks from the beginning
+ * @param app App (proc_id)
+ * @param music_id Track ID
+ * @return 0 on success, -1 if the track is unknown or the command queue is full
+ */
+int apu_synth_play(int app, uint32_t music_id);
+
+/**
+ * @brief Stop the app's playback
+ * @param app App (proc_id)
+ * @return 0 on success, -1 if the command queue is full
+ */
+int apu_synth_stop(int app);
+
+/**
+ * @brief Pause the app's playback (position and notes are kept)
+ * @param app App (proc_id)
+ * @return 0 on success, -1 if the command queue is full
+ */
+int apu_synth_pause(int app);
+
+/**
+ * @brief Resume the app's paused playback
+ * @param app App (proc_id)
+ * @return 0 on success, -1 if the command queue is full
+ */
+int apu_synth_resume(int app);
+
+/**
+ * @brief Get the app's playback status as last published by the audio thread
+ * @param app App (proc_id)
+ * @return Current status (FMRB_AUDIO_STATUS_ERROR for an invalid app)
+ */
+fmrb_audio_status_t apu_synth_get_status(int app);
+
+/**
+ * @brief Apply queued commands (audio thread, once per callback before rendering)
+ */
+void apu_synth_update(void);
+
+/**
+ * @brief Synthesize one app's audio (audio thread)
+ * @param app App (proc_id)
+ * @param out Interleaved stereo S16 output, frames * 2 samples
+ * @param frames Frame count
+ * @return 1 if out was written, 0 if the app is silent (out is left untouched)
+ */
+int apu_synth_render(int app, int16_t *out, int frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // APU_SYNTH_H
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "../../common/audio_commands.h"
+#include "fmrb_link_protocol.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,23 +23,29 @@ void audio_handler_cleanup(void);
 
 /**
  * @brief Process audio command
- * @param data Command data
+ * @param data Command data ([cmd_type | proc_id | fields], see audio_commands.h)
  * @param size Data size
+ * @param status Playback status of the command's app afterwards, for the ACK (can be NULL)
  * @return 0 on success, -1 on error
  */
-int audio_handler_process_command(const uint8_t *data, size_t size);
+int audio_handler_process_command(const uint8_t *data, size_t size, fmrb_audio_status_t *status);
 
 /**
- * @brief Get current audio status
- * @return Current audio status
+ * @brief Queue streamed PCM samples (FMRB_LINK_MSG_AUDIO_QUEUE_SAMPLES)
+ * @param data fmrb_link_audio_play_t header followed by the PCM data
+ * @param size Data size
+ * @param status Stream buffer state for the ACK (can be NULL)
+ * @return 0 on success, -1 on error
  */
-fmrb_audio_status_t audio_handler_get_status(void);
+int audio_handler_queue_samples(const uint8_t *data, size_t size,
+                                fmrb_link_audio_queue_status_t *status);
 
 /**
- * @brief Set audio volume
- * @param volume Volume level (0-255)
+ * @brief Render the mixed output: every app's synthesizer plus streamed samples (audio thread)
+ * @param out Interleaved stereo S16 buffer, frames * 2 samples
+ * @param frames Frame count
  */
-void audio_handler_set_volume(uint8_t volume);
+void audio_handler_render(int16_t *out, int frames);
 
 #ifdef __cplusplus
 }
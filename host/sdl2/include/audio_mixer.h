@@ -0,0 +1,56 @@
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Mixes each app's APU player and sound effects, then the PCM stream, into the device buffer.
+ * Each app has its own gain (SET_VOLUME), and every app but the focused one is ducked to
+ * AUDIO_MIXER_DUCK_PERCENT of its gain. Gain changes ramp over AUDIO_MIXER_RAMP_MS so they do not click. The gain and
+ * saturating add run on SSE2 (x86-64) or NEON (AArch64), which both targets always have.
+ *
+ * Threading: audio_mixer_set_volume() and audio_mixer_set_focus() only store atomics and can be
+ * called from the control thread at any time; audio_mixer_render() runs on the audio thread.
+ */
+
+#define AUDIO_MIXER_DEFAULT_VOLUME 128
+#define AUDIO_MIXER_DUCK_PERCENT 30
+#define AUDIO_MIXER_RAMP_MS 50
+
+/**
+ * @brief Reset gains and focus
+ * @param sample_rate Output rate in Hz (sets the ramp speed)
+ */
+void audio_mixer_init(int sample_rate);
+
+/**
+ * @brief Set an app's gain
+ * @param app App (proc_id)
+ * @param volume Volume level (0-255)
+ * @return 0 on success, -1 for an invalid app
+ */
+int audio_mixer_set_volume(int app, uint8_t volume);
+
+/**
+ * @brief Set the focused app; the others are ducked
+ * @param app Focused proc_id, or FMRB_AUDIO_NO_FOCUS to duck nobody
+ */
+void audio_mixer_set_focus(uint8_t app);
+
+/**
+ * @brief Render the device buffer: every audible app, then the PCM stream (audio thread)
+ * @param out Interleaved stereo S16 output, frames * 2 samples
+ * @param frames Frame count
+ */
+void audio_mixer_render(int16_t *out, int frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_MIXER_H
@@ -55,8 +55,24 @@ void graphics_handler_set_log_level(int level);
  * @brief Render all canvases to screen in Z-order
  * This function composites all visible canvases to the screen based on their Z-order.
  * Should be called periodically (e.g., every frame in main loop).
+ * Only windows that changed since the last call are recomposited, over the rectangles they cover.
+ * @return 1 if the screen was updated and needs display(), 0 if nothing changed
  */
-void graphics_handler_render_frame(void);
+int graphics_handler_render_frame(void);
+
+/**
+ * @brief Check whether the next frame would show something new
+ * True after a canvas was presented or changed, or the cursor moved, changed shape or visibility.
+ * @return 1 if a frame should be rendered, 0 if the screen is up to date
+ */
+int graphics_handler_frame_pending(void);
+
+/**
+ * @brief Notify the core that a frame has been displayed
+ * Sends FRAME_DONE when canvases were pushed to RENDER since the last notification.
+ * Call after the frame is on screen (after display()).
+ */
+void graphics_handler_frame_done(void);
 
 #ifdef __cplusplus
 }
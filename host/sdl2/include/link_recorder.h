@@ -0,0 +1,88 @@
+#ifndef LINK_RECORDER_H
+#define LINK_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Link traffic recordings: every decoded link message [type, seq, sub_cmd, payload] with the
+ * time it was received, so a real session can be replayed against graphics_handler
+ * (see bench/link_replay.cpp).
+ *
+ * File layout (host byte order):
+ *   header: "FMRBREC" + format version byte (8 bytes)
+ *   record: uint64 time_us since recording start, uint8 type, uint8 seq, uint8 sub_cmd,
+ *           uint8 reserved, uint32 payload length, payload bytes
+ */
+
+#define LINK_RECORDING_VERSION 1
+
+typedef struct {
+    uint64_t time_us;              // Receive time relative to the start of the recording
+    uint8_t type;
+    uint8_t seq;
+    uint8_t sub_cmd;
+    uint32_t len;
+    uint8_t *payload;              // Owned by the reader, valid until the next read
+} link_record_t;
+
+typedef struct {
+    FILE *fp;
+    uint8_t *buffer;
+    size_t buffer_size;
+} link_recording_t;
+
+/**
+ * @brief Start recording received messages to a file (replaces an open recording)
+ * @param path Output file
+ * @return 0 on success, -1 on error
+ */
+int link_recorder_open(const char *path);
+
+/**
+ * @brief Append one message to the open recording (no-op when not recording)
+ * Called from the socket receive thread only.
+ * @param type Message type
+ * @param seq Sequence number
+ * @param sub_cmd Sub-command
+ * @param payload Payload data (can be NULL)
+ * @param len Payload length
+ */
+void link_recorder_write(uint8_t type, uint8_t seq, uint8_t sub_cmd, const uint8_t *payload, size_t len);
+
+/**
+ * @brief Flush and close the recording
+ */
+void link_recorder_close(void);
+
+/**
+ * @brief Open a recording for reading
+ * @param rec Reader state
+ * @param path Recording file
+ * @return 0 on success, -1 on error (missing file or wrong format)
+ */
+int link_recording_open(link_recording_t *rec, const char *path);
+
+/**
+ * @brief Read the next message
+ * @param rec Reader state
+ * @param out Message; out->payload stays valid until the next call
+ * @return 1 when a message was read, 0 at the end, -1 on a truncated or corrupt file
+ */
+int link_recording_next(link_recording_t *rec, link_record_t *out);
+
+/**
+ * @brief Close a recording opened with link_recording_open()
+ */
+void link_recording_close(link_recording_t *rec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINK_RECORDER_H
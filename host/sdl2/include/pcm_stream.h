@@ -0,0 +1,65 @@
+#ifndef PCM_STREAM_H
+#define PCM_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "fmrb_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming PCM from the core (FMRB_LINK_MSG_AUDIO_QUEUE_SAMPLES): samples are converted to
+ * the output format and rate when they arrive and held in a jitter buffer that the audio
+ * callback mixes from. Playback (re)starts only once the buffer holds the latency target, so
+ * uneven delivery does not turn into clicks; the fill level goes back to the core in the ACK.
+ *
+ * Threading: pcm_stream_queue() runs on one producer thread (the host loop),
+ * pcm_stream_mix() on the audio thread; they share only a lock-free ring.
+ */
+
+#define PCM_STREAM_DEFAULT_LATENCY_MS 60
+#define PCM_STREAM_CAPACITY_MS 500      // Buffer size; samples beyond this are dropped
+
+/**
+ * @brief Initialize the stream buffer
+ * @param output_rate Output sample rate in Hz (stereo S16)
+ * @param latency_ms Latency target; 0 uses PCM_STREAM_DEFAULT_LATENCY_MS
+ * @return 0 on success, -1 on error
+ */
+int pcm_stream_init(int output_rate, int latency_ms);
+
+/**
+ * @brief Free the buffer; the audio thread must no longer call pcm_stream_mix()
+ */
+void pcm_stream_cleanup(void);
+
+/**
+ * @brief Queue samples (producer thread)
+ * @param data fmrb_link_audio_play_t header followed by the PCM data
+ *             (8-bit unsigned or 16-bit signed little endian, 1 or 2 channels, any rate)
+ * @param size Message size
+ * @param status Buffer state after queuing (can be NULL)
+ * @return 0 on success, -1 on a malformed message
+ */
+int pcm_stream_queue(const uint8_t *data, size_t size, fmrb_link_audio_queue_status_t *status);
+
+/**
+ * @brief Get the buffer state
+ * @param status Output
+ */
+void pcm_stream_get_status(fmrb_link_audio_queue_status_t *status);
+
+/**
+ * @brief Add buffered samples to an output buffer with saturation (audio thread)
+ * @param out Interleaved stereo S16 buffer, frames * 2 samples
+ * @param frames Frame count
+ */
+void pcm_stream_mix(int16_t *out, int frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PCM_STREAM_H
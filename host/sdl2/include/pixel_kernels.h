@@ -0,0 +1,67 @@
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pixel conversion and blit kernels for the host output path.
+ * Each kernel has a scalar version and SIMD versions (AVX2 / SSSE3 on x86, NEON on AArch64);
+ * the fastest one the CPU supports is picked by pixel_kernels_init(), which graphics_handler_init()
+ * calls before the compose workers start. Until then the scalar kernels are used.
+ * RGB332 expands to 8-bit channels exactly like LovyanGFX (rgb332_t::R8/G8/B8).
+ */
+
+typedef enum {
+    PIXEL_ISA_SCALAR = 0,
+    PIXEL_ISA_SSSE3,       // PSHUFB table lookups; the keyed blit needs only SSE2
+    PIXEL_ISA_AVX2,
+    PIXEL_ISA_NEON,
+} pixel_isa_t;
+
+/**
+ * @brief Select the kernels to use (call before other threads use them)
+ * @param allow_simd 0 forces the scalar kernels (for comparison), 1 picks the best supported
+ * @return Instruction set now in use
+ */
+pixel_isa_t pixel_kernels_init(int allow_simd);
+
+/**
+ * @brief Name of an instruction set, for logs
+ */
+const char* pixel_kernels_isa_name(pixel_isa_t isa);
+
+/**
+ * @brief Expand RGB332 pixels to packed 24-bit R,G,B bytes (SDL_PIXELFORMAT_RGB24)
+ * @param dst Output, count * 3 bytes
+ * @param src Input, count bytes
+ * @param count Pixel count
+ */
+void pixel_rgb332_to_rgb888(uint8_t* dst, const uint8_t* src, size_t count);
+
+/**
+ * @brief Expand RGB332 pixels to 32-bit 0xAARRGGBB words, alpha 0xFF (SDL_PIXELFORMAT_ARGB8888)
+ * @param dst Output, count words
+ * @param src Input, count bytes
+ * @param count Pixel count
+ */
+void pixel_rgb332_to_argb8888(uint32_t* dst, const uint8_t* src, size_t count);
+
+/**
+ * @brief Copy 8-bit pixels, leaving dst untouched where src equals the key color
+ * @param dst Destination row
+ * @param src Source row
+ * @param count Pixel count
+ * @param key Transparent color
+ */
+void pixel_blit_key8(uint8_t* dst, const uint8_t* src, size_t count, uint8_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PIXEL_KERNELS_H
@@ -0,0 +1,79 @@
+#ifndef SFX_BANK_H
+#define SFX_BANK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../../common/audio_commands.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Sound-effect bank: short PCM clips uploaded once per app and played by id on a shared pool of
+ * FMRB_SFX_MAX_VOICES voices, each with its own pitch, volume and pan. An effect that already
+ * plays max_voices times restarts its oldest voice; when the pool is full, the trigger steals
+ * the oldest voice of the lowest priority at or below its own, or is dropped.
+ *
+ * Threading: uploads and unloads run on one control thread (the host loop), triggers on one
+ * trigger thread (the receive thread, so they skip the render queue), and sfx_bank_update() /
+ * sfx_bank_render() on the audio thread. Each path has its own lock-free queue; replaced clips
+ * are handed back to the control thread to be freed.
+ */
+
+/**
+ * @brief Initialize the bank
+ * @param sample_rate Output rate in Hz
+ * @return 0 on success, -1 on error
+ */
+int sfx_bank_init(int sample_rate);
+
+/**
+ * @brief Free every effect; the audio thread must no longer call sfx_bank_render()
+ */
+void sfx_bank_cleanup(void);
+
+/**
+ * @brief Receive one upload chunk (control thread)
+ * @param cmd Chunk header
+ * @param data Chunk data
+ * @param size Chunk size
+ * @return 0 on success, -1 on error (the upload is abandoned)
+ */
+int sfx_bank_load(const fmrb_audio_sfx_load_cmd_t *cmd, const uint8_t *data, size_t size);
+
+/**
+ * @brief Remove an effect, stopping its voices (control thread)
+ * @param app App (proc_id)
+ * @param sfx_id Effect, or FMRB_SFX_ALL
+ * @return 0 on success, -1 on error
+ */
+int sfx_bank_unload(int app, uint8_t sfx_id);
+
+/**
+ * @brief Play an effect (trigger thread)
+ * @param cmd Trigger
+ * @return 0 on success, -1 if the command is invalid or the trigger queue is full
+ */
+int sfx_bank_trigger(const fmrb_audio_sfx_trigger_cmd_t *cmd);
+
+/**
+ * @brief Apply queued uploads and triggers (audio thread, once per callback before rendering)
+ */
+void sfx_bank_update(void);
+
+/**
+ * @brief Add one app's voices to a buffer (audio thread)
+ * @param app App (proc_id)
+ * @param out Interleaved stereo S16 buffer, frames * 2 samples
+ * @param frames Frame count
+ * @param have_audio 0 if out holds nothing yet (it is cleared before the first voice is added)
+ * @return 1 if out holds audio, 0 if it was left untouched
+ */
+int sfx_bank_render(int app, int16_t *out, int frames, int have_audio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SFX_BANK_H
@@ -10,6 +10,8 @@ extern "C" {
 
 /**
  * @brief Start socket server
+ * Starts the receive thread, which reads and decodes incoming frames, acknowledges graphics
+ * commands and queues the messages for socket_server_process().
  * @return 0 on success, -1 on error
  */
 int socket_server_start(void);
@@ -21,10 +23,24 @@ void socket_server_stop(void);
 
 /**
  * @brief Process incoming socket messages
+ * Handles every message the receive thread has queued, on the calling (render) thread.
  * @return Number of messages processed
  */
 int socket_server_process(void);
 
+/**
+ * @brief Wait until messages are queued or socket_server_wake() is called
+ * @param timeout_ms Maximum wait in milliseconds (-1 = no limit, 0 = just check)
+ * @return Number of ready descriptors, 0 on timeout, -1 on error
+ */
+int socket_server_wait(int timeout_ms);
+
+/**
+ * @brief Wake a thread blocked in socket_server_wait()
+ * Safe to call from other threads and from signal handlers.
+ */
+void socket_server_wake(void);
+
 /**
  * @brief Check if server is running
  * @return 1 if running, 0 if not
@@ -41,6 +57,16 @@ int socket_server_is_running(void);
  */
 int socket_server_send_ack(uint8_t type, uint8_t seq, const uint8_t *response_data, uint16_t response_len);
 
+/**
+ * @brief Send a host-initiated message to the client (acknowledged by the client)
+ * @param type Message type
+ * @param sub_cmd Sub-command within the message type
+ * @param data Payload data (can be NULL)
+ * @param len Payload length
+ * @return 0 on success, -1 on error
+ */
+int socket_server_send_message(uint8_t type, uint8_t sub_cmd, const uint8_t *data, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
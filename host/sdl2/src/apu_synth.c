@@ -0,0 +1,653 @@
+#include "apu_synth.h"
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define APU_QUEUE_SIZE 64               // Control commands in flight
+#define APU_RING_SLOTS (APU_QUEUE_SIZE * 2)   // >= APU_QUEUE_SIZE + FMRB_AUDIO_MAX_APPS
+#define APU_BLOCK_FRAMES 256            // Channels are mixed in blocks of this many frames
+#define APU_CHANNEL_AMPLITUDE 6000      // Peak of one channel at full velocity and volume
+#define APU_ENV_MAX (1 << 15)           // Envelope full scale
+#define APU_ENV_UNIT_MS 4               // Attack/decay/release units in the music binary
+#define APU_NO_LOOP 0xFFFFFFFFu
+#define APU_NOISE_MAX_INC (16 << 16)    // Noise clock limit: at most 16 LFSR steps per sample
+
+typedef struct {
+    SDL_atomic_t refs;       // Track table + queued PLAY commands + the audio thread
+    uint32_t music_id;
+    uint16_t tick_hz;
+    size_t size;
+    uint8_t data[];
+} apu_song_t;
+
+typedef enum {
+    APU_MSG_PLAY,
+    APU_MSG_STOP,
+    APU_MSG_PAUSE,
+    APU_MSG_RESUME,
+    APU_MSG_RELEASE          // Audio thread -> control thread: song no longer referenced
+} apu_msg_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t app;
+    apu_song_t *song;
+} apu_msg_t;
+
+// Single-producer single-consumer ring; SDL atomics are full barriers, so storing the index
+// publishes the slot written before it
+typedef struct {
+    apu_msg_t slots[APU_RING_SLOTS];
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+    unsigned capacity;
+} apu_ring_t;
+
+typedef enum {
+    ENV_OFF,
+    ENV_ATTACK,
+    ENV_DECAY,
+    ENV_SUSTAIN,
+    ENV_RELEASE
+} env_stage_t;
+
+typedef struct {
+    uint8_t wave;            // Pulse duty index or noise mode
+    uint8_t volume;
+    int32_t attack_step;     // Envelope change per sample
+    int32_t decay_step;
+    int32_t release_step;
+    int32_t sustain;
+    env_stage_t stage;
+    int32_t env;
+    int32_t gain;            // Amplitude at full envelope for the current note
+    uint32_t phase;          // Oscillator phase (pulse, triangle) or noise clock (16.16)
+    uint32_t phase_inc;
+    uint16_t lfsr;
+    const int8_t *pcm;       // Sample channel: PCM inside the playing song
+    uint32_t pcm_len;
+    uint32_t pcm_loop;
+    uint16_t pcm_rate;
+    uint64_t pcm_pos;        // 16.16 sample position
+} apu_channel_t;
+
+// One app's player (audio thread)
+typedef struct {
+    apu_channel_t channels[FMRB_APU_CH_COUNT];
+    apu_song_t *song;
+    size_t pos;
+    size_t loop_pos;
+    int waited_since_mark;   // A LOOP without a WAIT since its mark would spin forever
+    uint64_t wait_fx;        // Samples until the next event (16.16)
+    uint64_t tick_fx;        // Samples per tick (16.16)
+    int paused;
+} apu_player_t;
+
+static const uint32_t pulse_duty[4] = { 0x20000000u, 0x40000000u, 0x80000000u, 0xC0000000u };
+
+static int g_sample_rate = FMRB_AUDIO_SAMPLE_RATE;
+static float g_note_hz[128];
+
+// Control thread state
+static apu_song_t *g_tracks[FMRB_AUDIO_MAX_APPS][FMRB_MAX_MUSIC_TRACKS];
+static apu_ring_t g_cmd_ring;        // Control -> audio
+static apu_ring_t g_release_ring;    // Audio -> control
+static SDL_atomic_t g_status[FMRB_AUDIO_MAX_APPS];
+
+// Audio thread state
+static apu_player_t g_players[FMRB_AUDIO_MAX_APPS];
+
+static int ring_push(apu_ring_t *ring, const apu_msg_t *msg) {
+    unsigned tail = (unsigned)SDL_AtomicGet(&ring->tail);
+    if (tail - (unsigned)SDL_AtomicGet(&ring->head) >= ring->capacity) {
+        return -1;
+    }
+    ring->slots[tail % APU_RING_SLOTS] = *msg;
+    SDL_AtomicSet(&ring->tail, (int)(tail + 1));
+    return 0;
+}
+
+static int ring_pop(apu_ring_t *ring, apu_msg_t *msg) {
+    unsigned head = (unsigned)SDL_AtomicGet(&ring->head);
+    if (head == (unsigned)SDL_AtomicGet(&ring->tail)) {
+        return 0;
+    }
+    *msg = ring->slots[head % APU_RING_SLOTS];
+    SDL_AtomicSet(&ring->head, (int)(head + 1));
+    return 1;
+}
+
+static void ring_reset(apu_ring_t *ring, unsigned capacity) {
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+    ring->capacity = capacity;
+}
+
+static void song_unref(apu_song_t *song) {
+    if (song && SDL_AtomicDecRef(&song->refs)) {
+        free(song);
+    }
+}
+
+// Free songs the audio thread has let go of (control thread)
+static void collect_released(void) {
+    apu_msg_t msg;
+    while (ring_pop(&g_release_ring, &msg)) {
+        song_unref(msg.song);
+    }
+}
+
+static int post(uint8_t type, int app, apu_song_t *song) {
+    collect_released();
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS) {
+        return -1;
+    }
+    apu_msg_t msg = { type, (uint8_t)app, song };
+    if (ring_push(&g_cmd_ring, &msg) < 0) {
+        fprintf(stderr, "APU command queue full\n");
+        return -1;
+    }
+    return 0;
+}
+
+// ---- Audio thread ----
+
+static int32_t env_step(int units) {
+    int32_t samples = units * APU_ENV_UNIT_MS * g_sample_rate / 1000;
+    return samples > 0 ? APU_ENV_MAX / samples : APU_ENV_MAX;
+}
+
+static void channel_set_instrument(apu_channel_t *ch, uint8_t wave, uint8_t a, uint8_t d, uint8_t s, uint8_t r) {
+    ch->wave = wave;
+    ch->attack_step = env_step(a);
+    ch->decay_step = env_step(d);
+    ch->sustain = s * APU_ENV_MAX / 255;
+    ch->release_step = env_step(r);
+}
+
+static void channels_reset(apu_player_t *p) {
+    for (int i = 0; i < FMRB_APU_CH_COUNT; i++) {
+        apu_channel_t *ch = &p->channels[i];
+        memset(ch, 0, sizeof(*ch));
+        ch->volume = 255;
+        ch->lfsr = 1;
+        ch->pcm_loop = APU_NO_LOOP;
+        channel_set_instrument(ch, 2, 0, 0, 255, 25);
+    }
+}
+
+static void channel_note_on(apu_player_t *p, int index, uint8_t note, uint8_t velocity) {
+    apu_channel_t *ch = &p->channels[index];
+    note &= 0x7F;
+    ch->gain = APU_CHANNEL_AMPLITUDE * (velocity & 0x7F) / 127 * ch->volume / 255;
+    ch->stage = ENV_ATTACK;   // From the current level, so a retrigger does not click
+
+    switch (index) {
+        case FMRB_APU_CH_NOISE: {
+            double inc = g_note_hz[note] * 8.0 * 65536.0 / g_sample_rate;
+            ch->phase_inc = inc > APU_NOISE_MAX_INC ? APU_NOISE_MAX_INC : (uint32_t)inc;
+            break;
+        }
+        case FMRB_APU_CH_SAMPLE:
+            if (!ch->pcm) {
+                ch->stage = ENV_OFF;
+                break;
+            }
+            ch->pcm_pos = 0;
+            ch->phase_inc = (uint32_t)(ch->pcm_rate * (g_note_hz[note] / g_note_hz[60]) * 65536.0 / g_sample_rate);
+            break;
+        default:
+            ch->phase_inc = (uint32_t)(g_note_hz[note] * 4294967296.0 / g_sample_rate);
+            break;
+    }
+}
+
+static void channel_note_off(apu_channel_t *ch) {
+    if (ch->stage != ENV_OFF) {
+        ch->stage = ENV_RELEASE;
+    }
+}
+
+// Advance the envelope one sample; returns the level
+static inline int32_t channel_env(apu_channel_t *ch) {
+    switch (ch->stage) {
+        case ENV_ATTACK:
+            ch->env += ch->attack_step;
+            if (ch->env >= APU_ENV_MAX) {
+                ch->env = APU_ENV_MAX;
+                ch->stage = ENV_DECAY;
+            }
+            break;
+        case ENV_DECAY:
+            ch->env -= ch->decay_step;
+            if (ch->env <= ch->sustain) {
+                ch->env = ch->sustain;
+                ch->stage = ch->sustain > 0 ? ENV_SUSTAIN : ENV_OFF;
+            }
+            break;
+        case ENV_RELEASE:
+            ch->env -= ch->release_step;
+            if (ch->env <= 0) {
+                ch->env = 0;
+                ch->stage = ENV_OFF;
+            }
+            break;
+        default:
+            break;
+    }
+    return ch->env;
+}
+
+static void channel_render(apu_player_t *p, int index, int32_t *mix, int frames) {
+    apu_channel_t *ch = &p->channels[index];
+    const int32_t gain = ch->gain;
+
+    for (int i = 0; i < frames && ch->stage != ENV_OFF; i++) {
+        const int32_t amp = gain * channel_env(ch) >> 15;
+        int32_t v;
+        switch (index) {
+            case FMRB_APU_CH_PULSE1:
+            case FMRB_APU_CH_PULSE2:
+                v = ch->phase < pulse_duty[ch->wave & 3] ? amp : -amp;
+                ch->phase += ch->phase_inc;
+                break;
+            case FMRB_APU_CH_TRIANGLE: {
+                // 32-step triangle, as on the chips this imitates
+                int step = ch->phase >> 27;
+                int level = step < 16 ? step : 31 - step;
+                v = amp * (level * 2 - 15) / 15;
+                ch->phase += ch->phase_inc;
+                break;
+            }
+            case FMRB_APU_CH_NOISE:
+                ch->phase += ch->phase_inc;
+                while (ch->phase >= 0x10000) {
+                    ch->phase -= 0x10000;
+                    uint16_t bit = (ch->lfsr ^ (ch->lfsr >> (ch->wave ? 6 : 1))) & 1;
+                    ch->lfsr = (uint16_t)((ch->lfsr >> 1) | (bit << 14));
+                }
+                v = (ch->lfsr & 1) ? -amp : amp;
+                break;
+            default: {
+                uint32_t idx = (uint32_t)(ch->pcm_pos >> 16);
+                if (idx >= ch->pcm_len) {
+                    if (ch->pcm_loop >= ch->pcm_len) {
+                        ch->stage = ENV_OFF;
+                        continue;
+                    }
+                    // Modulo: at high notes one step can be longer than a short loop
+                    const uint64_t end = (uint64_t)ch->pcm_len << 16;
+                    const uint64_t loop_len = (uint64_t)(ch->pcm_len - ch->pcm_loop) << 16;
+                    ch->pcm_pos = ((uint64_t)ch->pcm_loop << 16) + (ch->pcm_pos - end) % loop_len;
+                    idx = (uint32_t)(ch->pcm_pos >> 16);
+                    if (idx >= ch->pcm_len) {
+                        ch->stage = ENV_OFF;
+                        continue;
+                    }
+                }
+                v = amp * ch->pcm[idx] / 128;
+                ch->pcm_pos += ch->phase_inc;
+                break;
+            }
+        }
+        mix[i] += v;
+    }
+}
+
+static void song_release(apu_player_t *p) {
+    if (p->song) {
+        apu_msg_t msg = { APU_MSG_RELEASE, 0, p->song };
+        ring_push(&g_release_ring, &msg);  // Sized for every PLAY in flight plus each current song
+        p->song = NULL;
+    }
+    for (int i = 0; i < FMRB_APU_CH_COUNT; i++) {
+        p->channels[i].pcm = NULL;  // Points into the released song
+    }
+}
+
+// End of the event stream: let the notes ring out
+static void song_finished(apu_player_t *p) {
+    for (int i = 0; i < FMRB_APU_CH_COUNT; i++) {
+        if (i == FMRB_APU_CH_SAMPLE) {
+            p->channels[i].stage = ENV_OFF;
+        } else {
+            channel_note_off(&p->channels[i]);
+        }
+    }
+    song_release(p);
+    SDL_AtomicSet(&g_status[p - g_players], FMRB_AUDIO_STATUS_STOPPED);
+}
+
+static inline uint16_t read_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t read_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Execute events until the next wait (song data is untrusted: every read is bounds checked)
+static void run_events(apu_player_t *p) {
+    while (p->song && p->wait_fx < (1 << 16)) {
+        const uint8_t *data = p->song->data;
+        const size_t size = p->song->size;
+        if (p->pos >= size) {
+            song_finished(p);
+            return;
+        }
+
+        const uint8_t op = data[p->pos++];
+        if (op < 0x80) {
+            p->wait_fx += (uint64_t)(op + 1) * p->tick_fx;
+            p->waited_since_mark = 1;
+            continue;
+        }
+
+        const int ch = op & 0x0F;
+        const size_t left = size - p->pos;
+        switch (op & 0xF0) {
+            case FMRB_APU_OP_NOTE_ON:
+                if (ch >= FMRB_APU_CH_COUNT || left < 2) {
+                    song_finished(p);
+                    return;
+                }
+                channel_note_on(p, ch, data[p->pos], data[p->pos + 1]);
+                p->pos += 2;
+                break;
+            case FMRB_APU_OP_NOTE_OFF:
+                if (ch >= FMRB_APU_CH_COUNT) {
+                    song_finished(p);
+                    return;
+                }
+                channel_note_off(&p->channels[ch]);
+                break;
+            case FMRB_APU_OP_INSTR:
+                if (ch >= FMRB_APU_CH_COUNT || left < 5) {
+                    song_finished(p);
+                    return;
+                }
+                channel_set_instrument(&p->channels[ch], data[p->pos], data[p->pos + 1], data[p->pos + 2],
+                                       data[p->pos + 3], data[p->pos + 4]);
+                p->pos += 5;
+                break;
+            case FMRB_APU_OP_VOLUME:
+                if (ch >= FMRB_APU_CH_COUNT || left < 1) {
+                    song_finished(p);
+                    return;
+                }
+                p->channels[ch].volume = data[p->pos++];
+                break;
+            default:
+                if (op == FMRB_APU_OP_WAIT_LONG && left >= 2) {
+                    p->wait_fx += (uint64_t)read_u16(&data[p->pos]) * p->tick_fx;
+                    p->waited_since_mark = 1;
+                    p->pos += 2;
+                } else if (op == FMRB_APU_OP_SAMPLE && left >= 10) {
+                    apu_channel_t *sample = &p->channels[FMRB_APU_CH_SAMPLE];
+                    uint32_t len = read_u32(&data[p->pos + 2]);
+                    if (len > left - 10) {
+                        song_finished(p);
+                        return;
+                    }
+                    sample->stage = ENV_OFF;
+                    sample->pcm_rate = read_u16(&data[p->pos]);
+                    sample->pcm_loop = read_u32(&data[p->pos + 6]);
+                    sample->pcm_len = len;
+                    sample->pcm = (const int8_t *)&data[p->pos + 10];
+                    p->pos += 10 + len;
+                } else if (op == FMRB_APU_OP_LOOP_MARK) {
+                    p->loop_pos = p->pos;
+                    p->waited_since_mark = 0;
+                } else if (op == FMRB_APU_OP_LOOP && p->waited_since_mark) {
+                    p->pos = p->loop_pos;
+                    p->waited_since_mark = 0;
+                } else {
+                    song_finished(p);  // END, a truncated event or a loop that never waits
+                    return;
+                }
+                break;
+        }
+    }
+}
+
+static void process_messages(void) {
+    apu_msg_t msg;
+    while (ring_pop(&g_cmd_ring, &msg)) {
+        apu_player_t *p = &g_players[msg.app];
+        switch (msg.type) {
+            case APU_MSG_PLAY:
+                song_release(p);
+                channels_reset(p);
+                p->song = msg.song;
+                p->pos = FMRB_APU_HEADER_SIZE;
+                p->loop_pos = p->pos;
+                p->waited_since_mark = 0;
+                p->wait_fx = 0;
+                p->tick_fx = ((uint64_t)g_sample_rate << 16) / p->song->tick_hz;
+                p->paused = 0;
+                SDL_AtomicSet(&g_status[msg.app], FMRB_AUDIO_STATUS_PLAYING);
+                break;
+            case APU_MSG_STOP:
+                song_release(p);
+                channels_reset(p);
+                p->paused = 0;
+                SDL_AtomicSet(&g_status[msg.app], FMRB_AUDIO_STATUS_STOPPED);
+                break;
+            case APU_MSG_PAUSE:
+                if (p->song) {
+                    p->paused = 1;
+                    SDL_AtomicSet(&g_status[msg.app], FMRB_AUDIO_STATUS_PAUSED);
+                }
+                break;
+            case APU_MSG_RESUME:
+                if (p->song && p->paused) {
+                    p->paused = 0;
+                    SDL_AtomicSet(&g_status[msg.app], FMRB_AUDIO_STATUS_PLAYING);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void apu_synth_update(void) {
+    process_messages();
+}
+
+int apu_synth_render(int app, int16_t *out, int frames) {
+    int32_t mix[APU_BLOCK_FRAMES];
+
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS) {
+        return 0;
+    }
+    apu_player_t *p = &g_players[app];
+    if (p->paused) {
+        return 0;
+    }
+    int active = p->song != NULL;
+    for (int i = 0; i < FMRB_APU_CH_COUNT && !active; i++) {
+        active = p->channels[i].stage != ENV_OFF;
+    }
+    if (!active) {
+        return 0;
+    }
+
+    while (frames > 0) {
+        int n = frames < APU_BLOCK_FRAMES ? frames : APU_BLOCK_FRAMES;
+        if (p->song) {
+            run_events(p);
+            // Stop the block at the next event so note timing is sample accurate
+            if (p->song && (p->wait_fx >> 16) < (uint64_t)n) {
+                n = (int)(p->wait_fx >> 16);
+            }
+        }
+
+        memset(mix, 0, sizeof(int32_t) * n);
+        for (int i = 0; i < FMRB_APU_CH_COUNT; i++) {
+            if (p->channels[i].stage != ENV_OFF) {
+                channel_render(p, i, mix, n);
+            }
+        }
+        if (p->song) {
+            p->wait_fx -= (uint64_t)n << 16;
+        }
+
+        for (int i = 0; i < n; i++) {
+            int32_t v = mix[i];
+            if (v > INT16_MAX) {
+                v = INT16_MAX;
+            } else if (v < INT16_MIN) {
+                v = INT16_MIN;
+            }
+            out[i * 2] = (int16_t)v;
+            out[i * 2 + 1] = (int16_t)v;
+        }
+        out += n * 2;
+        frames -= n;
+    }
+    return 1;
+}
+
+// ---- Control thread ----
+
+int apu_synth_init(int sample_rate) {
+    if (sample_rate <= 0) {
+        return -1;
+    }
+    g_sample_rate = sample_rate;
+    for (int n = 0; n < 128; n++) {
+        g_note_hz[n] = 440.0f * powf(2.0f, (n - 69) / 12.0f);
+    }
+
+    memset(g_tracks, 0, sizeof(g_tracks));
+    ring_reset(&g_cmd_ring, APU_QUEUE_SIZE);
+    ring_reset(&g_release_ring, APU_RING_SLOTS);
+
+    for (int app = 0; app < FMRB_AUDIO_MAX_APPS; app++) {
+        apu_player_t *p = &g_players[app];
+        channels_reset(p);
+        p->song = NULL;
+        p->paused = 0;
+        SDL_AtomicSet(&g_status[app], FMRB_AUDIO_STATUS_STOPPED);
+    }
+    return 0;
+}
+
+void apu_synth_cleanup(void) {
+    apu_msg_t msg;
+
+    // Nothing renders any more, so the audio thread's state can be torn down from here
+    while (ring_pop(&g_cmd_ring, &msg)) {
+        if (msg.type == APU_MSG_PLAY) {
+            song_unref(msg.song);
+        }
+    }
+    for (int app = 0; app < FMRB_AUDIO_MAX_APPS; app++) {
+        song_release(&g_players[app]);
+        SDL_AtomicSet(&g_status[app], FMRB_AUDIO_STATUS_STOPPED);
+    }
+    collect_released();
+
+    for (int app = 0; app < FMRB_AUDIO_MAX_APPS; app++) {
+        for (int i = 0; i < FMRB_MAX_MUSIC_TRACKS; i++) {
+            song_unref(g_tracks[app][i]);
+            g_tracks[app][i] = NULL;
+        }
+    }
+}
+
+static int find_track(int app, uint32_t music_id) {
+    for (int i = 0; i < FMRB_MAX_MUSIC_TRACKS; i++) {
+        if (g_tracks[app][i] && g_tracks[app][i]->music_id == music_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int apu_synth_load(int app, uint32_t music_id, const uint8_t *data, size_t size) {
+    collect_released();
+
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS) {
+        return -1;
+    }
+    if (size < FMRB_APU_HEADER_SIZE || memcmp(data, "FAPU", 4) != 0) {
+        fprintf(stderr, "Music track %u is not an APU binary\n", music_id);
+        return -1;
+    }
+    if (data[4] != FMRB_APU_FORMAT_VERSION || read_u16(&data[6]) == 0) {
+        fprintf(stderr, "Music track %u: unsupported version %u or tick rate\n", music_id, data[4]);
+        return -1;
+    }
+
+    int slot = find_track(app, music_id);
+    if (slot < 0) {
+        for (int i = 0; i < FMRB_MAX_MUSIC_TRACKS; i++) {
+            if (!g_tracks[app][i]) {
+                slot = i;
+                break;
+            }
+        }
+    }
+    if (slot < 0) {
+        fprintf(stderr, "Maximum music tracks reached\n");
+        return -1;
+    }
+
+    apu_song_t *song = (apu_song_t *)malloc(sizeof(apu_song_t) + size);
+    if (!song) {
+        fprintf(stderr, "Failed to allocate music data\n");
+        return -1;
+    }
+    SDL_AtomicSet(&song->refs, 1);
+    song->music_id = music_id;
+    song->tick_hz = read_u16(&data[6]);
+    song->size = size;
+    memcpy(song->data, data, size);
+
+    // A copy that is playing stays alive until the audio thread lets go of it
+    song_unref(g_tracks[app][slot]);
+    g_tracks[app][slot] = song;
+    return 0;
+}
+
+int apu_synth_play(int app, uint32_t music_id) {
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS) {
+        return -1;
+    }
+    int slot = find_track(app, music_id);
+    if (slot < 0) {
+        fprintf(stderr, "Music track %u not found for app %d\n", music_id, app);
+        return -1;
+    }
+
+    apu_song_t *song = g_tracks[app][slot];
+    SDL_AtomicIncRef(&song->refs);
+    if (post(APU_MSG_PLAY, app, song) < 0) {
+        song_unref(song);
+        return -1;
+    }
+    return 0;
+}
+
+int apu_synth_stop(int app) {
+    return post(APU_MSG_STOP, app, NULL);
+}
+
+int apu_synth_pause(int app) {
+    return post(APU_MSG_PAUSE, app, NULL);
+}
+
+int apu_synth_resume(int app) {
+    return post(APU_MSG_RESUME, app, NULL);
+}
+
+fmrb_audio_status_t apu_synth_get_status(int app) {
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS) {
+        return FMRB_AUDIO_STATUS_ERROR;
+    }
+    return (fmrb_audio_status_t)SDL_AtomicGet(&g_status[app]);
+}
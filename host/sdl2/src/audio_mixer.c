@@ -0,0 +1,127 @@
+#include "audio_mixer.h"
+#include "apu_synth.h"
+#include "pcm_stream.h"
+#include "sfx_bank.h"
+#include <SDL2/SDL.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#define MIX_HAVE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MIX_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define MIX_CHUNK_FRAMES 256     // Apps are rendered and mixed in chunks of this many frames
+#define MIX_RAMP_FRAMES 16       // While ramping, the gain steps once per this many frames
+#define MIX_GAIN_UNITY 32767     // Q15
+
+// Control thread -> audio thread
+static SDL_atomic_t g_volume[FMRB_AUDIO_MAX_APPS];
+static SDL_atomic_t g_focus;
+
+// Audio thread: gain each app is currently mixed at (Q15)
+static int32_t g_gain[FMRB_AUDIO_MAX_APPS];
+static int32_t g_ramp_step = MIX_GAIN_UNITY;
+
+// dst += src * gain (Q15), saturating
+static void mix_add_s16(int16_t *dst, const int16_t *src, size_t count, int16_t gain) {
+    size_t i = 0;
+#if defined(MIX_HAVE_SSE2)
+    const __m128i g = _mm_set1_epi16(gain);
+    for (; i + 8 <= count; i += 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i lo = _mm_mullo_epi16(s, g);
+        __m128i hi = _mm_mulhi_epi16(s, g);
+        __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+        __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_adds_epi16(d, _mm_packs_epi32(p0, p1)));
+    }
+#elif defined(MIX_HAVE_NEON)
+    for (; i + 8 <= count; i += 8) {
+        // Doubling multiply-high: (2 * s * gain) >> 16 == (s * gain) >> 15
+        int16x8_t s = vqdmulhq_n_s16(vld1q_s16(src + i), gain);
+        vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), s));
+    }
+#endif
+    for (; i < count; i++) {
+        int32_t v = dst[i] + (src[i] * gain >> 15);
+        dst[i] = (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+    }
+}
+
+static int32_t target_gain(int app, int focus) {
+    int32_t gain = SDL_AtomicGet(&g_volume[app]) * MIX_GAIN_UNITY / 255;
+    if (focus != FMRB_AUDIO_NO_FOCUS && focus != app) {
+        gain = gain * AUDIO_MIXER_DUCK_PERCENT / 100;
+    }
+    return gain;
+}
+
+// Mix one chunk, moving the app's gain toward target in small steps
+static void mix_app(int app, int16_t *dst, const int16_t *src, int frames, int32_t target) {
+    int32_t gain = g_gain[app];
+    while (frames > 0 && gain != target) {
+        gain = gain < target ? SDL_min(gain + g_ramp_step, target) : SDL_max(gain - g_ramp_step, target);
+        int n = SDL_min(frames, MIX_RAMP_FRAMES);
+        mix_add_s16(dst, src, (size_t)n * 2, (int16_t)gain);
+        dst += n * 2;
+        src += n * 2;
+        frames -= n;
+    }
+    if (frames > 0) {
+        mix_add_s16(dst, src, (size_t)frames * 2, (int16_t)gain);
+    }
+    g_gain[app] = gain;
+}
+
+void audio_mixer_init(int sample_rate) {
+    for (int app = 0; app < FMRB_AUDIO_MAX_APPS; app++) {
+        SDL_AtomicSet(&g_volume[app], AUDIO_MIXER_DEFAULT_VOLUME);
+        g_gain[app] = AUDIO_MIXER_DEFAULT_VOLUME * MIX_GAIN_UNITY / 255;
+    }
+    SDL_AtomicSet(&g_focus, FMRB_AUDIO_NO_FOCUS);
+
+    const int ramp_frames = sample_rate * AUDIO_MIXER_RAMP_MS / 1000;
+    g_ramp_step = ramp_frames > MIX_RAMP_FRAMES ? MIX_GAIN_UNITY * MIX_RAMP_FRAMES / ramp_frames : MIX_GAIN_UNITY;
+}
+
+int audio_mixer_set_volume(int app, uint8_t volume) {
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS) {
+        return -1;
+    }
+    SDL_AtomicSet(&g_volume[app], volume);
+    return 0;
+}
+
+void audio_mixer_set_focus(uint8_t app) {
+    SDL_AtomicSet(&g_focus, app);
+}
+
+void audio_mixer_render(int16_t *out, int frames) {
+    int16_t chunk[MIX_CHUNK_FRAMES * 2];
+
+    memset(out, 0, sizeof(int16_t) * 2 * frames);
+    apu_synth_update();
+    sfx_bank_update();
+
+    const int focus = SDL_AtomicGet(&g_focus);
+    for (int app = 0; app < FMRB_AUDIO_MAX_APPS; app++) {
+        const int32_t target = target_gain(app, focus);
+        for (int done = 0; done < frames;) {
+            int n = SDL_min(frames - done, MIX_CHUNK_FRAMES);
+            int audible = apu_synth_render(app, chunk, n);
+            if (!sfx_bank_render(app, chunk, n, audible)) {
+                // Silent: nothing to ramp, so a later sound starts at the right level
+                g_gain[app] = target;
+                break;
+            }
+            mix_app(app, out + done * 2, chunk, n, target);
+            done += n;
+        }
+    }
+
+    pcm_stream_mix(out, frames);
+}
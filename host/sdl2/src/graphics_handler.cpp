@@ -7,6 +7,8 @@
 
 extern "C" {
 #include "graphics_handler.h"
+#include "input_handler.h"
+#include "pixel_kernels.h"
 #include "fmrb_link_protocol.h"
 #include "fmrb_gfx.h"
 }
@@ -27,8 +29,27 @@ extern "C" void graphics_handler_set_log_level(int level) {
     }
 }
 
-// External reference to LGFX instance created in main.cpp
-extern LGFX* g_lgfx;
+// Display created by the host main (SDL window in main.cpp, framebuffer in main_headless.cpp)
+extern LovyanGFX* g_lgfx;
+
+// Tile layer state (sheet and map are kept on the host, see FMRB_LINK_GFX_TILEMAP_*)
+typedef struct {
+    bool active;
+    uint8_t tile_w, tile_h;
+    uint16_t map_w, map_h;         // Map size in cells
+    uint8_t* map;                  // map_w * map_h tile indices
+    uint16_t sheet_w, sheet_h;     // Sheet size in pixels
+    uint8_t* sheet;                // RGB332 pixels, nullptr until uploaded
+    int16_t scroll_x, scroll_y;
+} tile_layer_t;
+
+// Display list recorded with FMRB_LINK_GFX_DEFINE_LIST
+typedef struct {
+    uint8_t* data;                 // Items (list_item_t + payload), nullptr when the id is unused
+    uint16_t len;
+    uint8_t slot_count;
+    uint8_t slot_colors[FMRB_LINK_GFX_LIST_MAX_SLOTS];
+} display_list_t;
 
 // Canvas state structure
 typedef struct {
@@ -40,98 +61,511 @@ typedef struct {
     int16_t z_order;               // Z-order (0=bottom, higher=front, SystemApp=0 fixed)
     int16_t push_x, push_y;        // Position to push to screen
     bool is_visible;               // Visibility flag
-    uint16_t width, height;        // Canvas allocated dimensions (always max screen size)
+    size_t buffer_size;            // Bytes in each of the two buffers (a pool size class)
     uint16_t active_width, active_height;  // Active drawing area (can be resized)
-    bool dirty;                    // Redraw flag
+    bool dirty;                    // Needs compositing (presented, placement, palette or decoration changed)
+    bool shown;                    // Composited on screen at shown_x/y/w/h
+    int16_t shown_x, shown_y;
+    uint16_t shown_w, shown_h;
+    tile_layer_t tile_layers[FMRB_LINK_GFX_MAX_TILE_LAYERS];  // Composited under draw_buffer
+    uint8_t tile_key;              // Transparent color for upper layers and draw_buffer (0xFF = none)
+    uint8_t* palette;              // Indexed mode: 256 RGB332 entries applied at composite, else nullptr
+    display_list_t lists[FMRB_LINK_GFX_MAX_LISTS];
+    uint8_t frame_style;           // FMRB_LINK_GFX_FRAME_*, drawn over the canvas edges at composite
+    uint8_t frame_flags;
+    char title[FMRB_LINK_GFX_FRAME_TITLE_MAX + 1];
 } canvas_state_t;
 
-// Maximum number of canvases
-#define MAX_CANVAS_COUNT 16
-
-// Screen dimensions for canvas allocation
+// Largest canvas (the screen size)
 #define MAX_SCREEN_WIDTH 480
 #define MAX_SCREEN_HEIGHT 320
 
 // Canvas management
-static canvas_state_t g_canvases[MAX_CANVAS_COUNT];
+// Each canvas is allocated on its own and never moves; g_canvas_slots is indexed by canvas ID.
+// IDs of deleted canvases are handed out again, so the table only grows to the most canvases
+// alive at once.
+// g_zorder lists the live canvases back to front and is only updated on create, delete and
+// SET_WINDOW_ORDER, so neither command dispatch nor compositing has to search or sort.
+static canvas_state_t** g_canvas_slots = nullptr;
+static size_t g_canvas_slot_count = 0;
+static canvas_state_t** g_zorder = nullptr;
 static size_t g_canvas_count = 0;
+static size_t g_canvas_capacity = 0;   // Entries in g_zorder and g_rect_layers
+
+// Shown canvases touching the damaged rectangle being rebuilt, back to front
+static const canvas_state_t** g_rect_layers = nullptr;
+
+// Canvas pixel buffers come from a size-classed pool: a canvas gets the smallest class that
+// holds its active area, and freed buffers are kept per class for the next canvas.
+static const size_t g_pool_classes[] = {
+    4096, 6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536, 98304, 131072,
+    MAX_SCREEN_WIDTH * MAX_SCREEN_HEIGHT
+};
+#define POOL_CLASS_COUNT (sizeof(g_pool_classes) / sizeof(g_pool_classes[0]))
+#define POOL_KEEP_PER_CLASS 2      // Freed buffers cached per class; more are returned to the heap
+
+static void* g_pool_free[POOL_CLASS_COUNT][POOL_KEEP_PER_CLASS];
+static int g_pool_free_count[POOL_CLASS_COUNT];
+static size_t g_pool_in_use = 0;   // Bytes held by canvases
+static size_t g_pool_cached = 0;   // Bytes waiting in the free lists
+static size_t g_pool_peak = 0;     // Highest in_use + cached so far
 
 // Cursor management
+// The cursor follows the host's own pointer input (input_handler); the core only warps it,
+// toggles visibility and picks the shape.
 static LGFX_Sprite* g_cursor_sprite = nullptr;
 static bool g_cursor_visible = true;
 static int g_cursor_x = 240;  // Default: screen center
 static int g_cursor_y = 135;
+static uint8_t g_cursor_shape = FMRB_LINK_GFX_CURSOR_ARROW;
+static uint64_t g_cursor_stamp = 0;   // Motion stamp of the position last taken from input_handler
 static const uint32_t CURSOR_TRANSPARENT_COLOR = 0xFF00FF;  // Magenta
 
-// 8x8 arrow cursor pattern (0=transparent, 1=white outline, 2=black body)
-static const uint8_t cursor_pattern[8][8] = {
-    {1, 0, 0, 0, 0, 0, 0, 0},
-    {1, 1, 0, 0, 0, 0, 0, 0},
-    {1, 2, 1, 0, 0, 0, 0, 0},
-    {1, 2, 2, 1, 0, 0, 0, 0},
-    {1, 2, 2, 2, 1, 0, 0, 0},
-    {1, 2, 2, 2, 2, 1, 0, 0},
-    {1, 2, 2, 2, 2, 2, 1, 0},
-    {1, 1, 1, 1, 1, 1, 1, 1},
+// 8x8 cursor patterns (0=transparent, 1=white outline, 2=black body) and hot spots
+static const uint8_t cursor_patterns[FMRB_LINK_GFX_CURSOR_SHAPES][8][8] = {
+    {   // Arrow
+        {1, 0, 0, 0, 0, 0, 0, 0},
+        {1, 1, 0, 0, 0, 0, 0, 0},
+        {1, 2, 1, 0, 0, 0, 0, 0},
+        {1, 2, 2, 1, 0, 0, 0, 0},
+        {1, 2, 2, 2, 1, 0, 0, 0},
+        {1, 2, 2, 2, 2, 1, 0, 0},
+        {1, 2, 2, 2, 2, 2, 1, 0},
+        {1, 1, 1, 1, 1, 1, 1, 1},
+    },
+    {   // Move
+        {0, 0, 0, 1, 1, 0, 0, 0},
+        {0, 0, 1, 2, 2, 1, 0, 0},
+        {0, 1, 1, 2, 2, 1, 1, 0},
+        {1, 2, 2, 2, 2, 2, 2, 1},
+        {1, 2, 2, 2, 2, 2, 2, 1},
+        {0, 1, 1, 2, 2, 1, 1, 0},
+        {0, 0, 1, 2, 2, 1, 0, 0},
+        {0, 0, 0, 1, 1, 0, 0, 0},
+    },
+    {   // Resize (diagonal)
+        {1, 1, 1, 1, 0, 0, 0, 0},
+        {1, 2, 2, 1, 0, 0, 0, 0},
+        {1, 2, 2, 1, 0, 0, 0, 0},
+        {1, 1, 1, 2, 1, 0, 0, 0},
+        {0, 0, 0, 1, 2, 1, 1, 1},
+        {0, 0, 0, 0, 1, 2, 2, 1},
+        {0, 0, 0, 0, 1, 2, 2, 1},
+        {0, 0, 0, 0, 1, 1, 1, 1},
+    },
+};
+static const int8_t cursor_hot_spots[FMRB_LINK_GFX_CURSOR_SHAPES][2] = {
+    {0, 0}, {4, 4}, {4, 4}
 };
 
-// Screen double buffer for compositing all canvases
+// Cursor latency: time from the SDL motion event to the frame that first shows the position
+typedef struct {
+    uint32_t count;
+    double total_ms;
+    double max_ms;
+} cursor_latency_t;
+
+#define CURSOR_LATENCY_REPORT 120   // Samples per log line
+
+static cursor_latency_t g_latency_local;   // Host-local tracking
+static cursor_latency_t g_latency_core;    // Positions echoed back by the core (FMRB_HOST_CURSOR_ECHO)
+static uint64_t g_local_pending = 0;       // Motion stamps waiting for the next frame, 0 = none
+static uint64_t g_core_pending = 0;
+
+// Screen buffer all canvases are composited into; only damaged rectangles are rebuilt
+typedef struct {
+    int16_t x0, y0, x1, y1;        // Half-open: [x0, x1) x [y0, y1)
+} screen_rect_t;
+
+#define MAX_DAMAGE_RECTS 8
+
+static LGFX_Sprite* g_screen = nullptr;
+static void* g_screen_mem = nullptr;
+static screen_rect_t g_damage[MAX_DAMAGE_RECTS];
+static int g_damage_count = 0;
+static bool g_cursor_changed = true;      // Cursor shape or visibility changed since the last frame
+static bool g_cursor_shown = false;       // Cursor drawn at g_cursor_shown_x/y in the last frame
+static int g_cursor_shown_x = 0;
+static int g_cursor_shown_y = 0;
+
 static uint16_t g_current_target = FMRB_CANVAS_SCREEN;  // 0=screen, other=canvas
 static bool g_graphics_initialized = false;  // Flag to prevent multiple initializations
 
+// Add a screen rectangle to the damage list, clipped to the screen.
+// Overlapping rectangles are merged; when the list is full the one that grows least absorbs it.
+static void damage_add(int x, int y, int w, int h) {
+    if (!g_screen) {
+        return;
+    }
+    int x1 = x + w;
+    int y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > g_screen->width()) x1 = g_screen->width();
+    if (y1 > g_screen->height()) y1 = g_screen->height();
+    if (x >= x1 || y >= y1) {
+        return;
+    }
+
+    screen_rect_t r = { (int16_t)x, (int16_t)y, (int16_t)x1, (int16_t)y1 };
+    for (int i = 0; i < g_damage_count; ) {
+        const screen_rect_t* d = &g_damage[i];
+        if (r.x0 <= d->x1 && d->x0 <= r.x1 && r.y0 <= d->y1 && d->y0 <= r.y1) {
+            // Absorb and re-scan, since the grown rectangle may now touch earlier ones
+            if (d->x0 < r.x0) r.x0 = d->x0;
+            if (d->y0 < r.y0) r.y0 = d->y0;
+            if (d->x1 > r.x1) r.x1 = d->x1;
+            if (d->y1 > r.y1) r.y1 = d->y1;
+            g_damage[i] = g_damage[--g_damage_count];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+
+    if (g_damage_count < MAX_DAMAGE_RECTS) {
+        g_damage[g_damage_count++] = r;
+        return;
+    }
+
+    int best = 0;
+    long best_growth = -1;
+    for (int i = 0; i < g_damage_count; i++) {
+        const screen_rect_t* d = &g_damage[i];
+        long ux = (d->x1 > r.x1 ? d->x1 : r.x1) - (d->x0 < r.x0 ? d->x0 : r.x0);
+        long uy = (d->y1 > r.y1 ? d->y1 : r.y1) - (d->y0 < r.y0 ? d->y0 : r.y0);
+        long growth = ux * uy - (long)(d->x1 - d->x0) * (d->y1 - d->y0);
+        if (best_growth < 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    screen_rect_t* d = &g_damage[best];
+    if (r.x0 < d->x0) d->x0 = r.x0;
+    if (r.y0 < d->y0) d->y0 = r.y0;
+    if (r.x1 > d->x1) d->x1 = r.x1;
+    if (r.y1 > d->y1) d->y1 = r.y1;
+}
+
+// Row-band worker pool: screen composition and large canvas fills and blits are split into
+// horizontal bands run in parallel, the calling thread taking band 0. Each band writes only its
+// own rows, so the bands need no locking; the semaphores order the shared job state.
+#define ROW_POOL_MAX_BANDS 8
+#define ROW_POOL_MIN_ROWS 16               // Bands are at least this many rows tall
+#define ROW_POOL_MIN_PIXELS (32 * 1024)    // Smaller jobs finish before the workers would wake
+
+typedef void (*row_job_fn)(void* arg, int band, int y0, int y1);
+
+typedef struct {
+    SDL_Thread* thread;
+    SDL_sem* start;
+    int band;
+} row_worker_t;
+
+static row_worker_t g_row_workers[ROW_POOL_MAX_BANDS - 1];
+static int g_row_worker_count = 0;
+static SDL_sem* g_row_done = nullptr;
+static SDL_atomic_t g_row_pool_quit;
+static row_job_fn g_row_job = nullptr;
+static void* g_row_job_arg = nullptr;
+static int g_row_job_y0 = 0;
+static int g_row_job_rows = 0;
+static int g_row_job_bands = 0;
+
+// Screen sprites over g_screen_mem for bands 1.. (band 0 uses g_screen), so every band has its
+// own clip rect and text state when drawing window frames
+static LGFX_Sprite* g_band_screens[ROW_POOL_MAX_BANDS];
+
+static void row_band_range(int band, int* y0, int* y1) {
+    *y0 = g_row_job_y0 + (int)((int64_t)g_row_job_rows * band / g_row_job_bands);
+    *y1 = g_row_job_y0 + (int)((int64_t)g_row_job_rows * (band + 1) / g_row_job_bands);
+}
+
+static int row_worker_main(void* arg) {
+    row_worker_t* worker = (row_worker_t*)arg;
+    for (;;) {
+        SDL_SemWait(worker->start);
+        if (SDL_AtomicGet(&g_row_pool_quit)) {
+            return 0;
+        }
+        int y0, y1;
+        row_band_range(worker->band, &y0, &y1);
+        g_row_job(g_row_job_arg, worker->band, y0, y1);
+        SDL_SemPost(g_row_done);
+    }
+}
+
+// Run fn over rows [y0, y1) split into bands and return once all of them are done.
+// row_pixels is the work per row, used to keep small jobs on the calling thread.
+static void row_pool_run(row_job_fn fn, void* arg, int y0, int y1, int row_pixels) {
+    const int rows = y1 - y0;
+    int bands = g_row_worker_count + 1;
+    if (bands > rows / ROW_POOL_MIN_ROWS) {
+        bands = rows / ROW_POOL_MIN_ROWS;
+    }
+    if (bands < 2 || (int64_t)rows * row_pixels < ROW_POOL_MIN_PIXELS) {
+        fn(arg, 0, y0, y1);
+        return;
+    }
+
+    g_row_job = fn;
+    g_row_job_arg = arg;
+    g_row_job_y0 = y0;
+    g_row_job_rows = rows;
+    g_row_job_bands = bands;
+    for (int i = 1; i < bands; i++) {
+        g_row_workers[i - 1].band = i;
+        SDL_SemPost(g_row_workers[i - 1].start);
+    }
+    int by0, by1;
+    row_band_range(0, &by0, &by1);
+    fn(arg, 0, by0, by1);
+    for (int i = 1; i < bands; i++) {
+        SDL_SemWait(g_row_done);
+    }
+}
+
+// Start one worker per extra CPU (FMRB_COMPOSE_THREADS overrides the total band count; 1 = serial)
+static void row_pool_start() {
+    int threads = SDL_GetCPUCount();
+    const char* env = getenv("FMRB_COMPOSE_THREADS");
+    if (env && atoi(env) > 0) {
+        threads = atoi(env);
+    }
+    if (threads > ROW_POOL_MAX_BANDS) {
+        threads = ROW_POOL_MAX_BANDS;
+    }
+
+    SDL_AtomicSet(&g_row_pool_quit, 0);
+    g_row_worker_count = 0;
+    g_row_done = threads > 1 ? SDL_CreateSemaphore(0) : nullptr;
+    for (int i = 0; g_row_done && i < threads - 1; i++) {
+        row_worker_t* worker = &g_row_workers[i];
+        worker->start = SDL_CreateSemaphore(0);
+        worker->thread = worker->start ? SDL_CreateThread(row_worker_main, "fmrb_compose", worker) : nullptr;
+        if (!worker->thread) {
+            GFX_LOG_E("Failed to start compose worker %d: %s", i, SDL_GetError());
+            if (worker->start) {
+                SDL_DestroySemaphore(worker->start);
+                worker->start = nullptr;
+            }
+            break;
+        }
+        g_row_worker_count++;
+    }
+    GFX_LOG_I("Composition uses %d band(s)", g_row_worker_count + 1);
+}
+
+static void row_pool_stop() {
+    SDL_AtomicSet(&g_row_pool_quit, 1);
+    for (int i = 0; i < g_row_worker_count; i++) {
+        SDL_SemPost(g_row_workers[i].start);
+        SDL_WaitThread(g_row_workers[i].thread, nullptr);
+        SDL_DestroySemaphore(g_row_workers[i].start);
+        g_row_workers[i].thread = nullptr;
+        g_row_workers[i].start = nullptr;
+    }
+    g_row_worker_count = 0;
+    if (g_row_done) {
+        SDL_DestroySemaphore(g_row_done);
+        g_row_done = nullptr;
+    }
+}
+
+static int pool_class_index(size_t bytes) {
+    for (size_t i = 0; i < POOL_CLASS_COUNT; i++) {
+        if (bytes <= g_pool_classes[i]) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Get a buffer of at least bytes; *capacity receives the class size
+static void* pool_get(size_t bytes, size_t* capacity) {
+    int cls = pool_class_index(bytes);
+    if (cls < 0) {
+        GFX_LOG_E("Canvas buffer of %zu bytes exceeds the largest pool class", bytes);
+        return nullptr;
+    }
+
+    void* mem;
+    if (g_pool_free_count[cls] > 0) {
+        mem = g_pool_free[cls][--g_pool_free_count[cls]];
+        g_pool_cached -= g_pool_classes[cls];
+    } else {
+        mem = malloc(g_pool_classes[cls]);
+        if (!mem) {
+            return nullptr;
+        }
+    }
+
+    *capacity = g_pool_classes[cls];
+    g_pool_in_use += g_pool_classes[cls];
+    if (g_pool_in_use + g_pool_cached > g_pool_peak) {
+        g_pool_peak = g_pool_in_use + g_pool_cached;
+        GFX_LOG_I("Canvas buffers: %zu KB in use, %zu KB pooled, new peak %zu KB",
+                  g_pool_in_use / 1024, g_pool_cached / 1024, g_pool_peak / 1024);
+    }
+    return mem;
+}
+
+static void pool_put(void* mem, size_t capacity) {
+    if (!mem) {
+        return;
+    }
+    int cls = pool_class_index(capacity);
+    g_pool_in_use -= capacity;
+    if (cls >= 0 && g_pool_free_count[cls] < POOL_KEEP_PER_CLASS) {
+        g_pool_free[cls][g_pool_free_count[cls]++] = mem;
+        g_pool_cached += capacity;
+    } else {
+        free(mem);
+    }
+}
+
+static void pool_drain() {
+    for (size_t i = 0; i < POOL_CLASS_COUNT; i++) {
+        while (g_pool_free_count[i] > 0) {
+            free(g_pool_free[i][--g_pool_free_count[i]]);
+        }
+    }
+    g_pool_cached = 0;
+}
+
 // Canvas helper functions
+static void tile_layer_free(tile_layer_t* layer) {
+    free(layer->map);
+    free(layer->sheet);
+    memset(layer, 0, sizeof(*layer));
+}
+
 static canvas_state_t* canvas_state_find(uint16_t canvas_id) {
+    return canvas_id < g_canvas_slot_count ? g_canvas_slots[canvas_id] : nullptr;
+}
+
+// Insert a canvas into g_zorder after every canvas with the same or lower z_order
+static void zorder_insert(canvas_state_t* canvas) {
+    size_t lo = 0, hi = g_canvas_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (g_zorder[mid]->z_order <= canvas->z_order) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    memmove(&g_zorder[lo + 1], &g_zorder[lo], (g_canvas_count - lo) * sizeof(*g_zorder));
+    g_zorder[lo] = canvas;
+    g_canvas_count++;
+}
+
+static void zorder_remove(canvas_state_t* canvas) {
     for (size_t i = 0; i < g_canvas_count; i++) {
-        if (g_canvases[i].canvas_id == canvas_id) {
-            return &g_canvases[i];
+        if (g_zorder[i] == canvas) {
+            memmove(&g_zorder[i], &g_zorder[i + 1], (g_canvas_count - i - 1) * sizeof(*g_zorder));
+            g_canvas_count--;
+            return;
+        }
+    }
+}
+
+// Lowest canvas ID not in use (0 is the screen); FMRB_CANVAS_INVALID if every ID is taken
+static uint16_t canvas_id_alloc(void) {
+    size_t id = 1;
+    while (id < g_canvas_slot_count && g_canvas_slots[id]) {
+        id++;
+    }
+    return id < FMRB_CANVAS_RENDER ? (uint16_t)id : FMRB_CANVAS_INVALID;
+}
+
+// Make room for one more canvas with the given ID in the slot table and the z-order index
+static bool canvas_table_reserve(uint16_t canvas_id) {
+    if (canvas_id >= g_canvas_slot_count) {
+        size_t count = g_canvas_slot_count ? g_canvas_slot_count : 16;
+        while (count <= canvas_id) {
+            count *= 2;
         }
+        canvas_state_t** slots = (canvas_state_t**)realloc(g_canvas_slots, count * sizeof(*g_canvas_slots));
+        if (!slots) {
+            return false;
+        }
+        memset(&slots[g_canvas_slot_count], 0, (count - g_canvas_slot_count) * sizeof(*slots));
+        g_canvas_slots = slots;
+        g_canvas_slot_count = count;
     }
-    return nullptr;
+
+    if (g_canvas_count == g_canvas_capacity) {
+        size_t capacity = g_canvas_capacity ? g_canvas_capacity * 2 : 8;
+        canvas_state_t** zorder = (canvas_state_t**)realloc(g_zorder, capacity * sizeof(*g_zorder));
+        if (zorder) {
+            g_zorder = zorder;
+        }
+        const canvas_state_t** layers = (const canvas_state_t**)realloc(g_rect_layers, capacity * sizeof(*g_rect_layers));
+        if (layers) {
+            g_rect_layers = layers;
+        }
+        if (!zorder || !layers) {
+            return false;
+        }
+        g_canvas_capacity = capacity;
+    }
+    return true;
 }
 
-static canvas_state_t* canvas_state_alloc(uint16_t canvas_id, uint16_t req_width, uint16_t req_height) {
-    if (g_canvas_count >= MAX_CANVAS_COUNT) {
-        GFX_LOG_E("Maximum canvas count reached (%d)", MAX_CANVAS_COUNT);
+static canvas_state_t* canvas_state_alloc(uint16_t canvas_id, uint16_t req_width, uint16_t req_height, int16_t z_order) {
+    if (req_width == 0 || req_height == 0 || req_width > MAX_SCREEN_WIDTH || req_height > MAX_SCREEN_HEIGHT) {
+        GFX_LOG_E("Invalid canvas size %ux%u", req_width, req_height);
+        return nullptr;
+    }
+    if (canvas_state_find(canvas_id)) {
+        GFX_LOG_E("Canvas ID %u already in use", canvas_id);
+        return nullptr;
+    }
+    if (!canvas_table_reserve(canvas_id)) {
+        GFX_LOG_E("Failed to grow canvas table for ID %u", canvas_id);
         return nullptr;
     }
 
-    canvas_state_t* canvas = &g_canvases[g_canvas_count];
-    g_canvas_count++;
+    canvas_state_t* canvas = (canvas_state_t*)calloc(1, sizeof(canvas_state_t));
+    if (!canvas) {
+        GFX_LOG_E("Failed to allocate canvas %u", canvas_id);
+        return nullptr;
+    }
     canvas->canvas_id = canvas_id;
 
-    // Always allocate at max screen size to avoid reallocation on resize
-    canvas->width = MAX_SCREEN_WIDTH;
-    canvas->height = MAX_SCREEN_HEIGHT;
-
     // Set initial active size to requested size
     canvas->active_width = req_width;
     canvas->active_height = req_height;
 
-    canvas->z_order = canvas_id; // TODO: implement z_oder logic
+    canvas->z_order = z_order;
     canvas->push_x = 0;
     canvas->push_y = 0;
     canvas->is_visible = true;
     canvas->dirty = false;
-
-    // Calculate buffer size for max screen size (RGB332 = 8bit = 1 byte per pixel)
-    size_t buffer_size = MAX_SCREEN_WIDTH * MAX_SCREEN_HEIGHT * 1;  // 1 byte per pixel for RGB332
-
-    // Allocate external memory for draw buffer
-    canvas->draw_buffer_mem = malloc(buffer_size);
-    if (!canvas->draw_buffer_mem) {
-        GFX_LOG_E("Failed to allocate draw buffer memory for canvas %u", canvas_id);
-        g_canvas_count--;
-        return nullptr;
-    }
-
-    // Allocate external memory for render buffer
-    canvas->render_buffer_mem = malloc(buffer_size);
-    if (!canvas->render_buffer_mem) {
-        GFX_LOG_E("Failed to allocate render buffer memory for canvas %u", canvas_id);
-        free(canvas->draw_buffer_mem);
-        g_canvas_count--;
+    canvas->shown = false;
+    memset(canvas->tile_layers, 0, sizeof(canvas->tile_layers));
+    canvas->tile_key = 0xFF;
+    canvas->palette = nullptr;
+    memset(canvas->lists, 0, sizeof(canvas->lists));
+    canvas->frame_style = FMRB_LINK_GFX_FRAME_NONE;
+    canvas->frame_flags = 0;
+    canvas->title[0] = '\0';
+
+    // Buffers sized for the requested area (RGB332 = 1 byte per pixel); UPDATE_WINDOW grows them
+    size_t needed = (size_t)req_width * req_height;
+    size_t render_size = 0;
+    canvas->draw_buffer_mem = pool_get(needed, &canvas->buffer_size);
+    canvas->render_buffer_mem = pool_get(needed, &render_size);
+    if (!canvas->draw_buffer_mem || !canvas->render_buffer_mem) {
+        GFX_LOG_E("Failed to allocate buffer memory for canvas %u", canvas_id);
+        pool_put(canvas->draw_buffer_mem, canvas->buffer_size);
+        pool_put(canvas->render_buffer_mem, render_size);
+        free(canvas);
         return nullptr;
     }
+    g_canvas_slots[canvas_id] = canvas;
+    zorder_insert(canvas);
 
     // Create draw buffer sprite and set external buffer
     canvas->draw_buffer = new LGFX_Sprite(g_lgfx);
@@ -143,17 +577,33 @@ static canvas_state_t* canvas_state_alloc(uint16_t canvas_id, uint16_t req_width
     canvas->render_buffer->setColorDepth(8);  // RGB332
     canvas->render_buffer->setBuffer(canvas->render_buffer_mem, req_width, req_height, 8);
 
-    GFX_LOG_I("Canvas allocated: ID=%u, allocated_size=%dx%d, active_size=%dx%d, z_order=%d",
-              canvas_id, canvas->width, canvas->height,
-              canvas->active_width, canvas->active_height, canvas->z_order);
+    GFX_LOG_I("Canvas allocated: ID=%u, active_size=%dx%d, buffers=2x%zu bytes, z_order=%d",
+              canvas_id, canvas->active_width, canvas->active_height, canvas->buffer_size, canvas->z_order);
     return canvas;
 }
 
+// Copy a canvas buffer into a larger one for a new active size, keeping pixel coordinates.
+// Columns and rows that become visible are cleared to 0.
+static void canvas_buffer_copy(uint8_t* mem, const uint8_t* src, int old_w, int old_h, int new_w, int new_h) {
+    const int rows = old_h < new_h ? old_h : new_h;
+    const int keep = old_w < new_w ? old_w : new_w;
+    for (int y = 0; y < rows; y++) {
+        memcpy(mem + (size_t)y * new_w, src + (size_t)y * old_w, keep);
+        memset(mem + (size_t)y * new_w + keep, 0, new_w - keep);
+    }
+    memset(mem + (size_t)rows * new_w, 0, (size_t)(new_h - rows) * new_w);
+}
+
 static void canvas_state_free(canvas_state_t* canvas) {
     if (!canvas) return;
 
     GFX_LOG_I("Freeing canvas ID=%u", canvas->canvas_id);
 
+    // Whatever was under the window shows through on the next frame
+    if (canvas->shown) {
+        damage_add(canvas->shown_x, canvas->shown_y, canvas->shown_w, canvas->shown_h);
+    }
+
     if (canvas->draw_buffer) {
         delete canvas->draw_buffer;
         canvas->draw_buffer = nullptr;
@@ -163,73 +613,450 @@ static void canvas_state_free(canvas_state_t* canvas) {
         canvas->render_buffer = nullptr;
     }
 
-    // Free external memory buffers
-    if (canvas->draw_buffer_mem) {
-        free(canvas->draw_buffer_mem);
-        canvas->draw_buffer_mem = nullptr;
+    // Return the buffers to the pool
+    pool_put(canvas->draw_buffer_mem, canvas->buffer_size);
+    pool_put(canvas->render_buffer_mem, canvas->buffer_size);
+    canvas->draw_buffer_mem = nullptr;
+    canvas->render_buffer_mem = nullptr;
+
+    for (int i = 0; i < FMRB_LINK_GFX_MAX_TILE_LAYERS; i++) {
+        tile_layer_free(&canvas->tile_layers[i]);
+    }
+    free(canvas->palette);
+    canvas->palette = nullptr;
+    for (int i = 0; i < FMRB_LINK_GFX_MAX_LISTS; i++) {
+        free(canvas->lists[i].data);
+    }
+    memset(canvas->lists, 0, sizeof(canvas->lists));
+
+    zorder_remove(canvas);
+    g_canvas_slots[canvas->canvas_id] = nullptr;
+    free(canvas);
+}
+
+static bool canvas_has_tile_layers(const canvas_state_t* canvas) {
+    for (int i = 0; i < FMRB_LINK_GFX_MAX_TILE_LAYERS; i++) {
+        if (canvas->tile_layers[i].active) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Draw one tile layer into an RGB332 buffer (stride = dst_w), wrapping the map at its edges
+static void tile_layer_compose(const tile_layer_t* layer, uint8_t* dst, int dst_w, int dst_h, int key) {
+    if (!layer->sheet) {
+        return;
+    }
+
+    const int tile_w = layer->tile_w;
+    const int tile_h = layer->tile_h;
+    const int tiles_per_row = layer->sheet_w / tile_w;
+    const int tile_count = tiles_per_row * (layer->sheet_h / tile_h);
+    const int world_w = layer->map_w * tile_w;
+    const int world_h = layer->map_h * tile_h;
+
+    int start_x = layer->scroll_x % world_w;
+    if (start_x < 0) start_x += world_w;
+    int wy = layer->scroll_y % world_h;
+    if (wy < 0) wy += world_h;
+
+    for (int y = 0; y < dst_h; y++) {
+        const uint8_t* map_row = layer->map + (wy / tile_h) * layer->map_w;
+        const int py = wy % tile_h;
+        uint8_t* out = dst + (size_t)y * dst_w;
+
+        // Copy one tile-wide run at a time
+        int wx = start_x;
+        for (int x = 0; x < dst_w; ) {
+            const int px = wx % tile_w;
+            int run = tile_w - px;
+            if (run > dst_w - x) run = dst_w - x;
+
+            const int tile = map_row[wx / tile_w];
+            if (tile != FMRB_LINK_GFX_TILE_EMPTY && tile < tile_count) {
+                const uint8_t* src = layer->sheet
+                    + (size_t)((tile / tiles_per_row) * tile_h + py) * layer->sheet_w
+                    + (tile % tiles_per_row) * tile_w + px;
+                if (key < 0) {
+                    memcpy(out + x, src, run);
+                } else {
+                    pixel_blit_key8(out + x, src, run, (uint8_t)key);
+                }
+            }
+
+            x += run;
+            wx += run;
+            if (wx >= world_w) wx -= world_w;
+        }
+
+        if (++wy >= world_h) wy = 0;
+    }
+}
+
+// Compose all tile layers of a canvas into its render buffer (back to front)
+static void canvas_compose_tile_layers(canvas_state_t* canvas) {
+    uint8_t* dst = (uint8_t*)canvas->render_buffer_mem;
+    for (int i = 0; i < FMRB_LINK_GFX_MAX_TILE_LAYERS; i++) {
+        const tile_layer_t* layer = &canvas->tile_layers[i];
+        if (!layer->active) {
+            continue;
+        }
+        // Layer 0 is the opaque backdrop; upper layers honor the canvas key
+        int key = (i == 0 || canvas->tile_key == 0xFF) ? -1 : canvas->tile_key;
+        tile_layer_compose(layer, dst, canvas->active_width, canvas->active_height, key);
+    }
+}
+
+typedef struct {
+    canvas_state_t* canvas;
+    int key;                       // -1 = plain copy
+} canvas_blit_job_t;
+
+static void canvas_blit_rows(void* arg, int band, int y0, int y1) {
+    (void)band;
+    const canvas_blit_job_t* job = (const canvas_blit_job_t*)arg;
+    const size_t offset = (size_t)y0 * job->canvas->active_width;
+    const size_t count = (size_t)(y1 - y0) * job->canvas->active_width;
+    uint8_t* dst = (uint8_t*)job->canvas->render_buffer_mem + offset;
+    const uint8_t* src = (const uint8_t*)job->canvas->draw_buffer_mem + offset;
+    if (job->key < 0) {
+        memcpy(dst, src, count);
+    } else {
+        pixel_blit_key8(dst, src, count, (uint8_t)job->key);
+    }
+}
+
+// Copy the draw buffer into the render buffer, skipping pixels equal to key (-1 = copy all).
+// Both buffers hold active_width x active_height pixels back to back, so bands are plain runs.
+static void canvas_blit(canvas_state_t* canvas, int key) {
+    canvas_blit_job_t job = { canvas, key };
+    row_pool_run(canvas_blit_rows, &job, 0, canvas->active_height, canvas->active_width);
+}
+
+typedef struct {
+    uint8_t* mem;
+    int stride;
+    int x, w;
+    uint8_t color;
+} canvas_fill_job_t;
+
+static void canvas_fill_rows(void* arg, int band, int y0, int y1) {
+    (void)band;
+    const canvas_fill_job_t* job = (const canvas_fill_job_t*)arg;
+    for (int y = y0; y < y1; y++) {
+        memset(job->mem + (size_t)y * job->stride + job->x, job->color, job->w);
+    }
+}
+
+// Fill a rectangle of a canvas draw buffer (RGB332 or palette index), clipped to the active area
+static void canvas_fill_rect(canvas_state_t* canvas, int x, int y, int w, int h, uint8_t color) {
+    int x1 = x + w, y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > canvas->active_width) x1 = canvas->active_width;
+    if (y1 > canvas->active_height) y1 = canvas->active_height;
+    if (x >= x1 || y >= y1) {
+        return;
+    }
+    canvas_fill_job_t job = { (uint8_t*)canvas->draw_buffer_mem, canvas->active_width, x, x1 - x, color };
+    row_pool_run(canvas_fill_rows, &job, y, y1, x1 - x);
+}
+
+static void cursor_sprite_draw(uint8_t shape) {
+    g_cursor_sprite->clear(CURSOR_TRANSPARENT_COLOR);
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 8; x++) {
+            uint32_t color;
+            switch (cursor_patterns[shape][y][x]) {
+                case 1: color = 0xFFFFFF; break;  // White outline
+                case 2: color = 0x000000; break;  // Black body
+                default: color = CURSOR_TRANSPARENT_COLOR; break;  // Transparent
+            }
+            g_cursor_sprite->drawPixel(x, y, color);
+        }
+    }
+}
+
+static void cursor_latency_add(cursor_latency_t* lat, const char* path, uint64_t stamp, uint64_t now) {
+    double ms = (double)(now - stamp) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    lat->count++;
+    lat->total_ms += ms;
+    if (ms > lat->max_ms) {
+        lat->max_ms = ms;
+    }
+    if (lat->count == CURSOR_LATENCY_REPORT) {
+        GFX_LOG_I("Cursor latency (%s): avg %.2f ms, max %.2f ms over %u moves",
+                  path, lat->total_ms / lat->count, lat->max_ms, lat->count);
+        memset(lat, 0, sizeof(*lat));
+    }
+}
+
+// Take the latest pointer position from the host input; returns true if it moved
+static bool cursor_track_input() {
+    int x, y;
+    uint64_t stamp;
+    if (input_handler_get_cursor(&x, &y, &stamp) != 0 || stamp == 0 || stamp == g_cursor_stamp) {
+        return false;
+    }
+    g_cursor_stamp = stamp;
+    g_cursor_x = x;
+    g_cursor_y = y;
+    g_local_pending = stamp;
+    return true;
+}
+
+// Frame colors (RGB332)
+static const uint8_t FRAME_TITLE_COLOR = 0xC5;
+static const uint8_t FRAME_EDGE_COLOR = 0x60;   // Border, menu button and resize grip
+static const uint8_t FRAME_CLOSE_COLOR = 0xE0;
+static const uint8_t FRAME_TEXT_COLOR = 0xFF;
+
+// Draw a canvas window frame onto the screen buffer at the canvas position, inside clip only
+static void canvas_draw_frame(const canvas_state_t* canvas, LGFX_Sprite* dst, const screen_rect_t* clip) {
+    if (canvas->frame_style != FMRB_LINK_GFX_FRAME_TITLED) {
+        return;
     }
-    if (canvas->render_buffer_mem) {
-        free(canvas->render_buffer_mem);
-        canvas->render_buffer_mem = nullptr;
+    const int x = canvas->push_x;
+    const int y = canvas->push_y;
+    const int w = canvas->active_width;
+    const int h = canvas->active_height;
+    const int btn = FMRB_LINK_GFX_FRAME_BUTTON_SIZE;
+
+    dst->setClipRect(clip->x0, clip->y0, clip->x1 - clip->x0, clip->y1 - clip->y0);
+    dst->fillRect(x, y, w, FMRB_LINK_GFX_FRAME_TITLE_HEIGHT, FRAME_TITLE_COLOR);
+    dst->fillRect(x + 2, y + 2, btn, btn, FRAME_EDGE_COLOR);  // Menu button
+
+    int title_right = x + w - 2;
+    if (canvas->frame_flags & FMRB_LINK_GFX_FRAME_FLAG_CLOSE) {
+        const int cx = x + w - btn - 2;
+        const int cy = y + 2;
+        dst->fillRect(cx, cy, btn, btn, FRAME_CLOSE_COLOR);
+        dst->drawLine(cx + 2, cy + 2, cx + 5, cy + 5, FRAME_TEXT_COLOR);
+        dst->drawLine(cx + 5, cy + 2, cx + 2, cy + 5, FRAME_TEXT_COLOR);
+        title_right = cx - 2;
     }
 
-    // Remove from array by shifting remaining elements
-    size_t index = canvas - g_canvases;
-    if (index < g_canvas_count - 1) {
-        memmove(&g_canvases[index], &g_canvases[index + 1],
-                (g_canvas_count - index - 1) * sizeof(canvas_state_t));
+    // Title is clipped so a long name never runs under the close button
+    if (canvas->title[0] != '\0' && title_right > x + 12) {
+        const int tx0 = x + 12 > clip->x0 ? x + 12 : clip->x0;
+        const int ty0 = y > clip->y0 ? y : clip->y0;
+        const int tx1 = title_right < clip->x1 ? title_right : clip->x1;
+        const int ty1 = y + FMRB_LINK_GFX_FRAME_TITLE_HEIGHT < clip->y1 ? y + FMRB_LINK_GFX_FRAME_TITLE_HEIGHT : clip->y1;
+        if (tx0 < tx1 && ty0 < ty1) {
+            dst->setClipRect(tx0, ty0, tx1 - tx0, ty1 - ty0);
+            dst->setTextSize(1);
+            dst->setTextColor(FRAME_TEXT_COLOR);
+            dst->setCursor(x + 12, y + 2);
+            dst->print(canvas->title);
+            dst->setClipRect(clip->x0, clip->y0, clip->x1 - clip->x0, clip->y1 - clip->y0);
+        }
     }
-    g_canvas_count--;
+
+    dst->drawRect(x, y, w, h, FRAME_EDGE_COLOR);
+
+    if (canvas->frame_flags & FMRB_LINK_GFX_FRAME_FLAG_RESIZE) {
+        const int gx = x + w - 2;
+        const int gy = y + h - 2;
+        for (int i = 2; i < FMRB_LINK_GFX_FRAME_GRIP_SIZE - 2; i += 3) {
+            dst->drawLine(gx - i, gy, gx, gy - i, FRAME_EDGE_COLOR);
+        }
+    }
+    dst->clearClipRect();
 }
 
-// Compare function for qsort (sort by z_order ascending)
-static int canvas_compare_zorder(const void* a, const void* b) {
-    const canvas_state_t* ca = (const canvas_state_t*)a;
-    const canvas_state_t* cb = (const canvas_state_t*)b;
-    return ca->z_order - cb->z_order;
+// Re-lay a canvas buffer for a new active size so existing pixels keep their coordinates.
+// Columns and rows that become visible are cleared to 0.
+static void canvas_reflow(uint8_t* mem, int old_w, int old_h, int new_w, int new_h) {
+    const int rows = old_h < new_h ? old_h : new_h;
+    const int keep = old_w < new_w ? old_w : new_w;
+    if (new_w > old_w) {
+        // Rows move forward: go bottom-up so no source row is overwritten before it is moved
+        for (int y = rows - 1; y >= 0; y--) {
+            memmove(mem + (size_t)y * new_w, mem + (size_t)y * old_w, keep);
+            memset(mem + (size_t)y * new_w + keep, 0, new_w - keep);
+        }
+    } else if (new_w < old_w) {
+        for (int y = 0; y < rows; y++) {
+            memmove(mem + (size_t)y * new_w, mem + (size_t)y * old_w, keep);
+        }
+    }
+    if (new_h > rows) {
+        memset(mem + (size_t)rows * new_w, 0, (size_t)(new_h - rows) * new_w);
+    }
 }
 
-static void canvas_sort_by_zorder() {
-    if (g_canvas_count > 1) {
-        qsort(g_canvases, g_canvas_count, sizeof(canvas_state_t), canvas_compare_zorder);
+static size_t g_rect_layer_count = 0;
+
+// Write row span [x0, x1) of a canvas into the screen buffer (nullptr = clear to background).
+// Indexed canvases are translated through their palette on the way.
+static void composite_span(const canvas_state_t* canvas, int y, int x0, int x1) {
+    uint8_t* dst = (uint8_t*)g_screen_mem + (size_t)y * g_screen->width() + x0;
+    if (!canvas) {
+        memset(dst, 0, x1 - x0);
+        return;
+    }
+    const uint8_t* src = (const uint8_t*)canvas->render_buffer_mem
+                       + (size_t)(y - canvas->push_y) * canvas->active_width + (x0 - canvas->push_x);
+    if (canvas->palette) {
+        const uint8_t* palette = canvas->palette;
+        for (int x = 0; x < x1 - x0; x++) {
+            dst[x] = palette[src[x]];
+        }
+    } else {
+        memcpy(dst, src, x1 - x0);
     }
 }
 
-// Render all canvases to screen in Z-order
-static void graphics_handler_render_frame_internal() {
-    if (g_canvas_count == 0) {
-        return;  // No canvases to render
+// Write only the parts of row span [x0, x1) that no window from g_rect_layers[first] upward covers.
+// Composited windows are opaque, so covered pixels would just be overwritten later in the frame.
+static void composite_visible_span(const canvas_state_t* canvas, size_t first, int y, int x0, int x1) {
+    for (size_t i = first; i < g_rect_layer_count; i++) {
+        const canvas_state_t* above = g_rect_layers[i];
+        if (y < above->shown_y || y >= above->shown_y + above->shown_h) {
+            continue;
+        }
+        const int ax0 = above->shown_x;
+        const int ax1 = above->shown_x + above->shown_w;
+        if (ax1 <= x0 || ax0 >= x1) {
+            continue;
+        }
+        // Only the pieces left and right of the occluder can still be visible
+        if (ax0 > x0) {
+            composite_visible_span(canvas, i + 1, y, x0, ax0);
+        }
+        if (ax1 < x1) {
+            composite_visible_span(canvas, i + 1, y, ax1, x1);
+        }
+        return;
     }
+    composite_span(canvas, y, x0, x1);
+}
 
-    // Sort canvases by Z-order (low to high)
-    canvas_sort_by_zorder();
+// Rebuild rows [y0, y1) of the damaged rectangle in g_compose_rect; one band of composite_rect
+static const screen_rect_t* g_compose_rect = nullptr;
 
-    LGFX_Sprite* screen_buffer = g_canvases[0].render_buffer; //system GUI canvas
+static void composite_band(void* arg, int band, int y0, int y1) {
+    (void)arg;
+    const screen_rect_t rect = { g_compose_rect->x0, (int16_t)y0, g_compose_rect->x1, (int16_t)y1 };
+    LGFX_Sprite* screen = band == 0 ? g_screen : g_band_screens[band];
 
-    // Composite all visible canvases to screen buffer (NOT to g_lgfx directly)
-    for (size_t i = 1; i < g_canvas_count; i++) {
-        canvas_state_t* canvas = &g_canvases[i];
-        if (canvas->is_visible && canvas->render_buffer) {
-            GFX_LOG_D("Composite canvas ID=%u to screen buffer at (%d,%d), active_size=%dx%d, z_order=%d",
-                    canvas->canvas_id, canvas->push_x, canvas->push_y,
-                    canvas->active_width, canvas->active_height, canvas->z_order);
-            canvas->dirty = false;
+    for (int y = rect.y0; y < rect.y1; y++) {
+        composite_visible_span(nullptr, 0, y, rect.x0, rect.x1);
+    }
 
-            // Push render_buffer to screen buffer
-            // Since setBuffer configures sprite to active size, pushSprite will only transfer active region
-            canvas->render_buffer->pushSprite(screen_buffer, canvas->push_x, canvas->push_y);
+    for (size_t l = 0; l < g_rect_layer_count; l++) {
+        const canvas_state_t* canvas = g_rect_layers[l];
+        const int x0 = canvas->shown_x > rect.x0 ? canvas->shown_x : rect.x0;
+        const int x1 = canvas->shown_x + canvas->shown_w < rect.x1 ? canvas->shown_x + canvas->shown_w : rect.x1;
+        const int cy0 = canvas->shown_y > rect.y0 ? canvas->shown_y : rect.y0;
+        const int cy1 = canvas->shown_y + canvas->shown_h < rect.y1 ? canvas->shown_y + canvas->shown_h : rect.y1;
+        if (cy0 >= cy1) {
+            continue;
+        }
+        for (int y = cy0; y < cy1; y++) {
+            composite_visible_span(canvas, l + 1, y, x0, x1);
         }
+        // Frame goes on top of this window; windows above repaint whatever of it they cover
+        canvas_draw_frame(canvas, screen, &rect);
     }
+}
 
-    // Finally, push the complete screen buffer to g_lgfx (only once per frame)
-    screen_buffer->pushSprite(g_lgfx, 0, 0);
-    GFX_LOG_D("Screen buffer pushed to display");
+// Rebuild a damaged rectangle of the screen buffer back to front, skipping occluded spans.
+// Tall rectangles are split into bands composited in parallel.
+static void composite_rect(const screen_rect_t* rect) {
+    g_rect_layer_count = 0;
+    for (size_t i = 0; i < g_canvas_count; i++) {
+        const canvas_state_t* canvas = g_zorder[i];
+        if (canvas->shown &&
+            canvas->shown_x < rect->x1 && canvas->shown_x + canvas->shown_w > rect->x0 &&
+            canvas->shown_y < rect->y1 && canvas->shown_y + canvas->shown_h > rect->y0) {
+            g_rect_layers[g_rect_layer_count++] = canvas;
+        }
+    }
+
+    g_compose_rect = rect;
+    row_pool_run(composite_band, nullptr, rect->y0, rect->y1, rect->x1 - rect->x0);
+}
+
+// Render all canvases to screen in Z-order.
+// Only windows that were presented, moved, resized or restyled since the last frame add damage,
+// and only the damaged rectangles are recomposited and pushed. Returns true if the screen changed.
+static bool graphics_handler_render_frame_internal() {
+    if (!g_screen) {
+        return false;
+    }
+
+    // Collect damage: old and new placement of every changed window
+    for (size_t i = 0; i < g_canvas_count; i++) {
+        canvas_state_t* canvas = g_zorder[i];
+        const bool on = canvas->is_visible && canvas->render_buffer;
+        const bool moved = canvas->shown != on ||
+            canvas->shown_x != canvas->push_x || canvas->shown_y != canvas->push_y ||
+            canvas->shown_w != canvas->active_width || canvas->shown_h != canvas->active_height;
+        if (!canvas->dirty && !moved) {
+            continue;
+        }
+        if (canvas->shown) {
+            damage_add(canvas->shown_x, canvas->shown_y, canvas->shown_w, canvas->shown_h);
+        }
+        if (on) {
+            damage_add(canvas->push_x, canvas->push_y, canvas->active_width, canvas->active_height);
+        }
+        canvas->shown = on;
+        canvas->shown_x = canvas->push_x;
+        canvas->shown_y = canvas->push_y;
+        canvas->shown_w = canvas->active_width;
+        canvas->shown_h = canvas->active_height;
+        canvas->dirty = false;
+    }
+
+    // The cursor is drawn straight onto g_lgfx, so its old spot has to be restored from the screen buffer
+    cursor_track_input();
+    const bool cursor_on = g_cursor_visible && g_cursor_sprite;
+    const int new_cursor_x = g_cursor_x - cursor_hot_spots[g_cursor_shape][0];
+    const int new_cursor_y = g_cursor_y - cursor_hot_spots[g_cursor_shape][1];
+    const bool cursor_redraw = g_cursor_changed || cursor_on != g_cursor_shown ||
+        (cursor_on && (g_cursor_shown_x != new_cursor_x || g_cursor_shown_y != new_cursor_y));
+    if (cursor_redraw && g_cursor_shown) {
+        damage_add(g_cursor_shown_x, g_cursor_shown_y, 8, 8);
+    }
+
+    if (g_damage_count == 0 && !cursor_redraw) {
+        return false;  // Nothing changed: leave the display as it is
+    }
+
+    // Rebuild each damaged rectangle, then push just that rectangle
+    for (int r = 0; r < g_damage_count; r++) {
+        const screen_rect_t* rect = &g_damage[r];
+        composite_rect(rect);
+        g_lgfx->setClipRect(rect->x0, rect->y0, rect->x1 - rect->x0, rect->y1 - rect->y0);
+        g_screen->pushSprite(g_lgfx, 0, 0);
+        GFX_LOG_D("Damage (%d,%d)-(%d,%d) pushed to display", rect->x0, rect->y0, rect->x1, rect->y1);
+    }
+    g_lgfx->clearClipRect();
+    g_damage_count = 0;
 
     // Draw cursor on top of everything (if visible)
-    if (g_cursor_visible && g_cursor_sprite) {
-        g_cursor_sprite->pushSprite(g_lgfx, g_cursor_x, g_cursor_y, CURSOR_TRANSPARENT_COLOR);
+    g_cursor_shown = cursor_on;
+    g_cursor_changed = false;
+    if (cursor_on) {
+        g_cursor_shown_x = new_cursor_x;
+        g_cursor_shown_y = new_cursor_y;
+        g_cursor_sprite->pushSprite(g_lgfx, new_cursor_x, new_cursor_y, CURSOR_TRANSPARENT_COLOR);
         GFX_LOG_D("Cursor drawn at (%d, %d)", g_cursor_x, g_cursor_y);
     }
+
+    const uint64_t now = SDL_GetPerformanceCounter();
+    if (g_local_pending) {
+        cursor_latency_add(&g_latency_local, "local", g_local_pending, now);
+        g_local_pending = 0;
+    }
+    if (g_core_pending) {
+        cursor_latency_add(&g_latency_core, "core round trip", g_core_pending, now);
+        g_core_pending = 0;
+    }
+    return true;
 }
 
 // Get current drawing target (screen or canvas)
@@ -262,24 +1089,35 @@ extern "C" int graphics_handler_init(SDL_Renderer *renderer) {
 
     g_lgfx->setAutoDisplay(false);
 
+    // Screen buffer (RGB332) the canvases are composited into
+    g_screen_mem = malloc((size_t)g_lgfx->width() * g_lgfx->height());
+    if (!g_screen_mem) {
+        GFX_LOG_E("Failed to allocate screen buffer (%dx%d)", g_lgfx->width(), g_lgfx->height());
+        return -1;
+    }
+    memset(g_screen_mem, 0, (size_t)g_lgfx->width() * g_lgfx->height());
+    g_screen = new LGFX_Sprite(g_lgfx);
+    g_screen->setColorDepth(8);  // RGB332
+    g_screen->setBuffer(g_screen_mem, g_lgfx->width(), g_lgfx->height(), 8);
+    g_damage_count = 0;
+    damage_add(0, 0, g_lgfx->width(), g_lgfx->height());
+
+    // Pick the pixel kernels once, before the compose workers can call them
+    pixel_isa_t isa = pixel_kernels_init(1);
+    GFX_LOG_I("Pixel kernels: %s", pixel_kernels_isa_name(isa));
+
+    row_pool_start();
+    for (int i = 1; i <= g_row_worker_count; i++) {
+        g_band_screens[i] = new LGFX_Sprite(g_lgfx);
+        g_band_screens[i]->setColorDepth(8);
+        g_band_screens[i]->setBuffer(g_screen_mem, g_lgfx->width(), g_lgfx->height(), 8);
+    }
+
     // Initialize cursor sprite (8x8 arrow)
     g_cursor_sprite = new LGFX_Sprite(g_lgfx);
     g_cursor_sprite->setColorDepth(8);  // 8-bit color
     g_cursor_sprite->createSprite(8, 8);
-    g_cursor_sprite->clear(CURSOR_TRANSPARENT_COLOR);
-
-    // Draw cursor pattern
-    for (int y = 0; y < 8; y++) {
-        for (int x = 0; x < 8; x++) {
-            uint32_t color;
-            switch (cursor_pattern[y][x]) {
-                case 1: color = 0xFFFFFF; break;  // White outline
-                case 2: color = 0x000000; break;  // Black body
-                default: color = CURSOR_TRANSPARENT_COLOR; break;  // Transparent
-            }
-            g_cursor_sprite->drawPixel(x, y, color);
-        }
-    }
+    cursor_sprite_draw(g_cursor_shape);
 
     g_graphics_initialized = true;  // Mark as initialized
     GFX_LOG_I("Graphics handler initialized with screen buffer (%dx%d)",
@@ -291,8 +1129,17 @@ extern "C" int graphics_handler_init(SDL_Renderer *renderer) {
 extern "C" void graphics_handler_cleanup(void) {
     // Delete all canvases
     while (g_canvas_count > 0) {
-        canvas_state_free(&g_canvases[0]);
+        canvas_state_free(g_zorder[0]);
     }
+    free(g_canvas_slots);
+    free(g_zorder);
+    free(g_rect_layers);
+    g_canvas_slots = nullptr;
+    g_zorder = nullptr;
+    g_rect_layers = nullptr;
+    g_canvas_slot_count = 0;
+    g_canvas_capacity = 0;
+    pool_drain();
 
     // Delete cursor sprite
     if (g_cursor_sprite) {
@@ -301,6 +1148,20 @@ extern "C" void graphics_handler_cleanup(void) {
         GFX_LOG_I("Cursor sprite deleted");
     }
 
+    row_pool_stop();
+    for (int i = 1; i < ROW_POOL_MAX_BANDS; i++) {
+        delete g_band_screens[i];
+        g_band_screens[i] = nullptr;
+    }
+
+    if (g_screen) {
+        delete g_screen;
+        g_screen = nullptr;
+    }
+    free(g_screen_mem);
+    g_screen_mem = nullptr;
+    g_damage_count = 0;
+
     g_current_target = FMRB_CANVAS_SCREEN;
     g_graphics_initialized = false;  // Reset initialization flag
 
@@ -312,18 +1173,299 @@ extern "C" SDL_Renderer* graphics_handler_get_renderer(void) {
     return nullptr; // Not used with LovyanGFX
 }
 
-extern "C" void graphics_handler_render_frame(void) {
+extern "C" int graphics_handler_render_frame(void) {
     if (!g_lgfx) {
-        return;
+        return 0;
     }
-    graphics_handler_render_frame_internal();
+    return graphics_handler_render_frame_internal() ? 1 : 0;
 }
 
 // Forward declaration - implemented in socket_server.c
 extern "C" int socket_server_send_ack(uint8_t type, uint8_t seq, const uint8_t *response_data, uint16_t response_len);
+extern "C" int socket_server_send_message(uint8_t type, uint8_t sub_cmd, const uint8_t *data, uint16_t len);
+
+// Frame-complete notification state
+static uint32_t g_render_pushes = 0;           // PUSH_CANVAS to RENDER received
+static uint32_t g_render_pushes_notified = 0;  // Value sent with the last FRAME_DONE
+static uint32_t g_frame_count = 0;
+
+// Resolve a draw command's target canvas (nullptr if not found)
+static LovyanGFX* resolve_draw_target(uint16_t canvas_id) {
+    if (canvas_id == FMRB_CANVAS_SCREEN) {
+        return g_lgfx;
+    }
+    canvas_state_t* canvas = canvas_state_find(canvas_id);
+    if (!canvas) {
+        GFX_LOG_E("Canvas %u not found", canvas_id);
+        return nullptr;
+    }
+    return canvas->draw_buffer;
+}
+
+// Point-list decode buffers (commands are processed one at a time)
+static fmrb_point_t g_points[FMRB_LINK_GFX_MAX_POINTS];
+static int16_t g_poly_nodes[FMRB_LINK_GFX_MAX_POINTS];
+
+// Decode a point-list payload into g_points; returns the point count, or -1 if malformed
+static int decode_points(const fmrb_link_graphics_points_t* cmd, const uint8_t* payload, size_t payload_size) {
+    uint16_t count = cmd->point_count;
+    if (count == 0 || count > FMRB_LINK_GFX_MAX_POINTS) {
+        return -1;
+    }
+
+    if (cmd->encoding == FMRB_LINK_GFX_POINTS_ABS16) {
+        if (payload_size < (size_t)count * 4) {
+            return -1;
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            memcpy(&g_points[i].x, payload + i * 4, sizeof(int16_t));
+            memcpy(&g_points[i].y, payload + i * 4 + 2, sizeof(int16_t));
+        }
+    } else if (cmd->encoding == FMRB_LINK_GFX_POINTS_DELTA8) {
+        if (payload_size < 4 + (size_t)(count - 1) * 2) {
+            return -1;
+        }
+        memcpy(&g_points[0].x, payload, sizeof(int16_t));
+        memcpy(&g_points[0].y, payload + 2, sizeof(int16_t));
+        const int8_t* delta = (const int8_t*)(payload + 4);
+        for (uint16_t i = 1; i < count; i++) {
+            g_points[i].x = g_points[i - 1].x + delta[(i - 1) * 2];
+            g_points[i].y = g_points[i - 1].y + delta[(i - 1) * 2 + 1];
+        }
+    } else {
+        return -1;
+    }
+
+    return count;
+}
+
+// Even-odd scanline fill; vertices are joined in order and the last closes to the first
+static void fill_polygon_scanline(LovyanGFX* target, const fmrb_point_t* pts, int count, uint8_t color) {
+    int min_y = pts[0].y;
+    int max_y = pts[0].y;
+    for (int i = 1; i < count; i++) {
+        if (pts[i].y < min_y) min_y = pts[i].y;
+        if (pts[i].y > max_y) max_y = pts[i].y;
+    }
+    if (min_y < 0) min_y = 0;
+    if (max_y > target->height() - 1) max_y = target->height() - 1;
+
+    for (int y = min_y; y <= max_y; y++) {
+        // Collect edge crossings (half-open in y so shared vertices count once)
+        int nodes = 0;
+        for (int i = 0, j = count - 1; i < count; j = i++) {
+            int y0 = pts[j].y, y1 = pts[i].y;
+            if ((y0 <= y && y < y1) || (y1 <= y && y < y0)) {
+                int x0 = pts[j].x, x1 = pts[i].x;
+                g_poly_nodes[nodes++] = (int16_t)(x0 + (y - y0) * (x1 - x0) / (y1 - y0));
+            }
+        }
+
+        // Insertion sort; node counts are small
+        for (int i = 1; i < nodes; i++) {
+            int16_t v = g_poly_nodes[i];
+            int k = i - 1;
+            while (k >= 0 && g_poly_nodes[k] > v) {
+                g_poly_nodes[k + 1] = g_poly_nodes[k];
+                k--;
+            }
+            g_poly_nodes[k + 1] = v;
+        }
+
+        for (int i = 0; i + 1 < nodes; i += 2) {
+            target->drawFastHLine(g_poly_nodes[i], y, g_poly_nodes[i + 1] - g_poly_nodes[i] + 1, color);
+        }
+    }
+}
+
+// Minimum payload of each command a display list may contain (0 = not allowed)
+static size_t display_list_item_min_size(uint8_t cmd_type) {
+    switch (cmd_type) {
+        case FMRB_LINK_GFX_DRAW_PIXEL:          return sizeof(fmrb_link_graphics_pixel_t);
+        case FMRB_LINK_GFX_DRAW_LINE:           return sizeof(fmrb_link_graphics_line_t);
+        case FMRB_LINK_GFX_DRAW_RECT:
+        case FMRB_LINK_GFX_FILL_RECT:           return sizeof(fmrb_link_graphics_rect_t);
+        case FMRB_LINK_GFX_DRAW_ROUND_RECT:
+        case FMRB_LINK_GFX_FILL_ROUND_RECT:     return sizeof(fmrb_link_graphics_round_rect_t);
+        case FMRB_LINK_GFX_DRAW_CIRCLE:
+        case FMRB_LINK_GFX_FILL_CIRCLE:         return sizeof(fmrb_link_graphics_circle_t);
+        case FMRB_LINK_GFX_DRAW_ELLIPSE:
+        case FMRB_LINK_GFX_FILL_ELLIPSE:        return sizeof(fmrb_link_graphics_ellipse_t);
+        case FMRB_LINK_GFX_DRAW_TRIANGLE:
+        case FMRB_LINK_GFX_FILL_TRIANGLE:       return sizeof(fmrb_link_graphics_triangle_t);
+        case FMRB_LINK_GFX_DRAW_STRING:         return sizeof(fmrb_link_graphics_text_t);
+        case FMRB_LINK_GFX_DRAW_STRING_CURRENT: return sizeof(fmrb_link_graphics_text_current_t);
+        case FMRB_LINK_GFX_SET_TEXT_COLOR:      return sizeof(fmrb_link_graphics_text_color_t);
+        case FMRB_LINK_GFX_SET_TEXT_SIZE:       return sizeof(fmrb_link_graphics_text_size_t);
+        case FMRB_LINK_GFX_DRAW_POLYLINE:
+        case FMRB_LINK_GFX_DRAW_POLYGON:
+        case FMRB_LINK_GFX_FILL_POLYGON:
+        case FMRB_LINK_GFX_DRAW_POINTS:         return sizeof(fmrb_link_graphics_points_t);
+        default:                                return 0;
+    }
+}
+
+// Check that a DEFINE_LIST body is a well-formed sequence of allowed items
+static bool display_list_validate(const uint8_t* data, size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+        if (len - pos < sizeof(fmrb_link_graphics_list_item_t)) {
+            return false;
+        }
+        fmrb_link_graphics_list_item_t item;
+        memcpy(&item, data + pos, sizeof(item));
+        pos += sizeof(item);
+        size_t min_size = display_list_item_min_size(item.cmd_type);
+        if (min_size == 0) {
+            GFX_LOG_E("Command 0x%02x not allowed in a display list", item.cmd_type);
+            return false;
+        }
+        if (item.len < min_size || item.len > len - pos) {
+            return false;
+        }
+        pos += item.len;
+    }
+    return true;
+}
+
+static uint8_t display_list_color(uint8_t color, const display_list_t* list,
+                                  const fmrb_link_graphics_call_list_t* call) {
+    for (int i = 0; i < call->color_count && i < list->slot_count; i++) {
+        if (color == list->slot_colors[i]) {
+            return call->colors[i];
+        }
+    }
+    return color;
+}
+
+// Apply the CALL_LIST canvas, offset and colors to one recorded command in place
+static void display_list_patch(uint8_t cmd_type, uint8_t* item, size_t len, const display_list_t* list,
+                               const fmrb_link_graphics_call_list_t* call) {
+    const int16_t dx = call->dx, dy = call->dy;
+    memcpy(item, &call->canvas_id, sizeof(call->canvas_id));  // Every payload starts with canvas_id
+
+    switch (cmd_type) {
+        case FMRB_LINK_GFX_DRAW_PIXEL: {
+            fmrb_link_graphics_pixel_t* cmd = (fmrb_link_graphics_pixel_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_LINE: {
+            fmrb_link_graphics_line_t* cmd = (fmrb_link_graphics_line_t*)item;
+            cmd->x1 += dx; cmd->y1 += dy;
+            cmd->x2 += dx; cmd->y2 += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_RECT:
+        case FMRB_LINK_GFX_FILL_RECT: {
+            fmrb_link_graphics_rect_t* cmd = (fmrb_link_graphics_rect_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_ROUND_RECT:
+        case FMRB_LINK_GFX_FILL_ROUND_RECT: {
+            fmrb_link_graphics_round_rect_t* cmd = (fmrb_link_graphics_round_rect_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_CIRCLE:
+        case FMRB_LINK_GFX_FILL_CIRCLE: {
+            fmrb_link_graphics_circle_t* cmd = (fmrb_link_graphics_circle_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_ELLIPSE:
+        case FMRB_LINK_GFX_FILL_ELLIPSE: {
+            fmrb_link_graphics_ellipse_t* cmd = (fmrb_link_graphics_ellipse_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_TRIANGLE:
+        case FMRB_LINK_GFX_FILL_TRIANGLE: {
+            fmrb_link_graphics_triangle_t* cmd = (fmrb_link_graphics_triangle_t*)item;
+            cmd->x0 += dx; cmd->y0 += dy;
+            cmd->x1 += dx; cmd->y1 += dy;
+            cmd->x2 += dx; cmd->y2 += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_STRING: {
+            fmrb_link_graphics_text_t* cmd = (fmrb_link_graphics_text_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            cmd->color = display_list_color(cmd->color, list, call);
+            cmd->bg_color = display_list_color(cmd->bg_color, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_STRING_CURRENT: {
+            fmrb_link_graphics_text_current_t* cmd = (fmrb_link_graphics_text_current_t*)item;
+            cmd->x += dx; cmd->y += dy;
+            break;
+        }
+        case FMRB_LINK_GFX_SET_TEXT_COLOR: {
+            fmrb_link_graphics_text_color_t* cmd = (fmrb_link_graphics_text_color_t*)item;
+            bool transparent = (cmd->fg == cmd->bg);
+            cmd->fg = display_list_color(cmd->fg, list, call);
+            cmd->bg = transparent ? cmd->fg : display_list_color(cmd->bg, list, call);
+            break;
+        }
+        case FMRB_LINK_GFX_DRAW_POLYLINE:
+        case FMRB_LINK_GFX_DRAW_POLYGON:
+        case FMRB_LINK_GFX_FILL_POLYGON:
+        case FMRB_LINK_GFX_DRAW_POINTS: {
+            fmrb_link_graphics_points_t* cmd = (fmrb_link_graphics_points_t*)item;
+            cmd->color = display_list_color(cmd->color, list, call);
+            // DELTA8 points are relative to the first one, ABS16 points all move
+            uint16_t moved = (cmd->encoding == FMRB_LINK_GFX_POINTS_ABS16) ? cmd->point_count : 1;
+            uint8_t* p = item + sizeof(fmrb_link_graphics_points_t);
+            for (uint16_t i = 0; i < moved && (size_t)(p + 4 - item) <= len; i++, p += 4) {
+                int16_t x, y;
+                memcpy(&x, p, 2);
+                memcpy(&y, p + 2, 2);
+                x += dx; y += dy;
+                memcpy(p, &x, 2);
+                memcpy(p + 2, &y, 2);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Scratch copy of the item being replayed (lists cannot nest)
+static uint8_t g_list_item[FMRB_LINK_GFX_LIST_MAX_SIZE];
+
+static int display_list_call(const fmrb_link_graphics_call_list_t* call) {
+    canvas_state_t* canvas = canvas_state_find(call->canvas_id);
+    if (!canvas || call->list_id >= FMRB_LINK_GFX_MAX_LISTS) {
+        GFX_LOG_E("CALL_LIST: canvas %u list %u not found", call->canvas_id, call->list_id);
+        return -1;
+    }
+    const display_list_t* list = &canvas->lists[call->list_id];
+    if (!list->data) {
+        GFX_LOG_E("CALL_LIST: canvas %u list %u not defined", call->canvas_id, call->list_id);
+        return -1;
+    }
+
+    size_t pos = 0;
+    while (pos < list->len) {
+        fmrb_link_graphics_list_item_t item;
+        memcpy(&item, list->data + pos, sizeof(item));
+        pos += sizeof(item);
+        memcpy(g_list_item, list->data + pos, item.len);
+        pos += item.len;
 
-// Next canvas ID to allocate
-static uint16_t g_next_canvas_id = 1;
+        display_list_patch(item.cmd_type, g_list_item, item.len, list, call);
+        graphics_handler_process_command(FMRB_LINK_TYPE_GRAPHICS, item.cmd_type, 0, g_list_item, item.len);
+    }
+    return 0;
+}
 
 extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_type, uint8_t seq, const uint8_t *data, size_t size) {
     if (!g_lgfx) {
@@ -353,7 +1495,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                     GFX_LOG_D("CLEAR: Using canvas %u", cmd->canvas_id);
                 }
                 target->fillScreen(cmd->color);
@@ -376,7 +1517,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->drawPixel(cmd->x, cmd->y, cmd->color);
                 return 0;
@@ -397,7 +1537,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->drawLine(cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
                 return 0;
@@ -418,7 +1557,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->drawRect(cmd->x, cmd->y, cmd->width, cmd->height, cmd->color);
                 return 0;
@@ -441,9 +1579,10 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         GFX_LOG_E("Canvas %u not found", cmd->canvas_id);
                         return -1;
                     }
-                    target = canvas->draw_buffer;
-                    canvas->dirty = true;
                     GFX_LOG_D("FILL_RECT: Using canvas %u", cmd->canvas_id);
+                    // Canvas buffers are plain 8-bit rows: fill directly, large fills in bands
+                    canvas_fill_rect(canvas, cmd->x, cmd->y, cmd->width, cmd->height, cmd->color);
+                    return 0;
                 }
                 target->fillRect(cmd->x, cmd->y, cmd->width, cmd->height, cmd->color);
                 GFX_LOG_D("FILL_RECT: fillRect executed");
@@ -464,7 +1603,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->drawRoundRect(cmd->x, cmd->y, cmd->width, cmd->height, cmd->radius, cmd->color);
                 return 0;
@@ -484,7 +1622,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->fillRoundRect(cmd->x, cmd->y, cmd->width, cmd->height, cmd->radius, cmd->color);
                 return 0;
@@ -507,7 +1644,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                     GFX_LOG_D("DRAW_CIRCLE: Using canvas %u", cmd->canvas_id);
                 }
                 target->drawCircle(cmd->x, cmd->y, cmd->radius, cmd->color);
@@ -532,7 +1668,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                     GFX_LOG_D("FILL_CIRCLE: Using canvas %u", cmd->canvas_id);
                 }
                 target->fillCircle(cmd->x, cmd->y, cmd->radius, cmd->color);
@@ -554,7 +1689,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->drawEllipse(cmd->x, cmd->y, cmd->rx, cmd->ry, cmd->color);
                 return 0;
@@ -574,7 +1708,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->fillEllipse(cmd->x, cmd->y, cmd->rx, cmd->ry, cmd->color);
                 return 0;
@@ -594,7 +1727,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->drawTriangle(cmd->x0, cmd->y0, cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
                 return 0;
@@ -614,13 +1746,53 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                 }
                 target->fillTriangle(cmd->x0, cmd->y0, cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
                 return 0;
             }
             break;
 
+        case FMRB_LINK_GFX_DRAW_POLYLINE:
+        case FMRB_LINK_GFX_DRAW_POLYGON:
+        case FMRB_LINK_GFX_FILL_POLYGON:
+        case FMRB_LINK_GFX_DRAW_POINTS:
+            if (size >= sizeof(fmrb_link_graphics_points_t)) {
+                const fmrb_link_graphics_points_t *cmd = (const fmrb_link_graphics_points_t*)data;
+                int count = decode_points(cmd, data + sizeof(fmrb_link_graphics_points_t),
+                                          size - sizeof(fmrb_link_graphics_points_t));
+                if (count < 0) {
+                    GFX_LOG_E("Invalid point list: encoding=%u count=%u size=%zu",
+                              cmd->encoding, cmd->point_count, size);
+                    return -1;
+                }
+                LovyanGFX* target = resolve_draw_target(cmd->canvas_id);
+                if (!target) {
+                    return -1;
+                }
+
+                target->startWrite();
+                if (cmd_type == FMRB_LINK_GFX_DRAW_POINTS) {
+                    for (int i = 0; i < count; i++) {
+                        target->drawPixel(g_points[i].x, g_points[i].y, cmd->color);
+                    }
+                } else {
+                    if (cmd_type == FMRB_LINK_GFX_FILL_POLYGON && count >= 3) {
+                        fill_polygon_scanline(target, g_points, count, cmd->color);
+                    }
+                    for (int i = 1; i < count; i++) {
+                        target->drawLine(g_points[i - 1].x, g_points[i - 1].y,
+                                         g_points[i].x, g_points[i].y, cmd->color);
+                    }
+                    if (cmd_type != FMRB_LINK_GFX_DRAW_POLYLINE && count >= 3) {
+                        target->drawLine(g_points[count - 1].x, g_points[count - 1].y,
+                                         g_points[0].x, g_points[0].y, cmd->color);
+                    }
+                }
+                target->endWrite();
+                return 0;
+            }
+            break;
+
         case FMRB_LINK_GFX_DRAW_STRING:
             // Use structure from fmrb_link_protocol.h (no cmd_type in data)
             if (size < sizeof(fmrb_link_graphics_text_t)) {
@@ -660,7 +1832,6 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                         return -1;
                     }
                     target = canvas->draw_buffer;
-                    canvas->dirty = true;
                     GFX_LOG_D("DRAW_STRING: Using canvas %u", text_cmd->canvas_id);
                 }
 
@@ -679,6 +1850,54 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                 return 0;
             }
 
+        case FMRB_LINK_GFX_DRAW_STRING_CURRENT:
+            if (size >= sizeof(fmrb_link_graphics_text_current_t)) {
+                const fmrb_link_graphics_text_current_t *text_cmd = (const fmrb_link_graphics_text_current_t*)data;
+                if (size < sizeof(fmrb_link_graphics_text_current_t) + text_cmd->text_len) {
+                    GFX_LOG_E("String command size mismatch: actual=%zu, text_len=%u", size, text_cmd->text_len);
+                    break;
+                }
+
+                char text_buf[256];
+                size_t len = text_cmd->text_len < 255 ? text_cmd->text_len : 255;
+                memcpy(text_buf, data + sizeof(fmrb_link_graphics_text_current_t), len);
+                text_buf[len] = '\0';
+
+                // Text color is whatever the canvas was last given
+                LovyanGFX* target = resolve_draw_target(text_cmd->canvas_id);
+                if (!target) {
+                    return -1;
+                }
+                target->setCursor(text_cmd->x, text_cmd->y);
+                target->print(text_buf);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SET_TEXT_COLOR:
+            if (size >= sizeof(fmrb_link_graphics_text_color_t)) {
+                const fmrb_link_graphics_text_color_t *cmd = (const fmrb_link_graphics_text_color_t*)data;
+                LovyanGFX* target = resolve_draw_target(cmd->canvas_id);
+                if (!target) {
+                    return -1;
+                }
+                target->setTextColor(cmd->fg, cmd->bg);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SET_TEXT_SIZE:
+            if (size >= sizeof(fmrb_link_graphics_text_size_t)) {
+                const fmrb_link_graphics_text_size_t *cmd = (const fmrb_link_graphics_text_size_t*)data;
+                LovyanGFX* target = resolve_draw_target(cmd->canvas_id);
+                if (!target) {
+                    return -1;
+                }
+                target->setTextSize(cmd->size);
+                return 0;
+            }
+            break;
+
         // case FMRB_LINK_GFX_PRESENT:
         //     if (size >= sizeof(fmrb_link_graphics_present_t)) {
         //         const fmrb_link_graphics_present_t *cmd = (const fmrb_link_graphics_present_t*)data;
@@ -713,22 +1932,20 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                 const fmrb_link_graphics_create_canvas_t *cmd = (const fmrb_link_graphics_create_canvas_t*)data;
 
                 // Allocate new canvas ID (ignore cmd->canvas_id from client)
-                uint16_t canvas_id = g_next_canvas_id++;
-                if (canvas_id == 0xFFFF) {  // FMRB_CANVAS_INVALID
-                    canvas_id = g_next_canvas_id++;  // Skip invalid value
+                uint16_t canvas_id = canvas_id_alloc();
+                if (canvas_id == FMRB_CANVAS_INVALID) {
+                    GFX_LOG_E("No free canvas ID");
+                    return -1;
                 }
 
                 // Allocate canvas state
-                canvas_state_t* canvas = canvas_state_alloc(canvas_id, cmd->width, cmd->height);
+                canvas_state_t* canvas = canvas_state_alloc(canvas_id, cmd->width, cmd->height, cmd->z_order);
                 if (!canvas) {
                     GFX_LOG_E("Failed to allocate canvas %u (%dx%d)",
                             canvas_id, cmd->width, cmd->height);
                     return -1;
                 }
 
-                // Override z_order with value from Core
-                canvas->z_order = cmd->z_order;
-
                 GFX_LOG_I("Canvas created: ID=%u, %dx%d, z_order=%d", canvas_id, cmd->width, cmd->height, cmd->z_order);
 
                 // Send ACK with canvas_id
@@ -768,8 +1985,11 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                     return -1;
                 }
 
-                // Update z_order
+                // Update z_order and move the canvas to its new place in the z-order index
+                zorder_remove(canvas);
                 canvas->z_order = cmd->z_order;
+                zorder_insert(canvas);
+                canvas->dirty = true;
                 GFX_LOG_I("Canvas %u z_order updated to %d", cmd->canvas_id, cmd->z_order);
                 return 0;
             }
@@ -792,22 +2012,107 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                 canvas->push_x = cmd->x;
                 canvas->push_y = cmd->y;
 
+                if (cmd->width <= 0 || cmd->height <= 0 ||
+                    cmd->width > MAX_SCREEN_WIDTH || cmd->height > MAX_SCREEN_HEIGHT) {
+                    GFX_LOG_E("UPDATE_WINDOW: invalid size %dx%d for canvas %u",
+                              cmd->width, cmd->height, cmd->canvas_id);
+                    return -1;
+                }
+
+                // Keep the drawn content in place so the app only repaints what the resize exposed.
+                // Buffers move to a larger pool class only when the new area does not fit; they never shrink.
+                if ((size_t)cmd->width * cmd->height > canvas->buffer_size) {
+                    size_t needed = (size_t)cmd->width * cmd->height;
+                    size_t new_size = 0, render_size = 0;
+                    uint8_t* draw_mem = (uint8_t*)pool_get(needed, &new_size);
+                    uint8_t* render_mem = (uint8_t*)pool_get(needed, &render_size);
+                    if (!draw_mem || !render_mem) {
+                        GFX_LOG_E("UPDATE_WINDOW: failed to grow canvas %u to %dx%d",
+                                  cmd->canvas_id, cmd->width, cmd->height);
+                        pool_put(draw_mem, new_size);
+                        pool_put(render_mem, render_size);
+                        return -1;
+                    }
+                    canvas_buffer_copy(draw_mem, (const uint8_t*)canvas->draw_buffer_mem,
+                                       canvas->active_width, canvas->active_height, cmd->width, cmd->height);
+                    canvas_buffer_copy(render_mem, (const uint8_t*)canvas->render_buffer_mem,
+                                       canvas->active_width, canvas->active_height, cmd->width, cmd->height);
+                    pool_put(canvas->draw_buffer_mem, canvas->buffer_size);
+                    pool_put(canvas->render_buffer_mem, canvas->buffer_size);
+                    canvas->draw_buffer_mem = draw_mem;
+                    canvas->render_buffer_mem = render_mem;
+                    canvas->buffer_size = new_size;
+                } else if (cmd->width != canvas->active_width || cmd->height != canvas->active_height) {
+                    canvas_reflow((uint8_t*)canvas->draw_buffer_mem, canvas->active_width, canvas->active_height,
+                                  cmd->width, cmd->height);
+                    canvas_reflow((uint8_t*)canvas->render_buffer_mem, canvas->active_width, canvas->active_height,
+                                  cmd->width, cmd->height);
+                }
+
                 // Update active size by calling setBuffer with new dimensions
-                // This reuses the same external memory buffer with new width/height
                 canvas->active_width = (uint16_t)cmd->width;
                 canvas->active_height = (uint16_t)cmd->height;
 
-                // Reconfigure sprites with new dimensions (reusing same memory buffers)
+                // Reconfigure sprites with new dimensions
                 canvas->draw_buffer->setBuffer(canvas->draw_buffer_mem,
                                               canvas->active_width, canvas->active_height, 8);
                 canvas->render_buffer->setBuffer(canvas->render_buffer_mem,
                                                 canvas->active_width, canvas->active_height, 8);
 
-                GFX_LOG_I("Canvas %u resized to %dx%d using setBuffer (allocated: %dx%d)",
+                GFX_LOG_I("Canvas %u resized to %dx%d using setBuffer (allocated: 2x%zu bytes)",
                           cmd->canvas_id, canvas->active_width, canvas->active_height,
-                          canvas->width, canvas->height);
+                          canvas->buffer_size);
+
+                canvas->dirty = true;
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SET_WINDOW_FRAME:
+            if (size >= sizeof(fmrb_link_graphics_window_frame_t)) {
+                const fmrb_link_graphics_window_frame_t *cmd = (const fmrb_link_graphics_window_frame_t*)data;
+                if (cmd->title_len > FMRB_LINK_GFX_FRAME_TITLE_MAX ||
+                    size < sizeof(*cmd) + cmd->title_len) {
+                    GFX_LOG_E("SET_WINDOW_FRAME: bad title length %u", cmd->title_len);
+                    return -1;
+                }
+
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas) {
+                    GFX_LOG_E("Canvas %u not found for SET_WINDOW_FRAME", cmd->canvas_id);
+                    return -1;
+                }
+
+                canvas->frame_style = cmd->style;
+                canvas->frame_flags = cmd->flags;
+                memcpy(canvas->title, data + sizeof(*cmd), cmd->title_len);
+                canvas->title[cmd->title_len] = '\0';
+                canvas->dirty = true;
+                GFX_LOG_I("Canvas %u frame: style=%u, flags=0x%02x, title='%s'",
+                          cmd->canvas_id, cmd->style, cmd->flags, canvas->title);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SET_WINDOW_TITLE:
+            if (size >= sizeof(fmrb_link_graphics_window_title_t)) {
+                const fmrb_link_graphics_window_title_t *cmd = (const fmrb_link_graphics_window_title_t*)data;
+                if (cmd->title_len > FMRB_LINK_GFX_FRAME_TITLE_MAX ||
+                    size < sizeof(*cmd) + cmd->title_len) {
+                    GFX_LOG_E("SET_WINDOW_TITLE: bad title length %u", cmd->title_len);
+                    return -1;
+                }
+
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas) {
+                    GFX_LOG_E("Canvas %u not found for SET_WINDOW_TITLE", cmd->canvas_id);
+                    return -1;
+                }
 
+                memcpy(canvas->title, data + sizeof(*cmd), cmd->title_len);
+                canvas->title[cmd->title_len] = '\0';
                 canvas->dirty = true;
+                GFX_LOG_D("Canvas %u title: '%s'", cmd->canvas_id, canvas->title);
                 return 0;
             }
             break;
@@ -835,6 +2140,11 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
             if (size >= sizeof(fmrb_link_graphics_push_canvas_t)) {
                 const fmrb_link_graphics_push_canvas_t *cmd = (const fmrb_link_graphics_push_canvas_t*)data;
 
+                // Counted on receipt so the total stays in step with the core's count
+                if (cmd->dest_canvas_id == FMRB_CANVAS_RENDER) {
+                    g_render_pushes++;
+                }
+
                 // Find source canvas
                 canvas_state_t* src_canvas = canvas_state_find(cmd->canvas_id);
                 if (!src_canvas) {
@@ -850,6 +2160,7 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                     dst_name = "render_canvas";
                     src_canvas->push_x = cmd->x;
                     src_canvas->push_y = cmd->y;
+                    src_canvas->dirty = true;
                 } else if(cmd->dest_canvas_id == 0) {
                     dst = g_lgfx;
                     dst_name = "screen";
@@ -868,16 +2179,352 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
                 GFX_LOG_D("PUSH_CANVAS: src=%p (active=%dx%d), dst=%p (%s), pos=(%d,%d)",
                        src_sprite, src_canvas->active_width, src_canvas->active_height, dst, dst_name, cmd->x, cmd->y);
 
+                // Tile layers go under the draw buffer, which is then keyed with the canvas tile key
+                if (cmd->dest_canvas_id == FMRB_CANVAS_RENDER && canvas_has_tile_layers(src_canvas)) {
+                    canvas_compose_tile_layers(src_canvas);
+                    if (src_canvas->tile_key != 0xFF) {
+                        canvas_blit(src_canvas, src_canvas->tile_key);
+                    }
+                    GFX_LOG_D("Canvas pushed over tile layers: ID=%u, key=0x%02x",
+                           cmd->canvas_id, src_canvas->tile_key);
+                    return 0;
+                }
+
                 // Since setBuffer configures sprite to active size, pushSprite transfers only active region
-                if (cmd->use_transparency) {
-                    src_sprite->pushSprite(dst, 0, 0, cmd->transparent_color);
+                if (cmd->use_transparency && cmd->dest_canvas_id == FMRB_CANVAS_RENDER) {
+                    canvas_blit(src_canvas, cmd->transparent_color);
                     GFX_LOG_D("Canvas pushed with transparency: ID=%u to render_buffer, transp=0x%02x",
                            cmd->canvas_id, cmd->transparent_color);
+                } else if (cmd->use_transparency) {
+                    src_sprite->pushSprite(dst, 0, 0, cmd->transparent_color);
+                    GFX_LOG_D("Canvas pushed with transparency: ID=%u to %s, transp=0x%02x",
+                           cmd->canvas_id, dst_name, cmd->transparent_color);
+                } else if (cmd->dest_canvas_id == FMRB_CANVAS_RENDER) {
+                    canvas_blit(src_canvas, -1);
+                    GFX_LOG_D("Canvas pushed: ID=%u to render_buffer", cmd->canvas_id);
                 } else {
                     src_sprite->pushSprite(dst, 0, 0);
-                    GFX_LOG_D("Canvas pushed: ID=%u to render_buffer", cmd->canvas_id);
+                    GFX_LOG_D("Canvas pushed: ID=%u to %s", cmd->canvas_id, dst_name);
+                }
+
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_COPY_RECT:
+            if (size >= sizeof(fmrb_link_graphics_copy_rect_t)) {
+                const fmrb_link_graphics_copy_rect_t *cmd = (const fmrb_link_graphics_copy_rect_t*)data;
+
+                if (cmd->src_canvas_id == cmd->dst_canvas_id) {
+                    // Same surface: LovyanGFX copyRect clips and handles overlap
+                    LovyanGFX* target = resolve_draw_target(cmd->src_canvas_id);
+                    if (!target) {
+                        return -1;
+                    }
+                    target->copyRect(cmd->dst_x, cmd->dst_y, cmd->width, cmd->height, cmd->src_x, cmd->src_y);
+                    return 0;
+                }
+
+                // Between canvases: copy rows of the RGB332 draw buffers directly
+                canvas_state_t* src = canvas_state_find(cmd->src_canvas_id);
+                canvas_state_t* dst = canvas_state_find(cmd->dst_canvas_id);
+                if (!src || !dst) {
+                    GFX_LOG_E("COPY_RECT: canvas %u or %u not found", cmd->src_canvas_id, cmd->dst_canvas_id);
+                    return -1;
+                }
+
+                int sx = cmd->src_x, sy = cmd->src_y;
+                int dx = cmd->dst_x, dy = cmd->dst_y;
+                int w = cmd->width, h = cmd->height;
+                if (sx < 0) { w += sx; dx -= sx; sx = 0; }
+                if (sy < 0) { h += sy; dy -= sy; sy = 0; }
+                if (dx < 0) { w += dx; sx -= dx; dx = 0; }
+                if (dy < 0) { h += dy; sy -= dy; dy = 0; }
+                if (w > src->active_width - sx) w = src->active_width - sx;
+                if (w > dst->active_width - dx) w = dst->active_width - dx;
+                if (h > src->active_height - sy) h = src->active_height - sy;
+                if (h > dst->active_height - dy) h = dst->active_height - dy;
+                if (w > 0 && h > 0) {
+                    const uint8_t* src_mem = (const uint8_t*)src->draw_buffer_mem;
+                    uint8_t* dst_mem = (uint8_t*)dst->draw_buffer_mem;
+                    for (int row = 0; row < h; row++) {
+                        memcpy(dst_mem + (size_t)(dy + row) * dst->active_width + dx,
+                               src_mem + (size_t)(sy + row) * src->active_width + sx, w);
+                    }
+                }
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SCROLL_RECT:
+            if (size >= sizeof(fmrb_link_graphics_scroll_rect_t)) {
+                const fmrb_link_graphics_scroll_rect_t *cmd = (const fmrb_link_graphics_scroll_rect_t*)data;
+                LovyanGFX* target = resolve_draw_target(cmd->canvas_id);
+                if (!target) {
+                    return -1;
                 }
 
+                const int x = cmd->x, y = cmd->y, w = cmd->width, h = cmd->height;
+                const int dx = cmd->dx, dy = cmd->dy;
+                const int adx = dx < 0 ? -dx : dx;
+                const int ady = dy < 0 ? -dy : dy;
+                if (adx >= w || ady >= h) {
+                    target->fillRect(x, y, w, h, cmd->fill_color);
+                    return 0;
+                }
+
+                // Move the part that stays inside the region, then fill what was uncovered
+                target->startWrite();
+                target->copyRect(x + (dx > 0 ? dx : 0), y + (dy > 0 ? dy : 0), w - adx, h - ady,
+                                 x + (dx < 0 ? adx : 0), y + (dy < 0 ? ady : 0));
+                if (dx > 0) target->fillRect(x, y, dx, h, cmd->fill_color);
+                if (dx < 0) target->fillRect(x + w - adx, y, adx, h, cmd->fill_color);
+                if (dy > 0) target->fillRect(x, y, w, dy, cmd->fill_color);
+                if (dy < 0) target->fillRect(x, y + h - ady, w, ady, cmd->fill_color);
+                target->endWrite();
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_DEFINE_LIST:
+            if (size >= sizeof(fmrb_link_graphics_define_list_t)) {
+                const fmrb_link_graphics_define_list_t *cmd = (const fmrb_link_graphics_define_list_t*)data;
+                const uint8_t* items = data + sizeof(fmrb_link_graphics_define_list_t);
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas) {
+                    GFX_LOG_E("Canvas %u not found", cmd->canvas_id);
+                    return -1;
+                }
+                if (cmd->list_id >= FMRB_LINK_GFX_MAX_LISTS || cmd->slot_count > FMRB_LINK_GFX_LIST_MAX_SLOTS ||
+                    cmd->data_len > FMRB_LINK_GFX_LIST_MAX_SIZE ||
+                    size < sizeof(fmrb_link_graphics_define_list_t) + cmd->data_len ||
+                    !display_list_validate(items, cmd->data_len)) {
+                    GFX_LOG_E("DEFINE_LIST: invalid list %u (len=%u)", cmd->list_id, cmd->data_len);
+                    return -1;
+                }
+
+                uint8_t* copy = (uint8_t*)malloc(cmd->data_len > 0 ? cmd->data_len : 1);
+                if (!copy) {
+                    GFX_LOG_E("Failed to allocate display list (%u bytes)", cmd->data_len);
+                    return -1;
+                }
+                memcpy(copy, items, cmd->data_len);
+
+                display_list_t* list = &canvas->lists[cmd->list_id];
+                free(list->data);
+                list->data = copy;
+                list->len = cmd->data_len;
+                list->slot_count = cmd->slot_count;
+                memcpy(list->slot_colors, cmd->slot_colors, sizeof(list->slot_colors));
+                GFX_LOG_D("DEFINE_LIST: canvas=%u id=%u len=%u slots=%u",
+                          cmd->canvas_id, cmd->list_id, cmd->data_len, cmd->slot_count);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_CALL_LIST:
+            if (size >= sizeof(fmrb_link_graphics_call_list_t)) {
+                return display_list_call((const fmrb_link_graphics_call_list_t*)data);
+            }
+            break;
+
+        case FMRB_LINK_GFX_DELETE_LIST:
+            if (size >= sizeof(fmrb_link_graphics_delete_list_t)) {
+                const fmrb_link_graphics_delete_list_t *cmd = (const fmrb_link_graphics_delete_list_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || cmd->list_id >= FMRB_LINK_GFX_MAX_LISTS) {
+                    return -1;
+                }
+                free(canvas->lists[cmd->list_id].data);
+                memset(&canvas->lists[cmd->list_id], 0, sizeof(display_list_t));
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SET_PALETTE:
+            if (size >= sizeof(fmrb_link_graphics_set_palette_t)) {
+                const fmrb_link_graphics_set_palette_t *cmd = (const fmrb_link_graphics_set_palette_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas) {
+                    GFX_LOG_E("Canvas %u not found for SET_PALETTE", cmd->canvas_id);
+                    return -1;
+                }
+
+                if (!cmd->indexed) {
+                    free(canvas->palette);
+                    canvas->palette = nullptr;
+                    canvas->dirty = true;
+                    GFX_LOG_I("Canvas %u switched to direct color", cmd->canvas_id);
+                    return 0;
+                }
+
+                if (size < sizeof(fmrb_link_graphics_set_palette_t) + FMRB_LINK_GFX_PALETTE_SIZE) {
+                    break;
+                }
+                if (!canvas->palette) {
+                    canvas->palette = (uint8_t*)malloc(FMRB_LINK_GFX_PALETTE_SIZE);
+                    if (!canvas->palette) {
+                        GFX_LOG_E("Failed to allocate palette for canvas %u", cmd->canvas_id);
+                        return -1;
+                    }
+                }
+                memcpy(canvas->palette, data + sizeof(fmrb_link_graphics_set_palette_t), FMRB_LINK_GFX_PALETTE_SIZE);
+                canvas->dirty = true;
+                GFX_LOG_I("Canvas %u switched to indexed color", cmd->canvas_id);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_SET_PALETTE_RANGE:
+            if (size >= sizeof(fmrb_link_graphics_set_palette_range_t)) {
+                const fmrb_link_graphics_set_palette_range_t *cmd = (const fmrb_link_graphics_set_palette_range_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || !canvas->palette) {
+                    GFX_LOG_E("Canvas %u not found or not indexed for SET_PALETTE_RANGE", cmd->canvas_id);
+                    return -1;
+                }
+                if (cmd->start + cmd->count > FMRB_LINK_GFX_PALETTE_SIZE ||
+                    size < sizeof(fmrb_link_graphics_set_palette_range_t) + cmd->count) {
+                    break;
+                }
+                memcpy(canvas->palette + cmd->start, data + sizeof(fmrb_link_graphics_set_palette_range_t), cmd->count);
+                canvas->dirty = true;
+                GFX_LOG_D("Canvas %u palette[%u..%u] updated", cmd->canvas_id,
+                          cmd->start, cmd->start + cmd->count - 1);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_TILEMAP_CREATE:
+            if (size >= sizeof(fmrb_link_graphics_tilemap_create_t)) {
+                const fmrb_link_graphics_tilemap_create_t *cmd = (const fmrb_link_graphics_tilemap_create_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || cmd->layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS ||
+                    cmd->tile_w == 0 || cmd->tile_h == 0 || cmd->map_w == 0 || cmd->map_h == 0) {
+                    GFX_LOG_E("TILEMAP_CREATE: invalid canvas %u / layer %u", cmd->canvas_id, cmd->layer);
+                    return -1;
+                }
+
+                tile_layer_t* layer = &canvas->tile_layers[cmd->layer];
+                tile_layer_free(layer);
+                layer->map = (uint8_t*)malloc((size_t)cmd->map_w * cmd->map_h);
+                if (!layer->map) {
+                    GFX_LOG_E("TILEMAP_CREATE: failed to allocate %ux%u map", cmd->map_w, cmd->map_h);
+                    return -1;
+                }
+                memset(layer->map, FMRB_LINK_GFX_TILE_EMPTY, (size_t)cmd->map_w * cmd->map_h);
+                layer->tile_w = cmd->tile_w;
+                layer->tile_h = cmd->tile_h;
+                layer->map_w = cmd->map_w;
+                layer->map_h = cmd->map_h;
+                layer->active = true;
+                canvas->tile_key = cmd->transparent_color;
+
+                GFX_LOG_I("Tile layer created: canvas=%u layer=%u tile=%ux%u map=%ux%u key=0x%02x",
+                          cmd->canvas_id, cmd->layer, cmd->tile_w, cmd->tile_h,
+                          cmd->map_w, cmd->map_h, cmd->transparent_color);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_TILEMAP_DELETE:
+            if (size >= sizeof(fmrb_link_graphics_tilemap_delete_t)) {
+                const fmrb_link_graphics_tilemap_delete_t *cmd = (const fmrb_link_graphics_tilemap_delete_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || cmd->layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS) {
+                    GFX_LOG_E("TILEMAP_DELETE: invalid canvas %u / layer %u", cmd->canvas_id, cmd->layer);
+                    return -1;
+                }
+                tile_layer_free(&canvas->tile_layers[cmd->layer]);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_TILEMAP_SET_SHEET:
+            if (size >= sizeof(fmrb_link_graphics_tilemap_sheet_t)) {
+                const fmrb_link_graphics_tilemap_sheet_t *cmd = (const fmrb_link_graphics_tilemap_sheet_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || cmd->layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS ||
+                    !canvas->tile_layers[cmd->layer].active) {
+                    GFX_LOG_E("TILEMAP_SET_SHEET: no layer %u on canvas %u", cmd->layer, cmd->canvas_id);
+                    return -1;
+                }
+
+                tile_layer_t* layer = &canvas->tile_layers[cmd->layer];
+                size_t sheet_size = (size_t)cmd->sheet_w * cmd->sheet_h;
+                if (size < sizeof(fmrb_link_graphics_tilemap_sheet_t) + cmd->length ||
+                    (size_t)cmd->offset + cmd->length > sheet_size ||
+                    cmd->sheet_w < layer->tile_w || cmd->sheet_h < layer->tile_h) {
+                    GFX_LOG_E("TILEMAP_SET_SHEET: bad chunk offset=%u length=%u sheet=%ux%u",
+                              cmd->offset, cmd->length, cmd->sheet_w, cmd->sheet_h);
+                    return -1;
+                }
+
+                // First chunk (re)allocates the sheet
+                if (cmd->offset == 0) {
+                    if (!layer->sheet || layer->sheet_w != cmd->sheet_w || layer->sheet_h != cmd->sheet_h) {
+                        free(layer->sheet);
+                        layer->sheet = (uint8_t*)malloc(sheet_size);
+                        if (!layer->sheet) {
+                            GFX_LOG_E("TILEMAP_SET_SHEET: failed to allocate %ux%u sheet",
+                                      cmd->sheet_w, cmd->sheet_h);
+                            layer->sheet_w = layer->sheet_h = 0;
+                            return -1;
+                        }
+                        layer->sheet_w = cmd->sheet_w;
+                        layer->sheet_h = cmd->sheet_h;
+                    }
+                } else if (!layer->sheet || layer->sheet_w != cmd->sheet_w || layer->sheet_h != cmd->sheet_h) {
+                    GFX_LOG_E("TILEMAP_SET_SHEET: chunk at %u without a matching first chunk", cmd->offset);
+                    return -1;
+                }
+
+                memcpy(layer->sheet + cmd->offset, data + sizeof(fmrb_link_graphics_tilemap_sheet_t), cmd->length);
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_TILEMAP_SET_CELLS:
+            if (size >= sizeof(fmrb_link_graphics_tilemap_cells_t)) {
+                const fmrb_link_graphics_tilemap_cells_t *cmd = (const fmrb_link_graphics_tilemap_cells_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || cmd->layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS ||
+                    !canvas->tile_layers[cmd->layer].active) {
+                    GFX_LOG_E("TILEMAP_SET_CELLS: no layer %u on canvas %u", cmd->layer, cmd->canvas_id);
+                    return -1;
+                }
+                if (size < sizeof(fmrb_link_graphics_tilemap_cells_t) + (size_t)cmd->w * cmd->h) {
+                    break;
+                }
+
+                // Clip the rectangle to the map
+                tile_layer_t* layer = &canvas->tile_layers[cmd->layer];
+                const uint8_t* cells = data + sizeof(fmrb_link_graphics_tilemap_cells_t);
+                for (uint16_t row = 0; row < cmd->h && cmd->y + row < layer->map_h; row++) {
+                    if (cmd->x >= layer->map_w) {
+                        break;
+                    }
+                    uint16_t count = cmd->w;
+                    if (cmd->x + count > layer->map_w) {
+                        count = layer->map_w - cmd->x;
+                    }
+                    memcpy(layer->map + (size_t)(cmd->y + row) * layer->map_w + cmd->x,
+                           cells + (size_t)row * cmd->w, count);
+                }
+                return 0;
+            }
+            break;
+
+        case FMRB_LINK_GFX_TILEMAP_SCROLL:
+            if (size >= sizeof(fmrb_link_graphics_tilemap_scroll_t)) {
+                const fmrb_link_graphics_tilemap_scroll_t *cmd = (const fmrb_link_graphics_tilemap_scroll_t*)data;
+                canvas_state_t* canvas = canvas_state_find(cmd->canvas_id);
+                if (!canvas || cmd->layer >= FMRB_LINK_GFX_MAX_TILE_LAYERS) {
+                    GFX_LOG_E("TILEMAP_SCROLL: invalid canvas %u / layer %u", cmd->canvas_id, cmd->layer);
+                    return -1;
+                }
+                canvas->tile_layers[cmd->layer].scroll_x = cmd->scroll_x;
+                canvas->tile_layers[cmd->layer].scroll_y = cmd->scroll_y;
                 return 0;
             }
             break;
@@ -885,9 +2532,19 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
         case FMRB_LINK_GFX_CURSOR_SET_POSITION:
             if (size >= sizeof(fmrb_link_graphics_cursor_position_t)) {
                 const fmrb_link_graphics_cursor_position_t *cmd = (const fmrb_link_graphics_cursor_position_t*)data;
+
+                // A position the pointer recently had is the core echoing our own input:
+                // measure it, but keep the locally tracked position
+                uint64_t stamp = input_handler_find_motion(cmd->x, cmd->y);
+                if (stamp != 0) {
+                    g_core_pending = stamp;
+                    return 0;
+                }
+
                 g_cursor_x = cmd->x;
                 g_cursor_y = cmd->y;
-                GFX_LOG_D("Cursor position updated: (%d, %d)", g_cursor_x, g_cursor_y);
+                g_cursor_changed = true;
+                GFX_LOG_D("Cursor warped: (%d, %d)", g_cursor_x, g_cursor_y);
                 return 0;
             }
             break;
@@ -901,6 +2558,25 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
             }
             break;
 
+        case FMRB_LINK_GFX_CURSOR_SET_SHAPE:
+            if (size >= sizeof(fmrb_link_graphics_cursor_shape_t)) {
+                const fmrb_link_graphics_cursor_shape_t *cmd = (const fmrb_link_graphics_cursor_shape_t*)data;
+                if (cmd->shape >= FMRB_LINK_GFX_CURSOR_SHAPES) {
+                    GFX_LOG_E("Unknown cursor shape %u", cmd->shape);
+                    return -1;
+                }
+                if (cmd->shape != g_cursor_shape) {
+                    g_cursor_shape = cmd->shape;
+                    g_cursor_changed = true;
+                    if (g_cursor_sprite) {
+                        cursor_sprite_draw(g_cursor_shape);
+                    }
+                }
+                GFX_LOG_D("Cursor shape updated: %u", g_cursor_shape);
+                return 0;
+            }
+            break;
+
         default:
             GFX_LOG_E("Unknown graphics command: 0x%02x", cmd_type);
             return -1;
@@ -909,3 +2585,33 @@ extern "C" int graphics_handler_process_command(uint8_t msg_type, uint8_t cmd_ty
     GFX_LOG_E("Invalid command size for type 0x%02x (size=%zu)", cmd_type, size);
     return -1;
 }
+
+extern "C" int graphics_handler_frame_pending(void) {
+    if (g_damage_count > 0 || g_cursor_changed || g_cursor_visible != g_cursor_shown) {
+        return 1;
+    }
+    for (size_t i = 0; i < g_canvas_count; i++) {
+        if (g_zorder[i]->dirty) {
+            return 1;
+        }
+    }
+    int x, y;
+    uint64_t stamp;
+    return input_handler_get_cursor(&x, &y, &stamp) == 0 && stamp != 0 && stamp != g_cursor_stamp;
+}
+
+extern "C" void graphics_handler_frame_done(void) {
+    g_frame_count++;
+    if (g_render_pushes == g_render_pushes_notified) {
+        return;  // Nothing new on screen for the core to hear about
+    }
+
+    fmrb_link_graphics_frame_done_t done = {
+        .frame = g_frame_count,
+        .render_pushes = g_render_pushes
+    };
+    if (socket_server_send_message(FMRB_LINK_TYPE_GRAPHICS, FMRB_LINK_GFX_FRAME_DONE,
+                                   (const uint8_t*)&done, sizeof(done)) == 0) {
+        g_render_pushes_notified = g_render_pushes;
+    }
+}
@@ -1,5 +1,6 @@
 #include "input_handler.h"
 #include "input_socket.h"
+#include "socket_server.h"
 #include <SDL2/SDL.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -25,9 +26,47 @@ void input_handler_set_log_level(int level) {
 }
 
 static bool g_initialized = false;
+static input_point_map_t g_point_map = NULL;
 static int g_last_mouse_x = 0;
 static int g_last_mouse_y = 0;
 
+// Pointer state is written by the SDL event watch and read by the render loop
+static SDL_SpinLock g_motion_lock = 0;
+static uint64_t g_last_motion_stamp = 0;  // SDL performance counter at the last motion, 0 = none yet
+
+// Recent motion positions, so a position echoed back by the core can be traced to its input
+#define MOTION_HISTORY_SIZE 32
+typedef struct {
+    int x, y;
+    uint64_t stamp;
+} motion_sample_t;
+static motion_sample_t g_motion_history[MOTION_HISTORY_SIZE];
+static int g_motion_head = 0;
+
+static void record_motion(int x, int y) {
+    uint64_t stamp = SDL_GetPerformanceCounter();
+    SDL_AtomicLock(&g_motion_lock);
+    g_last_mouse_x = x;
+    g_last_mouse_y = y;
+    g_last_motion_stamp = stamp;
+    g_motion_history[g_motion_head].x = x;
+    g_motion_history[g_motion_head].y = y;
+    g_motion_history[g_motion_head].stamp = stamp;
+    g_motion_head = (g_motion_head + 1) % MOTION_HISTORY_SIZE;
+    SDL_AtomicUnlock(&g_motion_lock);
+}
+
+void input_handler_set_point_map(input_point_map_t map) {
+    g_point_map = map;
+}
+
+// Window coordinates to screen pixels (identity until a mapping is set)
+static void map_point(int* x, int* y) {
+    if (g_point_map) {
+        g_point_map(x, y);
+    }
+}
+
 // Event watch callback - called before SDL_PollEvent consumes events
 static int event_watch_callback(void* userdata, SDL_Event* event) {
     (void)userdata;  // Unused
@@ -68,8 +107,11 @@ static int event_watch_callback(void* userdata, SDL_Event* event) {
                 hid_mouse_button_event_t mouse_event;
                 mouse_event.button = event->button.button;
                 mouse_event.state = 1;  // pressed
-                mouse_event.x = (uint16_t)event->button.x;
-                mouse_event.y = (uint16_t)event->button.y;
+                int x = event->button.x;
+                int y = event->button.y;
+                map_point(&x, &y);
+                mouse_event.x = (uint16_t)x;
+                mouse_event.y = (uint16_t)y;
                 input_socket_send_event(HID_EVENT_MOUSE_BUTTON, &mouse_event, sizeof(mouse_event));
             }
             break;
@@ -81,34 +123,44 @@ static int event_watch_callback(void* userdata, SDL_Event* event) {
                 hid_mouse_button_event_t mouse_event;
                 mouse_event.button = event->button.button;
                 mouse_event.state = 0;  // released
-                mouse_event.x = (uint16_t)event->button.x;
-                mouse_event.y = (uint16_t)event->button.y;
+                int x = event->button.x;
+                int y = event->button.y;
+                map_point(&x, &y);
+                mouse_event.x = (uint16_t)x;
+                mouse_event.y = (uint16_t)y;
                 input_socket_send_event(HID_EVENT_MOUSE_BUTTON, &mouse_event, sizeof(mouse_event));
             }
             break;
 
         case SDL_MOUSEMOTION:
-            // Update current mouse position
-            g_last_mouse_x = event->motion.x;
-            g_last_mouse_y = event->motion.y;
-
-            // Mouse motion events are very frequent (100+ events/sec when moving)
-            // Only log occasionally for debugging
-            static int motion_count = 0;
-            if (++motion_count % 60 == 0) {  // Log every 60th event
-                // INPUT_LOG_D("Mouse moved to (%d, %d)", event->motion.x, event->motion.y);
-            }
-            // Send to Core with throttling (every 10th event to reduce bandwidth)
-            if (motion_count % 10 == 0) {
-                hid_mouse_motion_event_t motion_event;
-                motion_event.x = (uint16_t)event->motion.x;
-                motion_event.y = (uint16_t)event->motion.y;
-                input_socket_send_event(HID_EVENT_MOUSE_MOTION, &motion_event, sizeof(motion_event));
+            {
+                int x = event->motion.x;
+                int y = event->motion.y;
+                map_point(&x, &y);
+
+                // Update current mouse position (the cursor follows it locally, see graphics_handler)
+                record_motion(x, y);
+                socket_server_wake();  // Let the host loop draw the cursor without waiting for a timeout
+
+                // Mouse motion events are very frequent (100+ events/sec when moving)
+                // Only log occasionally for debugging
+                static int motion_count = 0;
+                if (++motion_count % 60 == 0) {  // Log every 60th event
+                    // INPUT_LOG_D("Mouse moved to (%d, %d)", x, y);
+                }
+                // Send to Core with throttling (every 10th event to reduce bandwidth)
+                if (motion_count % 10 == 0) {
+                    hid_mouse_motion_event_t motion_event;
+                    motion_event.x = (uint16_t)x;
+                    motion_event.y = (uint16_t)y;
+                    input_socket_send_event(HID_EVENT_MOUSE_MOTION, &motion_event, sizeof(motion_event));
+                }
             }
             break;
 
         case SDL_QUIT:
             INPUT_LOG_I("SDL_QUIT event received");
+            socket_server_wake();
             break;
 
         default:
@@ -171,7 +223,39 @@ int input_handler_get_mouse_position(int* x, int* y) {
         return -1;
     }
 
+    SDL_AtomicLock(&g_motion_lock);
     *x = g_last_mouse_x;
     *y = g_last_mouse_y;
+    SDL_AtomicUnlock(&g_motion_lock);
     return 0;
 }
+
+int input_handler_get_cursor(int* x, int* y, uint64_t* stamp) {
+    if (!g_initialized || x == NULL || y == NULL || stamp == NULL) {
+        return -1;
+    }
+
+    SDL_AtomicLock(&g_motion_lock);
+    *x = g_last_mouse_x;
+    *y = g_last_mouse_y;
+    *stamp = g_last_motion_stamp;
+    SDL_AtomicUnlock(&g_motion_lock);
+    return 0;
+}
+
+uint64_t input_handler_find_motion(int x, int y) {
+    uint64_t stamp = 0;
+
+    SDL_AtomicLock(&g_motion_lock);
+    // Newest first, so a position visited twice maps to its latest input
+    for (int i = 1; i <= MOTION_HISTORY_SIZE; i++) {
+        const motion_sample_t* sample =
+            &g_motion_history[(g_motion_head - i + MOTION_HISTORY_SIZE) % MOTION_HISTORY_SIZE];
+        if (sample->stamp != 0 && sample->x == x && sample->y == y) {
+            stamp = sample->stamp;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&g_motion_lock);
+    return stamp;
+}
@@ -1,6 +1,8 @@
 #ifndef INPUT_HANDLER_H
 #define INPUT_HANDLER_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,6 +23,20 @@ void input_handler_set_log_level(int level);
  */
 int input_handler_init(void);
 
+/**
+ * @brief Window-to-screen mapping for pointer coordinates
+ * Called from the SDL event watch; converts x/y in place.
+ * @return 0 on success, -1 to leave the coordinates unchanged
+ */
+typedef int (*input_point_map_t)(int* x, int* y);
+
+/**
+ * @brief Set how pointer positions in the window map to screen pixels
+ * Needed once the window is scaled or letterboxed; NULL passes window coordinates through.
+ * @param map Mapping function (can be NULL)
+ */
+void input_handler_set_point_map(input_point_map_t map);
+
 /**
  * @brief Process SDL keyboard and mouse events
  * @return 0 on success, -1 on failure, 1 if quit requested
@@ -40,6 +56,23 @@ void input_handler_cleanup(void);
  */
 int input_handler_get_mouse_position(int* x, int* y);
 
+/**
+ * @brief Get current mouse position with the time of the motion that set it
+ * @param x Pointer to store X coordinate
+ * @param y Pointer to store Y coordinate
+ * @param stamp Pointer to store the SDL performance counter of the motion (0 = no motion yet)
+ * @return 0 on success, -1 on failure
+ */
+int input_handler_get_cursor(int* x, int* y, uint64_t* stamp);
+
+/**
+ * @brief Look up when the pointer was recently at a position
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return SDL performance counter of the newest matching motion, 0 if not in the recent history
+ */
+uint64_t input_handler_find_motion(int x, int y);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,133 @@
+#include "link_recorder.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char recording_magic[7] = { 'F', 'M', 'R', 'B', 'R', 'E', 'C' };
+
+// Fixed part of each record, written field by field so the layout has no padding
+#define RECORD_HEADER_SIZE (8 + 4 + 4)
+
+static FILE *record_fp = NULL;
+static uint64_t record_start_us = 0;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+int link_recorder_open(const char *path) {
+    link_recorder_close();
+
+    record_fp = fopen(path, "wb");
+    if (!record_fp) {
+        fprintf(stderr, "Failed to open recording %s\n", path);
+        return -1;
+    }
+
+    uint8_t header[8];
+    memcpy(header, recording_magic, sizeof(recording_magic));
+    header[7] = LINK_RECORDING_VERSION;
+    if (fwrite(header, 1, sizeof(header), record_fp) != sizeof(header)) {
+        fprintf(stderr, "Failed to write recording header to %s\n", path);
+        fclose(record_fp);
+        record_fp = NULL;
+        return -1;
+    }
+
+    record_start_us = now_us();
+    printf("Recording link traffic to %s\n", path);
+    return 0;
+}
+
+void link_recorder_write(uint8_t type, uint8_t seq, uint8_t sub_cmd, const uint8_t *payload, size_t len) {
+    if (!record_fp) {
+        return;
+    }
+
+    uint8_t header[RECORD_HEADER_SIZE];
+    uint64_t time_us = now_us() - record_start_us;
+    uint32_t len32 = (uint32_t)len;
+    memcpy(header, &time_us, 8);
+    header[8] = type;
+    header[9] = seq;
+    header[10] = sub_cmd;
+    header[11] = 0;
+    memcpy(header + 12, &len32, 4);
+
+    if (fwrite(header, 1, sizeof(header), record_fp) != sizeof(header) ||
+        (len > 0 && fwrite(payload, 1, len, record_fp) != len)) {
+        fprintf(stderr, "Recording write failed, stopping recording\n");
+        link_recorder_close();
+    }
+}
+
+void link_recorder_close(void) {
+    if (record_fp) {
+        fclose(record_fp);
+        record_fp = NULL;
+    }
+}
+
+int link_recording_open(link_recording_t *rec, const char *path) {
+    memset(rec, 0, sizeof(*rec));
+    rec->fp = fopen(path, "rb");
+    if (!rec->fp) {
+        fprintf(stderr, "Failed to open recording %s\n", path);
+        return -1;
+    }
+
+    uint8_t header[8];
+    if (fread(header, 1, sizeof(header), rec->fp) != sizeof(header) ||
+        memcmp(header, recording_magic, sizeof(recording_magic)) != 0) {
+        fprintf(stderr, "%s is not a link recording\n", path);
+        link_recording_close(rec);
+        return -1;
+    }
+    if (header[7] != LINK_RECORDING_VERSION) {
+        fprintf(stderr, "%s: unsupported recording version %u\n", path, header[7]);
+        link_recording_close(rec);
+        return -1;
+    }
+    return 0;
+}
+
+int link_recording_next(link_recording_t *rec, link_record_t *out) {
+    uint8_t header[RECORD_HEADER_SIZE];
+    size_t got = fread(header, 1, sizeof(header), rec->fp);
+    if (got == 0 && feof(rec->fp)) {
+        return 0;
+    }
+    if (got != sizeof(header)) {
+        return -1;
+    }
+
+    memcpy(&out->time_us, header, 8);
+    out->type = header[8];
+    out->seq = header[9];
+    out->sub_cmd = header[10];
+    memcpy(&out->len, header + 12, 4);
+
+    if (out->len > rec->buffer_size) {
+        uint8_t *buffer = (uint8_t*)realloc(rec->buffer, out->len);
+        if (!buffer) {
+            return -1;
+        }
+        rec->buffer = buffer;
+        rec->buffer_size = out->len;
+    }
+    if (out->len > 0 && fread(rec->buffer, 1, out->len, rec->fp) != out->len) {
+        return -1;
+    }
+    out->payload = rec->buffer;
+    return 1;
+}
+
+void link_recording_close(link_recording_t *rec) {
+    if (rec->fp) {
+        fclose(rec->fp);
+    }
+    free(rec->buffer);
+    memset(rec, 0, sizeof(*rec));
+}
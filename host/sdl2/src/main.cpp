@@ -6,6 +6,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <csignal>
 #include <unistd.h>
 
@@ -23,13 +24,24 @@ static volatile int running = 1;
 static volatile int display_initialized = 0;
 static uint16_t display_width = 480;   // Default values
 static uint16_t display_height = 320;
-LGFX* g_lgfx = nullptr; // Global LGFX instance (not static, shared with graphics_handler.cpp)
+static LGFX* sdl_display = nullptr;  // Panel_sdl window
+LovyanGFX* g_lgfx = nullptr; // Display graphics_handler draws to (shared with graphics_handler.cpp)
+
+#define FRAME_INTERVAL_MS 16        // Minimum time between frames (~60 FPS)
+#define FRAME_IDLE_TIMEOUT_MS 250   // Wait limit with nothing to draw, so shutdown flags are still seen
+
+#define MAX_SCALE 8                 // Largest --scale; fullscreen without --scale fits up to this
+
+// Command line options
+static int opt_scale = 0;           // Integer window scale, 0 = 1x windowed / largest fit fullscreen
+static int opt_fullscreen = 0;
 
 extern "C" void signal_handler(int sig) {
     printf("\n\n\n+++++++++++++++++++++++++++++++++++++++");
     printf("\n+++++++++++++++++++++++++++++++++++++++\n");
     printf("Received signal %d, shutting down...\n", sig);
     running = 0;
+    socket_server_wake();
 
     // Post SDL_QUIT event to stop LovyanGFX event loop
     SDL_Event quit_event;
@@ -37,6 +49,12 @@ extern "C" void signal_handler(int sig) {
     SDL_PushEvent(&quit_event);
 }
 
+// Scaled/letterboxed window position -> screen pixel (runs in the SDL event watch)
+static int map_window_point(int* x, int* y) {
+    auto panel = sdl_display ? (lgfx::Panel_sdl*)sdl_display->getPanel() : nullptr;
+    return (panel && panel->windowToPanel(x, y)) ? 0 : -1;
+}
+
 // Callback function called by socket_server when display init message is received
 extern "C" int init_display_callback(uint16_t width, uint16_t height, uint8_t color_depth) {
     printf("Initializing display: %dx%d, %d-bit color\n", width, height, color_depth);
@@ -45,28 +63,34 @@ extern "C" int init_display_callback(uint16_t width, uint16_t height, uint8_t co
     display_height = height;
 
     // Create LovyanGFX instance with specified resolution
-    g_lgfx = new LGFX(width, height);
-    if (!g_lgfx) {
+    // Fullscreen takes the largest whole scale that fits, capped by --scale
+    const int scale = opt_scale ? opt_scale : (opt_fullscreen ? MAX_SCALE : 1);
+    sdl_display = new LGFX(width, height, scale);
+    if (!sdl_display) {
         fprintf(stderr, "Failed to create LovyanGFX instance\n");
         return -1;
     }
 
-    g_lgfx->init();
-    g_lgfx->setColorDepth(color_depth);
-    g_lgfx->fillScreen(FMRB_COLOR_BLACK);
-
-    // Disable L/R key rotation shortcut by requiring Ctrl modifier
-    auto panel = (lgfx::Panel_sdl*)g_lgfx->getPanel();
+    // The window is created on the first update after init(), so set up the output first
+    auto panel = (lgfx::Panel_sdl*)sdl_display->getPanel();
     if (panel) {
         panel->setShortcutKeymod(static_cast<SDL_Keymod>(KMOD_CTRL));  // Require Ctrl key for L/R rotation
+        panel->setIntegerScaling(true);  // Whole-pixel nearest-neighbour scaling, letterboxed
+        panel->setFullscreen(opt_fullscreen);
     }
 
+    sdl_display->init();
+    sdl_display->setColorDepth(color_depth);
+    sdl_display->fillScreen(FMRB_COLOR_BLACK);
+    g_lgfx = sdl_display;
+
     printf("Graphics initialized with LovyanGFX (%dx%d, %d-bit RGB)\n", width, height, color_depth);
 
     // Initialize graphics handler (creates back buffer)
     if (graphics_handler_init(nullptr) < 0) {
         fprintf(stderr, "Graphics handler initialization failed\n");
-        delete g_lgfx;
+        delete sdl_display;
+        sdl_display = nullptr;
         g_lgfx = nullptr;
         return -1;
     }
@@ -75,17 +99,20 @@ extern "C" int init_display_callback(uint16_t width, uint16_t height, uint8_t co
     if (audio_handler_init() < 0) {
         fprintf(stderr, "Audio handler initialization failed\n");
         graphics_handler_cleanup();
-        delete g_lgfx;
+        delete sdl_display;
+        sdl_display = nullptr;
         g_lgfx = nullptr;
         return -1;
     }
 
-    // Initialize input handler
+    // Initialize input handler; pointer positions arrive in (scaled) window coordinates
+    input_handler_set_point_map(map_window_point);
     if (input_handler_init() < 0) {
         fprintf(stderr, "Input handler initialization failed\n");
         audio_handler_cleanup();
         graphics_handler_cleanup();
-        delete g_lgfx;
+        delete sdl_display;
+        sdl_display = nullptr;
         g_lgfx = nullptr;
         return -1;
     }
@@ -145,10 +172,19 @@ int user_func(bool* thread_running) {
 
     printf("Host server running. Ready to receive commands.\n");
 
-    // Main loop
+    // Main loop: sleep in poll() until the core sends something or the pointer moves,
+    // drain everything that arrived, and render once a change is pending and the frame is due.
+    uint32_t last_frame = lgfx::millis();
     while (running && *thread_running) {
         //printf("--main loop------------------------------------.\n");
 
+        int timeout = FRAME_IDLE_TIMEOUT_MS;
+        if (graphics_handler_frame_pending()) {
+            int32_t due = (int32_t)(last_frame + FRAME_INTERVAL_MS - lgfx::millis());
+            timeout = due > 0 ? due : 0;
+        }
+        socket_server_wait(timeout);
+
         // Process input events (keyboard, mouse)
         int input_result = input_handler_process_events();
         if (input_result == 1) {
@@ -157,17 +193,21 @@ int user_func(bool* thread_running) {
             break;
         }
 
-        // Process socket messages
+        // Apply everything the receive thread has decoded so far
         socket_server_process();
 
-        // Render all canvases to screen in Z-order
-        graphics_handler_render_frame();
-
-        // Update display
-        g_lgfx->display();
+        // Frames stay at most ~60 FPS so FRAME_DONE keeps pacing the apps
+        uint32_t now = lgfx::millis();
+        if (!graphics_handler_frame_pending() || (int32_t)(now - last_frame) < FRAME_INTERVAL_MS) {
+            continue;
+        }
+        last_frame = now;
 
-        // Small delay to prevent busy waiting
-        lgfx::delay(16); // ~60 FPS
+        // Render all canvases to screen in Z-order; the display is only updated when something changed
+        if (graphics_handler_render_frame()) {
+            g_lgfx->display();
+        }
+        graphics_handler_frame_done();
     }
 
     printf("Shutting down...\n");
@@ -178,14 +218,37 @@ int user_func(bool* thread_running) {
     socket_server_stop();
     audio_handler_cleanup();
     graphics_handler_cleanup();
-    delete g_lgfx;
+    delete sdl_display;
+    sdl_display = nullptr;
     g_lgfx = nullptr;
 
     printf("Family mruby Host (SDL2 + LovyanGFX) stopped.\n");
     return 0;
 }
 
+static int parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            opt_scale = atoi(argv[++i]);
+            if (opt_scale < 1 || opt_scale > MAX_SCALE) {
+                fprintf(stderr, "--scale must be 1..%d\n", MAX_SCALE);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--fullscreen") == 0) {
+            opt_fullscreen = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--scale N] [--fullscreen]\n", argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
+    if (parse_args(argc, argv) < 0) {
+        return 2;
+    }
+
     // Run the user function with LovyanGFX event loop
     input_handler_set_log_level(INPUT_LOG_DEBUG);
     graphics_handler_set_log_level(GFX_LOG_INFO);
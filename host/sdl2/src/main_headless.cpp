@@ -0,0 +1,251 @@
+/**
+ * Headless host: runs graphics_handler against an in-memory framebuffer instead of a Panel_sdl
+ * window, so the core's Linux build can be driven end to end on a machine without a display.
+ * It serves the same sockets and protocol as fmrb_host_sdl2; audio goes to SDL's dummy driver
+ * and there is no pointer or keyboard input.
+ *
+ *   fmrb_host_headless [--checksum] [--dump DIR] [--frames N] [--no-pace]
+ *
+ *   --checksum  Print "frame <n> <ms> <crc32>" for every frame that changed the framebuffer
+ *   --dump DIR  Write every changed frame to DIR/frame_<n>.ppm
+ *   --frames N  Exit after N changed frames
+ *   --no-pace   Render as soon as something is pending instead of at most every 16 ms
+ */
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include <SDL2/SDL.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+
+extern "C" {
+#include "socket_server.h"
+#include "graphics_handler.h"
+#include "audio_handler.h"
+#include "input_socket.h"
+#include "fmrb_link_protocol.h"
+#include "fmrb_link_cobs.h"
+#include "fmrb_gfx.h"
+}
+
+static volatile int running = 1;
+static volatile int display_initialized = 0;
+static LGFX_Sprite* framebuffer = nullptr;  // Stands in for the SDL window
+LovyanGFX* g_lgfx = nullptr; // Display graphics_handler draws to (shared with graphics_handler.cpp)
+
+#define FRAME_INTERVAL_MS 16        // Minimum time between frames (~60 FPS), as on the SDL host
+#define FRAME_IDLE_TIMEOUT_MS 250   // Wait limit with nothing to draw, so shutdown flags are still seen
+
+// Command line options
+static int opt_checksum = 0;
+static const char* opt_dump_dir = nullptr;
+static unsigned long opt_max_frames = 0;    // 0 = run until stopped
+static int opt_no_pace = 0;
+
+extern "C" void signal_handler(int sig) {
+    printf("\nReceived signal %d, shutting down...\n", sig);
+    running = 0;
+    socket_server_wake();
+}
+
+// Callback function called by socket_server when display init message is received
+extern "C" int init_display_callback(uint16_t width, uint16_t height, uint8_t color_depth) {
+    printf("Initializing headless framebuffer: %dx%d, %d-bit color\n", width, height, color_depth);
+
+    framebuffer = new LGFX_Sprite();
+    framebuffer->setColorDepth(color_depth);
+    if (!framebuffer->createSprite(width, height)) {
+        fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        delete framebuffer;
+        framebuffer = nullptr;
+        return -1;
+    }
+    framebuffer->fillScreen(FMRB_COLOR_BLACK);
+    g_lgfx = framebuffer;
+
+    if (graphics_handler_init(nullptr) < 0) {
+        fprintf(stderr, "Graphics handler initialization failed\n");
+        delete framebuffer;
+        framebuffer = nullptr;
+        g_lgfx = nullptr;
+        return -1;
+    }
+
+    // Audio commands are still decoded and played, into SDL's dummy output
+    if (audio_handler_init() < 0) {
+        fprintf(stderr, "Audio handler initialization failed\n");
+        graphics_handler_cleanup();
+        delete framebuffer;
+        framebuffer = nullptr;
+        g_lgfx = nullptr;
+        return -1;
+    }
+
+    display_initialized = 1;
+    printf("Display initialization complete\n");
+    return 0;
+}
+
+// Write the framebuffer as a binary PPM (P6)
+static int dump_frame(const char* dir, unsigned long frame) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%06lu.ppm", dir, frame);
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return -1;
+    }
+
+    const int w = framebuffer->width();
+    const int h = framebuffer->height();
+    fprintf(fp, "P6\n%d %d\n255\n", w, h);
+    uint8_t* row = (uint8_t*)malloc((size_t)w * 3);
+    if (!row) {
+        fclose(fp);
+        return -1;
+    }
+    for (int y = 0; y < h; y++) {
+        framebuffer->readRectRGB(0, y, w, 1, row);
+        fwrite(row, 3, w, fp);
+    }
+    free(row);
+    fclose(fp);
+    return 0;
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--checksum] [--dump DIR] [--frames N] [--no-pace]\n", prog);
+}
+
+static int parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--checksum") == 0) {
+            opt_checksum = 1;
+        } else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            opt_dump_dir = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            opt_max_frames = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--no-pace") == 0) {
+            opt_no_pace = 1;
+        } else {
+            usage(argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (parse_args(argc, argv) < 0) {
+        return 2;
+    }
+
+    printf("Family mruby Host (headless) starting...\n");
+    graphics_handler_set_log_level(GFX_LOG_ERROR);
+
+    // No sound card on a CI box: let SDL audio open its null device unless told otherwise
+    setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    if (socket_server_start() < 0) {
+        fprintf(stderr, "Socket server start failed\n");
+        return 1;
+    }
+
+    // The core connects to the input socket too; it just never receives events here
+    if (input_socket_start() < 0) {
+        fprintf(stderr, "Input socket server start failed\n");
+        socket_server_stop();
+        return 1;
+    }
+
+    printf("Socket server started. Waiting for display initialization command...\n");
+
+    int timeout_count = 0;
+    while (!display_initialized && running) {
+        socket_server_wait(100);
+        socket_server_process();
+
+        timeout_count++;
+        if (timeout_count > 120*10) {
+            fprintf(stderr, "Timeout waiting for display initialization\n");
+            input_socket_stop();
+            socket_server_stop();
+            return 1;
+        }
+    }
+
+    if (!display_initialized) {
+        fprintf(stderr, "Display not initialized\n");
+        input_socket_stop();
+        socket_server_stop();
+        return 1;
+    }
+
+    printf("Host server running. Ready to receive commands.\n");
+
+    // Same loop as the SDL host, minus input; frames that change nothing are not counted
+    const uint32_t start = lgfx::millis();
+    uint32_t last_frame = start;
+    unsigned long frames = 0;
+    uint64_t render_ticks = 0;
+    while (running && (opt_max_frames == 0 || frames < opt_max_frames)) {
+        const int interval = opt_no_pace ? 0 : FRAME_INTERVAL_MS;
+        int timeout = FRAME_IDLE_TIMEOUT_MS;
+        if (graphics_handler_frame_pending()) {
+            int32_t due = (int32_t)(last_frame + interval - lgfx::millis());
+            timeout = due > 0 ? due : 0;
+        }
+        socket_server_wait(timeout);
+
+        socket_server_process();
+
+        uint32_t now = lgfx::millis();
+        if (!graphics_handler_frame_pending() || (int32_t)(now - last_frame) < interval) {
+            continue;
+        }
+        last_frame = now;
+
+        const uint64_t t0 = SDL_GetPerformanceCounter();
+        const int updated = graphics_handler_render_frame();
+        const uint64_t t1 = SDL_GetPerformanceCounter();
+        graphics_handler_frame_done();
+        if (!updated) {
+            continue;
+        }
+        render_ticks += t1 - t0;
+
+        if (opt_checksum) {
+            const uint32_t crc = fmrb_link_crc32_update(0, (const uint8_t*)framebuffer->getBuffer(),
+                                                        framebuffer->bufferLength());
+            printf("frame %lu %u 0x%08x\n", frames, (unsigned)(now - start), (unsigned)crc);
+        }
+        if (opt_dump_dir) {
+            dump_frame(opt_dump_dir, frames);
+        }
+        frames++;
+    }
+
+    if (frames > 0) {
+        printf("Frames: %lu, average render %.3f ms\n", frames,
+               (double)render_ticks * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames);
+    }
+
+    printf("Shutting down...\n");
+
+    input_socket_stop();
+    socket_server_stop();
+    audio_handler_cleanup();
+    graphics_handler_cleanup();
+    delete framebuffer;
+    framebuffer = nullptr;
+    g_lgfx = nullptr;
+
+    printf("Family mruby Host (headless) stopped.\n");
+    return 0;
+}
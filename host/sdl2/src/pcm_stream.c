@@ -0,0 +1,196 @@
+#include "pcm_stream.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PCM_MIN_RATE 1000
+#define PCM_MAX_RATE 192000
+
+// Ring of stereo frames at the output rate; head/tail are free-running frame counters
+static int16_t *g_ring = NULL;
+static uint32_t g_capacity = 0;       // Frames, power of two
+static SDL_atomic_t g_head;           // Advanced by the audio thread
+static SDL_atomic_t g_tail;           // Advanced by the producer
+static uint32_t g_target = 0;
+static int g_output_rate = 0;
+static SDL_atomic_t g_underruns;
+static uint32_t g_overruns = 0;
+
+// Audio thread: waiting for the buffer to reach the target before playing
+static int g_buffering = 1;
+
+// Producer: linear-interpolation resampler, kept across messages so chunk edges are seamless
+static uint32_t g_in_rate = 0;
+static uint8_t g_in_channels = 0;
+static uint32_t g_step = 0;           // Input frames per output frame (16.16)
+static uint32_t g_frac = 0;           // Output position between g_s0 and g_s1 (16.16)
+static int32_t g_s0[2];
+static int32_t g_s1[2];
+
+static inline int16_t saturate16(int32_t v) {
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+int pcm_stream_init(int output_rate, int latency_ms) {
+    pcm_stream_cleanup();
+    if (output_rate <= 0) {
+        return -1;
+    }
+    if (latency_ms <= 0) {
+        latency_ms = PCM_STREAM_DEFAULT_LATENCY_MS;
+    }
+
+    uint32_t frames = (uint32_t)((uint64_t)output_rate * PCM_STREAM_CAPACITY_MS / 1000);
+    g_capacity = 1;
+    while (g_capacity < frames) {
+        g_capacity <<= 1;
+    }
+    g_ring = (int16_t *)calloc(g_capacity, sizeof(int16_t) * 2);
+    if (!g_ring) {
+        fprintf(stderr, "Failed to allocate PCM stream buffer\n");
+        g_capacity = 0;
+        return -1;
+    }
+
+    g_output_rate = output_rate;
+    g_target = (uint32_t)((uint64_t)output_rate * latency_ms / 1000);
+    if (g_target > g_capacity / 2) {
+        g_target = g_capacity / 2;
+    }
+    SDL_AtomicSet(&g_head, 0);
+    SDL_AtomicSet(&g_tail, 0);
+    SDL_AtomicSet(&g_underruns, 0);
+    g_overruns = 0;
+    g_buffering = 1;
+    g_in_rate = 0;
+    g_in_channels = 0;
+
+    printf("PCM stream: %u frame buffer, %d ms latency target\n", g_capacity, latency_ms);
+    return 0;
+}
+
+void pcm_stream_cleanup(void) {
+    free(g_ring);
+    g_ring = NULL;
+    g_capacity = 0;
+}
+
+void pcm_stream_get_status(fmrb_link_audio_queue_status_t *status) {
+    uint32_t queued = (uint32_t)SDL_AtomicGet(&g_tail) - (uint32_t)SDL_AtomicGet(&g_head);
+    status->queued_frames = queued;
+    status->target_frames = g_target;
+    status->free_frames = g_capacity - queued;
+    status->output_rate = (uint32_t)g_output_rate;
+    status->underruns = (uint32_t)SDL_AtomicGet(&g_underruns);
+    status->overruns = g_overruns;
+}
+
+int pcm_stream_queue(const uint8_t *data, size_t size, fmrb_link_audio_queue_status_t *status) {
+    if (!g_ring || size < sizeof(fmrb_link_audio_play_t)) {
+        return -1;
+    }
+
+    fmrb_link_audio_play_t hdr;
+    memcpy(&hdr, data, sizeof(hdr));
+    const uint8_t *pcm = data + sizeof(hdr);
+    const size_t bytes_per_sample = hdr.bits_per_sample / 8;
+    if ((hdr.channels != 1 && hdr.channels != 2) ||
+        (hdr.bits_per_sample != 8 && hdr.bits_per_sample != 16) ||
+        hdr.sample_rate < PCM_MIN_RATE || hdr.sample_rate > PCM_MAX_RATE ||
+        hdr.data_len > size - sizeof(hdr)) {
+        fprintf(stderr, "Invalid PCM stream chunk: %u Hz, %u ch, %u bit, %u bytes\n",
+                hdr.sample_rate, hdr.channels, hdr.bits_per_sample, hdr.data_len);
+        return -1;
+    }
+
+    // A format change starts the resampler over
+    if (hdr.sample_rate != g_in_rate || hdr.channels != g_in_channels) {
+        g_in_rate = hdr.sample_rate;
+        g_in_channels = hdr.channels;
+        g_step = (uint32_t)(((uint64_t)hdr.sample_rate << 16) / (uint32_t)g_output_rate);
+        g_frac = 0;
+        g_s0[0] = g_s0[1] = g_s1[0] = g_s1[1] = 0;
+    }
+
+    const uint32_t head = (uint32_t)SDL_AtomicGet(&g_head);
+    const uint32_t tail = (uint32_t)SDL_AtomicGet(&g_tail);
+    const uint32_t room = g_capacity - (tail - head);
+    const size_t in_frames = hdr.data_len / (bytes_per_sample * hdr.channels);
+    uint32_t written = 0;
+    int dropped = 0;
+
+    for (size_t i = 0; i < in_frames; i++) {
+        int32_t frame[2];
+        for (int c = 0; c < hdr.channels; c++) {
+            if (hdr.bits_per_sample == 8) {
+                frame[c] = ((int32_t)pcm[0] - 128) << 8;
+            } else {
+                frame[c] = (int16_t)(pcm[0] | (pcm[1] << 8));
+            }
+            pcm += bytes_per_sample;
+        }
+        if (hdr.channels == 1) {
+            frame[1] = frame[0];
+        }
+
+        g_s0[0] = g_s1[0];
+        g_s0[1] = g_s1[1];
+        g_s1[0] = frame[0];
+        g_s1[1] = frame[1];
+        while (g_frac < 0x10000) {
+            if (written < room) {
+                // 15-bit fraction: a full-scale step times the fraction still fits in int32
+                const int32_t frac = (int32_t)(g_frac >> 1);
+                int16_t *dst = &g_ring[((tail + written) & (g_capacity - 1)) * 2];
+                dst[0] = (int16_t)(g_s0[0] + (((g_s1[0] - g_s0[0]) * frac) >> 15));
+                dst[1] = (int16_t)(g_s0[1] + (((g_s1[1] - g_s0[1]) * frac) >> 15));
+                written++;
+            } else {
+                dropped = 1;
+            }
+            g_frac += g_step;
+        }
+        g_frac -= 0x10000;
+    }
+
+    SDL_AtomicSet(&g_tail, (int)(tail + written));
+    if (dropped) {
+        g_overruns++;
+    }
+
+    if (status) {
+        pcm_stream_get_status(status);
+    }
+    return 0;
+}
+
+void pcm_stream_mix(int16_t *out, int frames) {
+    if (!g_ring || frames <= 0) {
+        return;
+    }
+
+    const uint32_t head = (uint32_t)SDL_AtomicGet(&g_head);
+    const uint32_t avail = (uint32_t)SDL_AtomicGet(&g_tail) - head;
+    if (g_buffering) {
+        // Jitter buffer: hold off until the latency target is queued
+        if (avail == 0 || avail < g_target) {
+            return;
+        }
+        g_buffering = 0;
+    }
+
+    const uint32_t n = avail < (uint32_t)frames ? avail : (uint32_t)frames;
+    for (uint32_t i = 0; i < n; i++) {
+        const int16_t *src = &g_ring[((head + i) & (g_capacity - 1)) * 2];
+        out[i * 2] = saturate16(out[i * 2] + src[0]);
+        out[i * 2 + 1] = saturate16(out[i * 2 + 1] + src[1]);
+    }
+    SDL_AtomicSet(&g_head, (int)(head + n));
+
+    if (n < (uint32_t)frames) {
+        // Ran dry: count it and rebuild the cushion before playing again
+        SDL_AtomicIncRef(&g_underruns);
+        g_buffering = 1;
+    }
+}
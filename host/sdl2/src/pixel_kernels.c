@@ -0,0 +1,318 @@
+#include "pixel_kernels.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PIXEL_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define PIXEL_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+// RGB332 channel expansion, same values as LovyanGFX rgb332_t::R8/G8/B8
+// (3-bit: (v * 9 << 2) + (v >> 1), 2-bit: v * 0x55). Padded to 16 entries for byte shuffles.
+static const uint8_t expand3[16] = { 0, 36, 73, 109, 146, 182, 219, 255 };
+static const uint8_t expand2[16] = { 0, 85, 170, 255 };
+
+// Full RGB332 -> 0xAARRGGBB table for the scalar kernels, built at compile time so the scalar
+// defaults are usable before pixel_kernels_init()
+#define EXPAND3(v) ((uint32_t)(((v) * 9 << 2) + ((v) >> 1)))
+#define EXPAND2(v) ((uint32_t)((v) * 0x55))
+#define ARGB332(c) (0xFF000000u | EXPAND3(((c) >> 5) & 7) << 16 | EXPAND3(((c) >> 2) & 7) << 8 | EXPAND2((c) & 3))
+#define ARGB332_4(c) ARGB332(c), ARGB332((c) + 1), ARGB332((c) + 2), ARGB332((c) + 3)
+#define ARGB332_16(c) ARGB332_4(c), ARGB332_4((c) + 4), ARGB332_4((c) + 8), ARGB332_4((c) + 12)
+#define ARGB332_64(c) ARGB332_16(c), ARGB332_16((c) + 16), ARGB332_16((c) + 32), ARGB332_16((c) + 48)
+static const uint32_t g_argb_lut[256] = {
+    ARGB332_64(0), ARGB332_64(64), ARGB332_64(128), ARGB332_64(192)
+};
+
+static pixel_isa_t g_isa = PIXEL_ISA_SCALAR;
+
+// ---------------------------------------------------------------------------
+// Scalar kernels
+
+static void rgb332_to_rgb888_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t c = g_argb_lut[src[i]];
+        dst[0] = (uint8_t)(c >> 16);
+        dst[1] = (uint8_t)(c >> 8);
+        dst[2] = (uint8_t)c;
+        dst += 3;
+    }
+}
+
+static void rgb332_to_argb8888_scalar(uint32_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = g_argb_lut[src[i]];
+    }
+}
+
+static void blit_key8_scalar(uint8_t* dst, const uint8_t* src, size_t count, uint8_t key) {
+    for (size_t i = 0; i < count; i++) {
+        if (src[i] != key) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// x86: SSSE3 (16 pixels per step) and AVX2 (32 pixels per step)
+
+#ifdef PIXEL_HAVE_X86
+
+// Store the 12 R,G,B bytes that a B,G,R,A -> R,G,B byte shuffle leaves in the low part of v
+__attribute__((target("ssse3")))
+static inline void store_rgb12(uint8_t* dst, __m128i v) {
+    _mm_storel_epi64((__m128i*)dst, v);
+    uint32_t tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+    memcpy(dst + 8, &tail, 4);
+}
+
+// Split 16 RGB332 pixels into 8-bit R, G and B vectors with PSHUFB table lookups
+__attribute__((target("ssse3")))
+static inline void expand_16_ssse3(__m128i v, __m128i* r, __m128i* g, __m128i* b) {
+    const __m128i t3 = _mm_loadu_si128((const __m128i*)expand3);
+    const __m128i t2 = _mm_loadu_si128((const __m128i*)expand2);
+    const __m128i m7 = _mm_set1_epi8(7);
+    // 16-bit shifts leak bits from the neighbouring byte into the top, which the mask drops
+    *r = _mm_shuffle_epi8(t3, _mm_and_si128(_mm_srli_epi16(v, 5), m7));
+    *g = _mm_shuffle_epi8(t3, _mm_and_si128(_mm_srli_epi16(v, 2), m7));
+    *b = _mm_shuffle_epi8(t2, _mm_and_si128(v, _mm_set1_epi8(3)));
+}
+
+__attribute__((target("ssse3")))
+static void rgb332_to_argb8888_ssse3(uint32_t* dst, const uint8_t* src, size_t count) {
+    const __m128i alpha = _mm_set1_epi8((char)0xFF);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i r, g, b;
+        expand_16_ssse3(_mm_loadu_si128((const __m128i*)(src + i)), &r, &g, &b);
+        __m128i bg_lo = _mm_unpacklo_epi8(b, g);
+        __m128i bg_hi = _mm_unpackhi_epi8(b, g);
+        __m128i ra_lo = _mm_unpacklo_epi8(r, alpha);
+        __m128i ra_hi = _mm_unpackhi_epi8(r, alpha);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(bg_lo, ra_lo));
+        _mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(bg_lo, ra_lo));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpacklo_epi16(bg_hi, ra_hi));
+        _mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(bg_hi, ra_hi));
+    }
+    rgb332_to_argb8888_scalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("ssse3")))
+static void rgb332_to_rgb888_ssse3(uint8_t* dst, const uint8_t* src, size_t count) {
+    const __m128i alpha = _mm_set1_epi8((char)0xFF);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i r, g, b;
+        expand_16_ssse3(_mm_loadu_si128((const __m128i*)(src + i)), &r, &g, &b);
+        __m128i bg_lo = _mm_unpacklo_epi8(b, g);
+        __m128i bg_hi = _mm_unpackhi_epi8(b, g);
+        __m128i ra_lo = _mm_unpacklo_epi8(r, alpha);
+        __m128i ra_hi = _mm_unpackhi_epi8(r, alpha);
+        uint8_t* d = dst + i * 3;
+        store_rgb12(d,      _mm_shuffle_epi8(_mm_unpacklo_epi16(bg_lo, ra_lo), pack));
+        store_rgb12(d + 12, _mm_shuffle_epi8(_mm_unpackhi_epi16(bg_lo, ra_lo), pack));
+        store_rgb12(d + 24, _mm_shuffle_epi8(_mm_unpacklo_epi16(bg_hi, ra_hi), pack));
+        store_rgb12(d + 36, _mm_shuffle_epi8(_mm_unpackhi_epi16(bg_hi, ra_hi), pack));
+    }
+    rgb332_to_rgb888_scalar(dst + i * 3, src + i, count - i);
+}
+
+__attribute__((target("sse2")))
+static void blit_key8_sse2(uint8_t* dst, const uint8_t* src, size_t count, uint8_t key) {
+    const __m128i k = _mm_set1_epi8((char)key);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i keep = _mm_cmpeq_epi8(s, k);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, s)));
+    }
+    blit_key8_scalar(dst + i, src + i, count - i, key);
+}
+
+// AVX2 byte ops work per 128-bit lane, so 32 pixels come out as lane-interleaved groups of 4
+// that are put back in order with cross-lane permutes
+__attribute__((target("avx2")))
+static inline void expand_32_avx2(const uint8_t* src, __m256i out[4]) {
+    const __m256i t3 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)expand3));
+    const __m256i t2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)expand2));
+    const __m256i m7 = _mm256_set1_epi8(7);
+    const __m256i alpha = _mm256_set1_epi8((char)0xFF);
+
+    __m256i v = _mm256_loadu_si256((const __m256i*)src);
+    __m256i r = _mm256_shuffle_epi8(t3, _mm256_and_si256(_mm256_srli_epi16(v, 5), m7));
+    __m256i g = _mm256_shuffle_epi8(t3, _mm256_and_si256(_mm256_srli_epi16(v, 2), m7));
+    __m256i b = _mm256_shuffle_epi8(t2, _mm256_and_si256(v, _mm256_set1_epi8(3)));
+
+    __m256i bg_lo = _mm256_unpacklo_epi8(b, g);
+    __m256i bg_hi = _mm256_unpackhi_epi8(b, g);
+    __m256i ra_lo = _mm256_unpacklo_epi8(r, alpha);
+    __m256i ra_hi = _mm256_unpackhi_epi8(r, alpha);
+    __m256i q0 = _mm256_unpacklo_epi16(bg_lo, ra_lo);  // Pixels 0-3 | 16-19
+    __m256i q1 = _mm256_unpackhi_epi16(bg_lo, ra_lo);  // 4-7 | 20-23
+    __m256i q2 = _mm256_unpacklo_epi16(bg_hi, ra_hi);  // 8-11 | 24-27
+    __m256i q3 = _mm256_unpackhi_epi16(bg_hi, ra_hi);  // 12-15 | 28-31
+
+    out[0] = _mm256_permute2x128_si256(q0, q1, 0x20);
+    out[1] = _mm256_permute2x128_si256(q2, q3, 0x20);
+    out[2] = _mm256_permute2x128_si256(q0, q1, 0x31);
+    out[3] = _mm256_permute2x128_si256(q2, q3, 0x31);
+}
+
+__attribute__((target("avx2")))
+static void rgb332_to_argb8888_avx2(uint32_t* dst, const uint8_t* src, size_t count) {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i out[4];
+        expand_32_avx2(src + i, out);
+        for (int k = 0; k < 4; k++) {
+            _mm256_storeu_si256((__m256i*)(dst + i + k * 8), out[k]);
+        }
+    }
+    rgb332_to_argb8888_scalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void rgb332_to_rgb888_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i out[4];
+        expand_32_avx2(src + i, out);
+        uint8_t* d = dst + i * 3;
+        for (int k = 0; k < 4; k++) {
+            __m256i rgb = _mm256_shuffle_epi8(out[k], pack);
+            store_rgb12(d + k * 24, _mm256_castsi256_si128(rgb));
+            store_rgb12(d + k * 24 + 12, _mm256_extracti128_si256(rgb, 1));
+        }
+    }
+    rgb332_to_rgb888_scalar(dst + i * 3, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void blit_key8_avx2(uint8_t* dst, const uint8_t* src, size_t count, uint8_t key) {
+    const __m256i k = _mm256_set1_epi8((char)key);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_blendv_epi8(s, d, _mm256_cmpeq_epi8(s, k)));
+    }
+    // Scalar tail: calling the non-VEX SSE2 kernel here would pay the AVX/SSE transition penalty
+    blit_key8_scalar(dst + i, src + i, count - i, key);
+}
+
+#endif // PIXEL_HAVE_X86
+
+// ---------------------------------------------------------------------------
+// AArch64 NEON (16 pixels per step; interleaving stores do the channel packing)
+
+#ifdef PIXEL_HAVE_NEON
+
+static inline void expand_16_neon(const uint8_t* src, uint8x16_t* r, uint8x16_t* g, uint8x16_t* b) {
+    const uint8x16_t t3 = vld1q_u8(expand3);
+    const uint8x16_t t2 = vld1q_u8(expand2);
+    uint8x16_t v = vld1q_u8(src);
+    *r = vqtbl1q_u8(t3, vshrq_n_u8(v, 5));
+    *g = vqtbl1q_u8(t3, vandq_u8(vshrq_n_u8(v, 2), vdupq_n_u8(7)));
+    *b = vqtbl1q_u8(t2, vandq_u8(v, vdupq_n_u8(3)));
+}
+
+static void rgb332_to_argb8888_neon(uint32_t* dst, const uint8_t* src, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t bgra;
+        expand_16_neon(src + i, &bgra.val[2], &bgra.val[1], &bgra.val[0]);
+        bgra.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8((uint8_t*)(dst + i), bgra);  // Little-endian 0xAARRGGBB
+    }
+    rgb332_to_argb8888_scalar(dst + i, src + i, count - i);
+}
+
+static void rgb332_to_rgb888_neon(uint8_t* dst, const uint8_t* src, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x3_t rgb;
+        expand_16_neon(src + i, &rgb.val[0], &rgb.val[1], &rgb.val[2]);
+        vst3q_u8(dst + i * 3, rgb);
+    }
+    rgb332_to_rgb888_scalar(dst + i * 3, src + i, count - i);
+}
+
+static void blit_key8_neon(uint8_t* dst, const uint8_t* src, size_t count, uint8_t key) {
+    const uint8x16_t k = vdupq_n_u8(key);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t s = vld1q_u8(src + i);
+        uint8x16_t d = vld1q_u8(dst + i);
+        vst1q_u8(dst + i, vbslq_u8(vceqq_u8(s, k), d, s));
+    }
+    blit_key8_scalar(dst + i, src + i, count - i, key);
+}
+
+#endif // PIXEL_HAVE_NEON
+
+// ---------------------------------------------------------------------------
+// Dispatch
+
+static void (*g_to_rgb888)(uint8_t*, const uint8_t*, size_t) = rgb332_to_rgb888_scalar;
+static void (*g_to_argb8888)(uint32_t*, const uint8_t*, size_t) = rgb332_to_argb8888_scalar;
+static void (*g_blit_key8)(uint8_t*, const uint8_t*, size_t, uint8_t) = blit_key8_scalar;
+
+pixel_isa_t pixel_kernels_init(int allow_simd) {
+    g_isa = PIXEL_ISA_SCALAR;
+    g_to_rgb888 = rgb332_to_rgb888_scalar;
+    g_to_argb8888 = rgb332_to_argb8888_scalar;
+    g_blit_key8 = blit_key8_scalar;
+
+    if (allow_simd) {
+#ifdef PIXEL_HAVE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            g_isa = PIXEL_ISA_AVX2;
+            g_to_rgb888 = rgb332_to_rgb888_avx2;
+            g_to_argb8888 = rgb332_to_argb8888_avx2;
+            g_blit_key8 = blit_key8_avx2;
+        } else if (__builtin_cpu_supports("ssse3")) {
+            g_isa = PIXEL_ISA_SSSE3;
+            g_to_rgb888 = rgb332_to_rgb888_ssse3;
+            g_to_argb8888 = rgb332_to_argb8888_ssse3;
+            g_blit_key8 = blit_key8_sse2;
+        }
+#elif defined(PIXEL_HAVE_NEON)
+        g_isa = PIXEL_ISA_NEON;
+        g_to_rgb888 = rgb332_to_rgb888_neon;
+        g_to_argb8888 = rgb332_to_argb8888_neon;
+        g_blit_key8 = blit_key8_neon;
+#endif
+    }
+
+    return g_isa;
+}
+
+const char* pixel_kernels_isa_name(pixel_isa_t isa) {
+    switch (isa) {
+        case PIXEL_ISA_SSSE3: return "SSSE3";
+        case PIXEL_ISA_AVX2:  return "AVX2";
+        case PIXEL_ISA_NEON:  return "NEON";
+        default:              return "scalar";
+    }
+}
+
+void pixel_rgb332_to_rgb888(uint8_t* dst, const uint8_t* src, size_t count) {
+    g_to_rgb888(dst, src, count);
+}
+
+void pixel_rgb332_to_argb8888(uint32_t* dst, const uint8_t* src, size_t count) {
+    g_to_argb8888(dst, src, count);
+}
+
+void pixel_blit_key8(uint8_t* dst, const uint8_t* src, size_t count, uint8_t key) {
+    g_blit_key8(dst, src, count, key);
+}
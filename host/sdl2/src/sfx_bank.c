@@ -0,0 +1,404 @@
+#include "sfx_bank.h"
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SFX_QUEUE_SIZE 64               // Installs/removals in flight
+#define SFX_TRIGGER_QUEUE_SIZE 64       // Triggers in flight
+#define SFX_RING_SLOTS (SFX_QUEUE_SIZE * 2)
+#define SFX_MIN_RATE 1000
+#define SFX_MAX_RATE 192000
+#define SFX_MAX_PITCH 2400              // Cents
+
+typedef struct {
+    uint32_t rate;
+    uint32_t frames;
+    uint8_t max_voices;
+    uint8_t priority;
+    int16_t pcm[];
+} sfx_clip_t;
+
+typedef enum {
+    SFX_MSG_INSTALL,         // Control -> audio: clip (NULL removes) for app/id
+    SFX_MSG_TRIGGER,         // Trigger -> audio
+    SFX_MSG_RELEASE          // Audio -> control: clip no longer referenced
+} sfx_msg_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t app;
+    uint8_t id;
+    uint8_t volume;
+    int8_t pan;
+    int16_t pitch;
+    sfx_clip_t *clip;
+} sfx_msg_t;
+
+// Single-producer single-consumer ring, as in apu_synth.c
+typedef struct {
+    sfx_msg_t slots[SFX_RING_SLOTS];
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+    unsigned capacity;
+} sfx_ring_t;
+
+typedef struct {
+    const sfx_clip_t *clip;  // NULL: free
+    uint8_t app;
+    uint8_t id;
+    uint32_t serial;         // Trigger order, for stealing the oldest
+    uint64_t pos;            // 16.16 position in the clip
+    uint32_t step;           // 16.16 clip frames per output frame
+    int32_t gain_l;          // Q15
+    int32_t gain_r;
+} sfx_voice_t;
+
+// Upload being assembled for one app (control thread)
+typedef struct {
+    sfx_clip_t *clip;
+    uint8_t id;
+    uint8_t bytes_per_sample;
+    uint32_t total;
+    uint32_t received;
+} sfx_upload_t;
+
+static int g_sample_rate = FMRB_AUDIO_SAMPLE_RATE;
+
+// Control thread state
+static sfx_upload_t g_uploads[FMRB_AUDIO_MAX_APPS];
+static uint32_t g_loaded[FMRB_AUDIO_MAX_APPS];    // Bit per sfx_id installed
+static sfx_ring_t g_cmd_ring;                      // Control -> audio
+static sfx_ring_t g_release_ring;                  // Audio -> control
+static sfx_ring_t g_trigger_ring;                  // Trigger -> audio
+
+// Audio thread state
+static sfx_clip_t *g_bank[FMRB_AUDIO_MAX_APPS][FMRB_SFX_MAX_EFFECTS];
+static sfx_voice_t g_voices[FMRB_SFX_MAX_VOICES];
+static uint32_t g_serial = 0;
+
+static int ring_push(sfx_ring_t *ring, const sfx_msg_t *msg) {
+    unsigned tail = (unsigned)SDL_AtomicGet(&ring->tail);
+    if (tail - (unsigned)SDL_AtomicGet(&ring->head) >= ring->capacity) {
+        return -1;
+    }
+    ring->slots[tail % SFX_RING_SLOTS] = *msg;
+    SDL_AtomicSet(&ring->tail, (int)(tail + 1));
+    return 0;
+}
+
+static int ring_pop(sfx_ring_t *ring, sfx_msg_t *msg) {
+    unsigned head = (unsigned)SDL_AtomicGet(&ring->head);
+    if (head == (unsigned)SDL_AtomicGet(&ring->tail)) {
+        return 0;
+    }
+    *msg = ring->slots[head % SFX_RING_SLOTS];
+    SDL_AtomicSet(&ring->head, (int)(head + 1));
+    return 1;
+}
+
+static void ring_reset(sfx_ring_t *ring, unsigned capacity) {
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+    ring->capacity = capacity;
+}
+
+// Free clips the audio thread has let go of (control thread)
+static void collect_released(void) {
+    sfx_msg_t msg;
+    while (ring_pop(&g_release_ring, &msg)) {
+        free(msg.clip);
+    }
+}
+
+static int post_install(int app, uint8_t id, sfx_clip_t *clip) {
+    collect_released();
+    sfx_msg_t msg = { SFX_MSG_INSTALL, (uint8_t)app, id, 0, 0, 0, clip };
+    if (ring_push(&g_cmd_ring, &msg) < 0) {
+        fprintf(stderr, "Sound effect queue full\n");
+        return -1;
+    }
+    if (clip) {
+        g_loaded[app] |= 1u << id;
+    } else {
+        g_loaded[app] &= ~(1u << id);
+    }
+    return 0;
+}
+
+// ---- Audio thread ----
+
+static void install(const sfx_msg_t *msg) {
+    sfx_clip_t *old = g_bank[msg->app][msg->id];
+    if (old) {
+        for (int v = 0; v < FMRB_SFX_MAX_VOICES; v++) {
+            if (g_voices[v].clip == old) {
+                g_voices[v].clip = NULL;
+            }
+        }
+        sfx_msg_t release = { SFX_MSG_RELEASE, 0, 0, 0, 0, 0, old };
+        ring_push(&g_release_ring, &release);  // Sized for every install in flight
+    }
+    g_bank[msg->app][msg->id] = msg->clip;
+}
+
+static sfx_voice_t *pick_voice(const sfx_clip_t *clip) {
+    sfx_voice_t *oldest_same = NULL;
+    sfx_voice_t *free_voice = NULL;
+    sfx_voice_t *victim = NULL;
+    uint8_t victim_priority = 0;
+    int playing = 0;
+
+    for (int v = 0; v < FMRB_SFX_MAX_VOICES; v++) {
+        sfx_voice_t *voice = &g_voices[v];
+        if (!voice->clip) {
+            if (!free_voice) {
+                free_voice = voice;
+            }
+            continue;
+        }
+        if (voice->clip == clip) {
+            playing++;
+            if (!oldest_same || (int32_t)(voice->serial - oldest_same->serial) < 0) {
+                oldest_same = voice;
+            }
+        }
+        // Lowest priority first, then the oldest
+        uint8_t priority = voice->clip->priority;
+        if (priority <= clip->priority &&
+            (!victim || priority < victim_priority ||
+             (priority == victim_priority && (int32_t)(voice->serial - victim->serial) < 0))) {
+            victim = voice;
+            victim_priority = priority;
+        }
+    }
+
+    if (playing >= clip->max_voices) {
+        return oldest_same;
+    }
+    return free_voice ? free_voice : victim;
+}
+
+static void trigger(const sfx_msg_t *msg) {
+    const sfx_clip_t *clip = g_bank[msg->app][msg->id];
+    if (!clip) {
+        return;
+    }
+    sfx_voice_t *voice = pick_voice(clip);
+    if (!voice) {
+        return;  // Every voice plays something more important
+    }
+
+    // Constant-power pan: -127..127 maps to 0..pi/2
+    const float angle = (msg->pan + 127) * 1.5707963f / 254.0f;
+    const float gain = msg->volume * 32767.0f / 255.0f;
+    const float ratio = powf(2.0f, msg->pitch / 1200.0f);
+
+    voice->clip = clip;
+    voice->app = msg->app;
+    voice->id = msg->id;
+    voice->serial = g_serial++;
+    voice->pos = 0;
+    voice->step = (uint32_t)(clip->rate * ratio * 65536.0f / g_sample_rate);
+    voice->gain_l = (int32_t)(gain * cosf(angle));
+    voice->gain_r = (int32_t)(gain * sinf(angle));
+    if (voice->step == 0) {
+        voice->step = 1;
+    }
+}
+
+void sfx_bank_update(void) {
+    sfx_msg_t msg;
+    // Installs first: an upload acknowledged before a trigger was sent is in place for it
+    while (ring_pop(&g_cmd_ring, &msg)) {
+        install(&msg);
+    }
+    while (ring_pop(&g_trigger_ring, &msg)) {
+        trigger(&msg);
+    }
+}
+
+static inline int16_t saturate16(int32_t v) {
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+int sfx_bank_render(int app, int16_t *out, int frames, int have_audio) {
+    for (int v = 0; v < FMRB_SFX_MAX_VOICES; v++) {
+        sfx_voice_t *voice = &g_voices[v];
+        if (!voice->clip || voice->app != app) {
+            continue;
+        }
+        if (!have_audio) {
+            memset(out, 0, sizeof(int16_t) * 2 * frames);
+            have_audio = 1;
+        }
+
+        const int16_t *pcm = voice->clip->pcm;
+        const uint32_t len = voice->clip->frames;
+        for (int i = 0; i < frames; i++) {
+            const uint32_t idx = (uint32_t)(voice->pos >> 16);
+            if (idx >= len) {
+                voice->clip = NULL;
+                break;
+            }
+            // Linear interpolation toward the next frame (silence after the last)
+            const int32_t a = pcm[idx];
+            const int32_t b = idx + 1 < len ? pcm[idx + 1] : 0;
+            const int32_t s = a + ((b - a) * (int32_t)((voice->pos & 0xFFFF) >> 1) >> 15);
+            out[i * 2] = saturate16(out[i * 2] + (s * voice->gain_l >> 15));
+            out[i * 2 + 1] = saturate16(out[i * 2 + 1] + (s * voice->gain_r >> 15));
+            voice->pos += voice->step;
+        }
+    }
+    return have_audio;
+}
+
+// ---- Control and trigger threads ----
+
+int sfx_bank_init(int sample_rate) {
+    if (sample_rate <= 0) {
+        return -1;
+    }
+    g_sample_rate = sample_rate;
+    memset(g_uploads, 0, sizeof(g_uploads));
+    memset(g_loaded, 0, sizeof(g_loaded));
+    memset(g_bank, 0, sizeof(g_bank));
+    memset(g_voices, 0, sizeof(g_voices));
+    ring_reset(&g_cmd_ring, SFX_QUEUE_SIZE);
+    ring_reset(&g_release_ring, SFX_RING_SLOTS);
+    ring_reset(&g_trigger_ring, SFX_TRIGGER_QUEUE_SIZE);
+    return 0;
+}
+
+void sfx_bank_cleanup(void) {
+    sfx_msg_t msg;
+
+    // Nothing renders any more, so the audio thread's state can be torn down from here
+    while (ring_pop(&g_cmd_ring, &msg)) {
+        install(&msg);
+    }
+    ring_reset(&g_trigger_ring, SFX_TRIGGER_QUEUE_SIZE);
+    collect_released();
+
+    for (int app = 0; app < FMRB_AUDIO_MAX_APPS; app++) {
+        for (int id = 0; id < FMRB_SFX_MAX_EFFECTS; id++) {
+            free(g_bank[app][id]);
+            g_bank[app][id] = NULL;
+        }
+        free(g_uploads[app].clip);
+        g_uploads[app].clip = NULL;
+        g_loaded[app] = 0;
+    }
+    memset(g_voices, 0, sizeof(g_voices));
+}
+
+static void upload_abort(sfx_upload_t *up) {
+    free(up->clip);
+    up->clip = NULL;
+}
+
+int sfx_bank_load(const fmrb_audio_sfx_load_cmd_t *cmd, const uint8_t *data, size_t size) {
+    collect_released();
+
+    const int app = cmd->proc_id;
+    if (app >= FMRB_AUDIO_MAX_APPS || cmd->sfx_id >= FMRB_SFX_MAX_EFFECTS) {
+        fprintf(stderr, "Invalid sound effect %u for app %d\n", cmd->sfx_id, app);
+        return -1;
+    }
+    sfx_upload_t *up = &g_uploads[app];
+
+    if (cmd->offset == 0) {
+        upload_abort(up);
+        const uint8_t bytes = cmd->bits_per_sample / 8;
+        if ((cmd->bits_per_sample != 8 && cmd->bits_per_sample != 16) ||
+            cmd->sample_rate < SFX_MIN_RATE || cmd->sample_rate > SFX_MAX_RATE ||
+            cmd->total_size == 0 || cmd->total_size > FMRB_SFX_MAX_SIZE || cmd->total_size % bytes != 0) {
+            fprintf(stderr, "Invalid sound effect %u: %u Hz, %u bit, %u bytes\n",
+                    cmd->sfx_id, cmd->sample_rate, cmd->bits_per_sample, cmd->total_size);
+            return -1;
+        }
+        const uint32_t frames = cmd->total_size / bytes;
+        up->clip = (sfx_clip_t *)malloc(sizeof(sfx_clip_t) + sizeof(int16_t) * frames);
+        if (!up->clip) {
+            fprintf(stderr, "Failed to allocate sound effect %u\n", cmd->sfx_id);
+            return -1;
+        }
+        up->clip->rate = cmd->sample_rate;
+        up->clip->frames = frames;
+        up->clip->max_voices = cmd->max_voices ? cmd->max_voices : FMRB_SFX_DEFAULT_VOICES;
+        up->clip->priority = cmd->priority;
+        up->id = cmd->sfx_id;
+        up->bytes_per_sample = bytes;
+        up->total = cmd->total_size;
+        up->received = 0;
+    }
+
+    // Chunks must continue the upload in progress and hold whole samples
+    if (!up->clip || cmd->sfx_id != up->id || cmd->offset != up->received ||
+        size > up->total - up->received || size % up->bytes_per_sample != 0) {
+        fprintf(stderr, "Sound effect %u: unexpected chunk at offset %u\n", cmd->sfx_id, cmd->offset);
+        upload_abort(up);
+        return -1;
+    }
+
+    int16_t *dst = up->clip->pcm + up->received / up->bytes_per_sample;
+    const size_t count = size / up->bytes_per_sample;
+    for (size_t i = 0; i < count; i++) {
+        if (up->bytes_per_sample == 1) {
+            dst[i] = (int16_t)(((int)data[i] - 128) << 8);
+        } else {
+            dst[i] = (int16_t)(data[i * 2] | (data[i * 2 + 1] << 8));
+        }
+    }
+    up->received += (uint32_t)size;
+
+    if (up->received == up->total) {
+        sfx_clip_t *clip = up->clip;
+        up->clip = NULL;
+        if (post_install(app, up->id, clip) < 0) {
+            free(clip);
+            return -1;
+        }
+        printf("App %d: loaded sound effect %u (%u frames at %u Hz)\n", app, up->id, clip->frames, clip->rate);
+    }
+    return 0;
+}
+
+int sfx_bank_unload(int app, uint8_t sfx_id) {
+    if (app < 0 || app >= FMRB_AUDIO_MAX_APPS ||
+        (sfx_id >= FMRB_SFX_MAX_EFFECTS && sfx_id != FMRB_SFX_ALL)) {
+        return -1;
+    }
+    if (sfx_id == FMRB_SFX_ALL) {
+        upload_abort(&g_uploads[app]);
+    }
+    for (int id = 0; id < FMRB_SFX_MAX_EFFECTS; id++) {
+        if ((sfx_id == FMRB_SFX_ALL || id == sfx_id) && (g_loaded[app] & (1u << id))) {
+            if (post_install(app, (uint8_t)id, NULL) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int sfx_bank_trigger(const fmrb_audio_sfx_trigger_cmd_t *cmd) {
+    if (cmd->proc_id >= FMRB_AUDIO_MAX_APPS || cmd->sfx_id >= FMRB_SFX_MAX_EFFECTS) {
+        return -1;
+    }
+    int16_t pitch = cmd->pitch;
+    if (pitch > SFX_MAX_PITCH) {
+        pitch = SFX_MAX_PITCH;
+    } else if (pitch < -SFX_MAX_PITCH) {
+        pitch = -SFX_MAX_PITCH;
+    }
+    int8_t pan = cmd->pan < -127 ? -127 : cmd->pan;
+
+    sfx_msg_t msg = { SFX_MSG_TRIGGER, cmd->proc_id, cmd->sfx_id, cmd->volume, pan, pitch, NULL };
+    if (ring_push(&g_trigger_ring, &msg) < 0) {
+        fprintf(stderr, "Sound effect trigger queue full\n");
+        return -1;
+    }
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "socket_server.h"
 #include "graphics_handler.h"
 #include "audio_handler.h"
+#include "link_recorder.h"
 #include "../common/fmrb_link_cobs.h"
 #include "fmrb_link_protocol.h"
 #include <stdio.h>
@@ -11,7 +12,9 @@
 #include <sys/un.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <msgpack.h>
+#include <SDL2/SDL.h>
 
 // Socket server log levels
 typedef enum {
@@ -33,11 +36,35 @@ static sock_log_level_t g_sock_log_level = SOCK_LOG_ERROR;
 extern int init_display_callback(uint16_t width, uint16_t height, uint8_t color_depth);
 
 static int server_fd = -1;
-static int client_fd = -1;
+static int client_fd = -1;         // Set by the receive thread; guarded by send_lock for writers
 static int server_running = 0;
+static int wake_fds[2] = {-1, -1};  // Self-pipe: socket_server_wake() ends socket_server_wait() early
 
 #define SOCKET_PATH "/tmp/fmrb_socket"
 #define BUFFER_SIZE 4096
+#define RECEIVE_POLL_MS 100        // Receive thread re-checks its stop flag at this interval
+
+// Receive thread: reads the socket, COBS/CRC/msgpack decodes and queues messages for the
+// render thread (the one calling socket_server_process), so decoding overlaps drawing and
+// graphics ACKs are not held back by rasterisation.
+static SDL_Thread *receive_thread = NULL;
+static SDL_atomic_t receive_running;
+static SDL_mutex *send_lock = NULL;  // Both threads send (ACKs, FRAME_DONE)
+
+// Decoded message queue: single producer (receive thread), single consumer (render thread)
+#define MSG_QUEUE_SIZE 256         // Power of two
+typedef struct {
+    uint8_t type;
+    uint8_t seq;
+    uint8_t sub_cmd;
+    uint8_t acked;                 // ACK already sent by the receive thread
+    uint16_t len;
+    uint8_t payload[BUFFER_SIZE];
+} queued_msg_t;
+
+static queued_msg_t msg_queue[MSG_QUEUE_SIZE];
+static SDL_atomic_t msg_head;      // Next slot to fill (written by the receive thread only)
+static SDL_atomic_t msg_tail;      // Next slot to consume (written by the render thread only)
 
 static int create_socket_server(void) {
     struct sockaddr_un addr;
@@ -82,8 +109,8 @@ static int accept_connection(void) {
         return 0; // Already connected
     }
 
-    client_fd = accept(server_fd, NULL, NULL);
-    if (client_fd == -1) {
+    int fd = accept(server_fd, NULL, NULL);
+    if (fd == -1) {
         if (errno != EAGAIN && errno != EWOULDBLOCK) {
             fprintf(stderr, "Failed to accept connection: %s\n", strerror(errno));
         }
@@ -91,13 +118,40 @@ static int accept_connection(void) {
     }
 
     // Set non-blocking mode for client socket
-    int flags = fcntl(client_fd, F_GETFL, 0);
-    fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+    SDL_LockMutex(send_lock);
+    client_fd = fd;
+    SDL_UnlockMutex(send_lock);
 
     printf("Client connected\n");
     return 0;
 }
 
+static void close_client(void) {
+    SDL_LockMutex(send_lock);
+    close(client_fd);
+    client_fd = -1;
+    SDL_UnlockMutex(send_lock);
+}
+
+// Reserve the next free queue slot, waiting while the render thread catches up (NULL when stopping)
+static queued_msg_t* msg_queue_reserve(void) {
+    for (;;) {
+        int head = SDL_AtomicGet(&msg_head);
+        if ((unsigned)(head - SDL_AtomicGet(&msg_tail)) < MSG_QUEUE_SIZE) {
+            return &msg_queue[head & (MSG_QUEUE_SIZE - 1)];
+        }
+        if (!SDL_AtomicGet(&receive_running)) {
+            return NULL;
+        }
+        socket_server_wake();
+        SDL_Delay(1);
+    }
+}
+
+// Runs on the receive thread
 static int process_cobs_frame(const uint8_t *encoded_data, size_t encoded_len) {
     // Allocate buffer for decoded data (COBS + CRC32)
     uint8_t *decoded_buffer = (uint8_t*)malloc(encoded_len);
@@ -176,10 +230,60 @@ static int process_cobs_frame(const uint8_t *encoded_data, size_t encoded_len) {
         }
     }
 
+    int result = 0;
+    if (payload_len > BUFFER_SIZE) {
+        fprintf(stderr, "Payload too large: %zu\n", payload_len);
+        result = -1;
+    } else if ((type & 0x7F) == FMRB_LINK_TYPE_AUDIO && sub_cmd == FMRB_AUDIO_CMD_SFX_TRIGGER) {
+        // Sound effects skip the render queue: the audio thread starts them at its next buffer
+        link_recorder_write(type, seq, sub_cmd, payload, payload_len);
+        fmrb_audio_status_t status;
+        result = audio_handler_process_command(payload, payload_len, &status);
+        if (result == 0) {
+            uint8_t status_byte = (uint8_t)status;
+            socket_server_send_ack(type, seq, &status_byte, sizeof(status_byte));
+        }
+    } else {
+        queued_msg_t *slot = msg_queue_reserve();
+        if (slot) {
+            slot->type = type;
+            slot->seq = seq;
+            slot->sub_cmd = sub_cmd;
+            slot->len = (uint16_t)payload_len;
+            if (payload_len > 0) {
+                memcpy(slot->payload, payload, payload_len);
+            }
+            link_recorder_write(type, seq, sub_cmd, payload, payload_len);
+
+            // Graphics commands are acknowledged on receipt; CREATE_CANVAS answers with the new id
+            // and is acknowledged by the render thread once the canvas exists
+            slot->acked = 0;
+            if ((type & 0x7F) == FMRB_LINK_TYPE_GRAPHICS && sub_cmd != FMRB_LINK_GFX_CREATE_CANVAS) {
+                socket_server_send_ack(type, seq, NULL, 0);
+                slot->acked = 1;
+            }
+            SDL_AtomicAdd(&msg_head, 1);
+        } else {
+            result = -1;
+        }
+    }
+
+    // payload points inside decoded_buffer, which was copied above
+    msgpack_unpacked_destroy(&msg);
+    free(decoded_buffer);
+    return result;
+}
+
+// Handle one decoded message; runs on the render thread
+static int dispatch_message(const queued_msg_t *msg) {
+    uint8_t type = msg->type;
+    uint8_t seq = msg->seq;
+    uint8_t sub_cmd = msg->sub_cmd;
+
     // sub_cmd contains the command type, payload contains only structure data
     // Pass sub_cmd as cmd_type to handlers
-    const uint8_t *cmd_buffer = payload;
-    size_t cmd_len = payload_len;
+    const uint8_t *cmd_buffer = msg->payload;
+    size_t cmd_len = msg->len;
 
     // Process based on type
     int result = 0;
@@ -217,6 +321,8 @@ static int process_cobs_frame(const uint8_t *encoded_data, size_t encoded_len) {
                 if (result == 0) {
                     socket_server_send_ack(type, seq, NULL, 0);
                 }
+            } else if (sub_cmd == FMRB_LINK_RESPONSE_MSG_ACK) {
+                // ACK for a host-initiated message (e.g. FRAME_DONE); nothing is retransmitted
             } else {
                 fprintf(stderr, "Unknown control command: 0x%02x\n", sub_cmd);
                 result = -1;
@@ -226,14 +332,29 @@ static int process_cobs_frame(const uint8_t *encoded_data, size_t encoded_len) {
         case FMRB_LINK_TYPE_GRAPHICS:
             // Pass msg_type and sub_cmd as graphics cmd_type
             result = graphics_handler_process_command(type, sub_cmd, seq, cmd_buffer, cmd_len);
-            // Send ACK to prevent retransmission
-            if (result == 0) {
+            // Send ACK to prevent retransmission (unless the receive thread already did)
+            if (result == 0 && !msg->acked) {
                 socket_server_send_ack(type, seq, NULL, 0);
             }
             break;
 
         case FMRB_LINK_TYPE_AUDIO:
-            result = audio_handler_process_command(cmd_buffer, cmd_len);
+            if (sub_cmd == FMRB_LINK_MSG_AUDIO_QUEUE_SAMPLES) {
+                // ACK with the stream buffer fill level so the core can pace itself
+                fmrb_link_audio_queue_status_t queue_status;
+                result = audio_handler_queue_samples(cmd_buffer, cmd_len, &queue_status);
+                if (result == 0) {
+                    socket_server_send_ack(type, seq, (const uint8_t*)&queue_status, sizeof(queue_status));
+                }
+            } else {
+                // ACK with the app's playback status, which is also the GET_STATUS reply
+                fmrb_audio_status_t status;
+                result = audio_handler_process_command(cmd_buffer, cmd_len, &status);
+                if (result == 0) {
+                    uint8_t status_byte = (uint8_t)status;
+                    socket_server_send_ack(type, seq, &status_byte, sizeof(status_byte));
+                }
+            }
             break;
 
         default:
@@ -242,14 +363,12 @@ static int process_cobs_frame(const uint8_t *encoded_data, size_t encoded_len) {
             break;
     }
 
-    // cmd_buffer now points to payload inside decoded_buffer, don't free separately
-    msgpack_unpacked_destroy(&msg);
-    free(decoded_buffer);
     return result;
 }
 
 // Legacy process_message() removed - now using msgpack + COBS protocol via process_cobs_frame()
 
+// Runs on the receive thread
 static int read_message(void) {
     static uint8_t buffer[BUFFER_SIZE];
     static size_t buffer_pos = 0;
@@ -259,12 +378,10 @@ static int read_message(void) {
     if (bytes_read <= 0) {
         if (bytes_read == 0) {
             printf("Client disconnected\n");
-            close(client_fd);
-            client_fd = -1;
+            close_client();
         } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
             fprintf(stderr, "Read error: %s\n", strerror(errno));
-            close(client_fd);
-            client_fd = -1;
+            close_client();
         }
         return -1;
     }
@@ -316,27 +433,31 @@ static int read_message(void) {
         buffer_pos = 0;
     }
 
+    // One wakeup per read batch rather than per message
+    if (messages_processed > 0) {
+        socket_server_wake();
+    }
     return messages_processed;
 }
 
-// Send ACK response with optional payload
-int socket_server_send_ack(uint8_t type, uint8_t seq, const uint8_t *response_data, uint16_t response_len) {
+// Send one frame to the client: msgpack [type, seq, sub_cmd, payload] + CRC32, COBS encoded
+static int send_frame(uint8_t type, uint8_t seq, uint8_t sub_cmd, const uint8_t *response_data, uint16_t response_len) {
     if (client_fd == -1) {
-        fprintf(stderr, "Cannot send ACK: no client connected\n");
+        fprintf(stderr, "Cannot send sub_cmd 0x%02x: no client connected\n", sub_cmd);
         return -1;
     }
 
-    // Build msgpack response: [type, seq, sub_cmd=0xF0 (ACK), payload]
+    // Build msgpack message
     msgpack_sbuffer sbuf;
     msgpack_sbuffer_init(&sbuf);
     msgpack_packer pk;
     msgpack_packer_init(&pk, &sbuf, msgpack_sbuffer_write);
 
-    // Pack as array: [type, seq, 0xF0 (ACK), response_data]
+    // Pack as array: [type, seq, sub_cmd, response_data]
     msgpack_pack_array(&pk, 4);
     msgpack_pack_uint8(&pk, type);
     msgpack_pack_uint8(&pk, seq);
-    msgpack_pack_uint8(&pk, 0xF0);  // ACK sub-command
+    msgpack_pack_uint8(&pk, sub_cmd);
 
     // Pack response data as binary
     if (response_data && response_len > 0) {
@@ -366,7 +487,7 @@ int socket_server_send_ack(uint8_t type, uint8_t seq, const uint8_t *response_da
     free(msg_with_crc);
 
     if (encoded_len == 0) {
-        fprintf(stderr, "COBS encode failed for ACK\n");
+        fprintf(stderr, "COBS encode failed for sub_cmd 0x%02x\n", sub_cmd);
         return -1;
     }
 
@@ -374,15 +495,54 @@ int socket_server_send_ack(uint8_t type, uint8_t seq, const uint8_t *response_da
     encoded_buffer[encoded_len] = 0x00;
     encoded_len++;
 
-    // Send to client
-    ssize_t written = write(client_fd, encoded_buffer, encoded_len);
+    // Send to client (whole frames only: the receive and render threads both send)
+    SDL_LockMutex(send_lock);
+    ssize_t written = client_fd != -1 ? write(client_fd, encoded_buffer, encoded_len) : -1;
+    int write_errno = errno;
+    SDL_UnlockMutex(send_lock);
     if (written != (ssize_t)encoded_len) {
-        fprintf(stderr, "Failed to write ACK response: %zd/%zu (client_fd=%d, errno=%d: %s)\n",
-                written, encoded_len, client_fd, errno, strerror(errno));
+        fprintf(stderr, "Failed to write sub_cmd 0x%02x: %zd/%zu (errno=%d: %s)\n",
+                sub_cmd, written, encoded_len, write_errno, strerror(write_errno));
         return -1;
     }
 
-    SOCK_LOG_D("ACK sent: type=%u seq=%u response_len=%u", type, seq, response_len);
+    SOCK_LOG_D("Sent: type=%u seq=%u sub_cmd=0x%02x len=%u", type, seq, sub_cmd, response_len);
+    return 0;
+}
+
+// Send ACK response with optional payload
+int socket_server_send_ack(uint8_t type, uint8_t seq, const uint8_t *response_data, uint16_t response_len) {
+    return send_frame(type, seq, FMRB_LINK_RESPONSE_MSG_ACK, response_data, response_len);
+}
+
+// Send host-initiated message (the client ACKs it; the ACK is ignored on receipt)
+int socket_server_send_message(uint8_t type, uint8_t sub_cmd, const uint8_t *data, uint16_t len) {
+    static uint8_t next_seq = 0;
+    return send_frame(type, next_seq++, sub_cmd, data, len);
+}
+
+// Receive thread: wait for a connection or data, then decode everything readable into the queue
+static int receive_thread_main(void *arg) {
+    (void)arg;
+    while (SDL_AtomicGet(&receive_running)) {
+        // Listen for a connection only while there is no client (a second one would stay pending)
+        struct pollfd pfd;
+        pfd.fd = client_fd != -1 ? client_fd : server_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, RECEIVE_POLL_MS) <= 0) {
+            continue;
+        }
+
+        if (client_fd == -1) {
+            accept_connection();
+            continue;
+        }
+
+        // read_message() returns -1 once nothing is left (or the client went away)
+        while (client_fd != -1 && read_message() >= 0) {
+        }
+    }
     return 0;
 }
 
@@ -395,11 +555,49 @@ int socket_server_start(void) {
         return -1;
     }
 
+    if (pipe(wake_fds) == -1) {
+        fprintf(stderr, "Failed to create wake pipe: %s\n", strerror(errno));
+        close(server_fd);
+        server_fd = -1;
+        unlink(SOCKET_PATH);
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        int flags = fcntl(wake_fds[i], F_GETFL, 0);
+        fcntl(wake_fds[i], F_SETFL, flags | O_NONBLOCK);
+    }
+
+    // FMRB_RECORD=<file> records every received message for bench/link_replay
+    const char *record_path = getenv("FMRB_RECORD");
+    if (record_path && record_path[0]) {
+        link_recorder_open(record_path);
+    }
+
+    send_lock = SDL_CreateMutex();
+    SDL_AtomicSet(&msg_head, 0);
+    SDL_AtomicSet(&msg_tail, 0);
+    SDL_AtomicSet(&receive_running, 1);
+    receive_thread = send_lock ? SDL_CreateThread(receive_thread_main, "fmrb_receive", NULL) : NULL;
+    if (!receive_thread) {
+        fprintf(stderr, "Failed to start receive thread: %s\n", SDL_GetError());
+        SDL_AtomicSet(&receive_running, 0);
+        socket_server_stop();
+        return -1;
+    }
+
     server_running = 1;
     return 0;
 }
 
 void socket_server_stop(void) {
+    // Stop the receive thread before its descriptors go away
+    SDL_AtomicSet(&receive_running, 0);
+    if (receive_thread) {
+        SDL_WaitThread(receive_thread, NULL);
+        receive_thread = NULL;
+    }
+    link_recorder_close();
+
     if (client_fd != -1) {
         close(client_fd);
         client_fd = -1;
@@ -411,6 +609,18 @@ void socket_server_stop(void) {
         unlink(SOCKET_PATH);
     }
 
+    for (int i = 0; i < 2; i++) {
+        if (wake_fds[i] != -1) {
+            close(wake_fds[i]);
+            wake_fds[i] = -1;
+        }
+    }
+
+    if (send_lock) {
+        SDL_DestroyMutex(send_lock);
+        send_lock = NULL;
+    }
+
     server_running = 0;
     printf("Socket server stopped\n");
 }
@@ -420,15 +630,54 @@ int socket_server_process(void) {
         return 0;
     }
 
-    // Try to accept new connections
-    accept_connection();
+    // Handle everything the receive thread has queued so far
+    int total = 0;
+    for (;;) {
+        int tail = SDL_AtomicGet(&msg_tail);
+        if (tail == SDL_AtomicGet(&msg_head)) {
+            break;
+        }
+        if (dispatch_message(&msg_queue[tail & (MSG_QUEUE_SIZE - 1)]) == 0) {
+            total++;
+        }
+        SDL_AtomicAdd(&msg_tail, 1);  // Slot goes back to the receive thread
+    }
 
-    // Process messages from connected client
-    if (client_fd != -1) {
-        return read_message();
+    return total;
+}
+
+int socket_server_wait(int timeout_ms) {
+    if (!server_running) {
+        return 0;
+    }
+    if (SDL_AtomicGet(&msg_tail) != SDL_AtomicGet(&msg_head)) {
+        return 1;  // Messages already queued
     }
 
-    return 0;
+    struct pollfd pfd;
+    pfd.fd = wake_fds[0];
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ret = poll(&pfd, 1, timeout_ms);
+    if (ret < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    if (pfd.revents & POLLIN) {
+        uint8_t drain[64];
+        while (read(wake_fds[0], drain, sizeof(drain)) > 0) {
+        }
+    }
+    return ret;
+}
+
+void socket_server_wake(void) {
+    // Only write(): safe from signal handlers and the SDL event thread
+    if (wake_fds[1] != -1) {
+        uint8_t byte = 1;
+        ssize_t ret = write(wake_fds[1], &byte, 1);
+        (void)ret;  // A full pipe already guarantees a wakeup
+    }
 }
 
 int socket_server_is_running(void) {
@@ -4,9 +4,16 @@
 class FmrbApp
   attr_reader :name, :running, :window_width, :window_height, :pos_x, :pos_y
 
+  # vsync mode: run on_update once per displayed frame instead of sleeping its return value
+  attr_accessor :vsync
+
+  VSYNC_IDLE_MS = 16   # Host frame period, waited when the last update presented nothing
+  VSYNC_WAIT_MS = 100  # Give up waiting for a frame after this long
+
   def initialize()
     Log.debug("initialize")
     @running = false
+    @vsync = false
     _init() # C function, variables are defined here
     Log.debug("name=#{@name}")
     Log.debug("After _init(), @canvas=#{@canvas}, @window_width=#{@window_width}, @window_height=#{@window_height}")
@@ -21,8 +28,6 @@ class FmrbApp
       @user_area_y1 = @window_height  - 1
       @user_area_width = @window_width - 2
       @user_area_height = @window_height - 12
-
-      draw_window_frame
     else
       @gfx = nil
       Log.debug("Headless app: no graphics initialized")
@@ -30,22 +35,10 @@ class FmrbApp
 
   end
 
-  def draw_window_frame
-    # Draw title bar
-    @gfx.fill_rect(0, 0, @window_width, 11, 0xC5)
-    @gfx.fill_rect(2, 2, 8, 8, 0x60) # menu button
-    @gfx.draw_text(12, 2, @name, FmrbGfx::WHITE)
-
-    # Draw close button (X) on the right side of title bar
-    close_btn_x = @window_width - 10
-    close_btn_y = 2
-    @gfx.fill_rect(close_btn_x, close_btn_y, 8, 8, 0xE0) # red background
-    # Draw X mark (two diagonal lines)
-    @gfx.draw_line(close_btn_x + 2, close_btn_y + 2, close_btn_x + 5, close_btn_y + 5, FmrbGfx::WHITE)
-    @gfx.draw_line(close_btn_x + 5, close_btn_y + 2, close_btn_x + 2, close_btn_y + 5, FmrbGfx::WHITE)
-
-    # Draw window border
-    @gfx.draw_rect(0, 0, @window_width, @window_height, 0x60)
+  # Title shown in the window frame (the frame itself is drawn by the host compositor)
+  def set_title(title)
+    _set_window_title(title.to_s)
+    self
   end
 
   # Lifecycle methods (override in subclass)
@@ -60,10 +53,14 @@ class FmrbApp
   def on_update
     # Called by user defined cycle
     # Update your app logic here
-    # Return: sleep cycle(msec)
+    # Return: sleep cycle(msec) (ignored in vsync mode)
     33 
   end
 
+  # def on_frame(frame)
+  #   Optional: called when the host has displayed this app's latest present
+  # end
+
   def on_destroy
     # Called once when app is destroyed
     # Cleanup resources here
@@ -71,17 +68,18 @@ class FmrbApp
   end
 
   def on_event(ev)
-    # Called from C
-    # Handle close button click
-    if ev[:type] == :mouse_up && ev[:button] == 1
-      close_btn_x = @window_width - 10
-      close_btn_y = 2
-      # Check if click is within close button area
-      if ev[:x] >= close_btn_x && ev[:x] < close_btn_x + 8 &&
-         ev[:y] >= close_btn_y && ev[:y] < close_btn_y + 8
-        stop
-      end
-    end
+    # Called from C with input inside the client area
+  end
+
+  def on_control(data)
+    # Called from C for APP_CONTROL messages other than resize
+    # "close" is sent by the kernel when the frame's close button is clicked
+    stop if data["cmd"] == "close"
+  end
+
+  # Block until everything presented so far is on screen (true), or timeout (false)
+  def wait_frame(timeout_ms = VSYNC_WAIT_MS)
+    _wait_frame(timeout_ms)
   end
 
   # Internal methods
@@ -89,9 +87,24 @@ class FmrbApp
     Log.debug("main_loop started")
     loop do
       return if !@running
-      timeout_ms = on_update
-      Task.pass  # Yield control to other tasks
-      _spin(timeout_ms)
+      if @vsync
+        vsync_step
+      else
+        timeout_ms = on_update
+        Task.pass  # Yield control to other tasks
+        _spin(timeout_ms)
+      end
+    end
+  end
+
+  def vsync_step
+    # Skip the update while earlier frames are still on their way to the display
+    on_update if frames_in_flight == 0
+    Task.pass
+    if frames_in_flight > 0
+      _wait_frame(VSYNC_WAIT_MS)
+    else
+      _spin(VSYNC_IDLE_MS)
     end
   end
 
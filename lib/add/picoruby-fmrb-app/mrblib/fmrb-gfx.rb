@@ -19,4 +19,16 @@ class FmrbGfx
   def initialize(canvas_id)
     _init(canvas_id)
   end
+
+  # Record the drawing done in the block as display list +id+ on the host
+  # @param id [Integer] List id (0..15), redefining replaces the list
+  # @param slot_colors [Array<Integer>, nil] Recorded colors that call_list may replace
+  def define_list(id, slot_colors = nil)
+    _list_begin(id, slot_colors)
+    begin
+      yield
+    ensure
+      _list_end
+    end
+  end
 end
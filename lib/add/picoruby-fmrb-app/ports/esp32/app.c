@@ -16,6 +16,7 @@
 #include "fmrb_hid_msg.h"
 #include "fmrb_task_config.h"
 #include "fmrb_gfx.h"
+#include "fmrb_gfx_msg.h"
 #include "../../include/picoruby_fmrb_app.h"
 #include "app_local.h"
 #include "app_debug.h"
@@ -176,6 +177,17 @@ static mrb_value mrb_fmrb_app_init(mrb_state *mrb, mrb_value self)
 
         FMRB_LOGI(TAG, "Created canvas %u (%dx%d) for app %s",
                  canvas_id, ctx->window_width, ctx->window_height, ctx->app_name);
+
+        // Title bar, border and buttons are drawn by the host compositor (system_gui is the desktop)
+        if (strcmp(ctx->app_name, "system_gui") != 0) {
+            const uint8_t flags = FMRB_GFX_FRAME_FLAG_CLOSE | FMRB_GFX_FRAME_FLAG_RESIZE;
+            ret = fmrb_gfx_set_window_frame(gfx_ctx, canvas_id, FMRB_GFX_FRAME_TITLED, flags, ctx->app_name);
+            if (ret != FMRB_GFX_OK) {
+                mrb_raisef(mrb, E_RUNTIME_ERROR, "Failed to set window frame: %d", ret);
+            }
+            ctx->frame_style = FMRB_GFX_FRAME_TITLED;
+            ctx->frame_flags = flags;
+        }
     } else {
         // Headless app: no canvas, @canvas remains unset (nil)
         FMRB_LOGI(TAG, "Headless app %s: no canvas allocated", ctx->app_name);
@@ -366,18 +378,97 @@ cleanup:
     return true;
 }
 
-static mrb_value mrb_fmrb_app_spin(mrb_state *mrb, mrb_value self)
+// Dispatch one message from the app queue to Ruby; returns false if the app should stop spinning
+static bool dispatch_app_message(mrb_state *mrb, mrb_value self, fmrb_app_task_context_t *ctx, const fmrb_msg_t *msg)
 {
-
-    fmrb_app_task_context_t* ctx = fmrb_current();
-    if (!ctx) {
-        mrb_raise(mrb, E_RUNTIME_ERROR, "No app context available");
+    // Dispatch message based on type
+    if (msg->type == FMRB_MSG_TYPE_HID_EVENT) {
+        bool bret = dispatch_hid_event_to_ruby(mrb, self, msg);
+        if(bret == false){
+            return false;
+        }
+    } else if (msg->type == FMRB_MSG_TYPE_APP_CONTROL) {
+        // Handle APP_CONTROL messages (like resize events)
+        // Unpack msgpack data
+        mrb_value data_str = mrb_str_new(mrb, (const char*)msg->data, msg->size);
+
+        // Get MessagePack module and call unpack as module function
+        struct RClass *msgpack_mod = mrb_module_get(mrb, "MessagePack");
+        mrb_value data_hash = mrb_funcall(mrb, mrb_obj_value(msgpack_mod),
+                                          "unpack", 1, data_str);
+
+        if (mrb_hash_p(data_hash)) {
+            // Check command type
+            mrb_value cmd_val = mrb_hash_get(mrb, data_hash, mrb_str_new_cstr(mrb, "cmd"));
+            if (mrb_string_p(cmd_val)) {
+                const char* cmd = mrb_str_to_cstr(mrb, cmd_val);
+
+                if (strcmp(cmd, "resize") == 0) {
+                    // Handle resize: update instance variables first, then call callback
+                    mrb_value width_val = mrb_hash_get(mrb, data_hash, mrb_str_new_cstr(mrb, "width"));
+                    mrb_value height_val = mrb_hash_get(mrb, data_hash, mrb_str_new_cstr(mrb, "height"));
+
+                    if (mrb_fixnum_p(width_val) && mrb_fixnum_p(height_val)) {
+                        mrb_int new_width = mrb_fixnum(width_val);
+                        mrb_int new_height = mrb_fixnum(height_val);
+
+                        // Update Ruby instance variables
+                        mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@window_width"), mrb_fixnum_value(new_width));
+                        mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@window_height"), mrb_fixnum_value(new_height));
+
+                        // Update user area dimensions
+                        mrb_int user_area_width = new_width - 2;
+                        mrb_int user_area_height = new_height - 12;
+                        mrb_int user_area_x1 = new_width - 1;
+                        mrb_int user_area_y1 = new_height - 1;
+
+                        mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_width"), mrb_fixnum_value(user_area_width));
+                        mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_height"), mrb_fixnum_value(user_area_height));
+                        mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_x1"), mrb_fixnum_value(user_area_x1));
+                        mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_y1"), mrb_fixnum_value(user_area_y1));
+
+                        // Call on_resize callback if it exists
+                        mrb_sym on_resize_sym = mrb_intern_lit(mrb, "on_resize");
+                        if (mrb_respond_to(mrb, self, on_resize_sym)) {
+                            mrb_funcall(mrb, self, "on_resize", 2, width_val, height_val);
+                        }
+                    }
+                } else {
+                    // Other control commands: call on_control if exists
+                    mrb_sym on_control_sym = mrb_intern_lit(mrb, "on_control");
+                    if (mrb_respond_to(mrb, self, on_control_sym)) {
+                        mrb_funcall(mrb, self, "on_control", 1, data_hash);
+                    }
+                }
+            }
+        }
+    } else if (msg->type == FMRB_MSG_TYPE_APP_GFX && msg->size >= sizeof(gfx_frame_event_t)) {
+        // Frame-complete notification from the Host Task
+        gfx_frame_event_t ev;
+        memcpy(&ev, msg->data, sizeof(ev));
+
+        // Ignore reports for presents this app never sent (stale notification for a reused PID)
+        if ((int32_t)(ctx->frames_presented - ev.presented) >= 0) {
+            ctx->frames_displayed = ev.presented;
+            mrb_sym on_frame_sym = mrb_intern_lit(mrb, "on_frame");
+            if (mrb_respond_to(mrb, self, on_frame_sym)) {
+                mrb_funcall(mrb, self, "on_frame", 1, mrb_fixnum_value((mrb_int)ev.frame));
+            }
+        }
+    } else {
+        FMRB_LOGI(TAG, "App %s message type %d not handled", ctx->app_name, msg->type);
     }
-    FMRB_LOGD(TAG, ">>>>>>>>> _spin(%s) START >>>>>>>>>>>>>",ctx->app_name);
-    mrb_set_in_c_funcall(mrb, MRB_C_FUNCALL_ENTER);
 
-    mrb_int timeout_ms;
-    mrb_get_args(mrb, "i", &timeout_ms);
+    return true;
+}
+
+// Process messages for up to timeout_ms.
+// With until_frame, return early once every PRESENT sent so far has been displayed.
+// Returns 1 if caught up with the display, 0 on timeout, -1 if dispatch failed.
+static int app_spin(mrb_state *mrb, mrb_value self, fmrb_app_task_context_t *ctx, mrb_int timeout_ms, bool until_frame)
+{
+    int result = 0;
+    mrb_set_in_c_funcall(mrb, MRB_C_FUNCALL_ENTER);
 
     // Record start time to ensure we wait for the full timeout period
     fmrb_tick_t start_tick = fmrb_task_get_tick_count();
@@ -385,6 +476,11 @@ static mrb_value mrb_fmrb_app_spin(mrb_state *mrb, mrb_value self)
 
     // Spin Loop - process messages until timeout expires
     while(true){
+        if (until_frame && ctx->frames_displayed == ctx->frames_presented) {
+            result = 1;
+            break;
+        }
+
         // Calculate remaining time
         fmrb_tick_t current_tick = fmrb_task_get_tick_count();
         if (current_tick >= target_tick) {
@@ -399,69 +495,8 @@ static mrb_value mrb_fmrb_app_spin(mrb_state *mrb, mrb_value self)
         fmrb_err_t ret = fmrb_msg_receive(ctx->app_id, &msg, remaining_ticks);
 
         if (ret == FMRB_OK) {
-            // Dispatch message based on type
-            if (msg.type == FMRB_MSG_TYPE_HID_EVENT) {
-                bool bret = dispatch_hid_event_to_ruby(mrb, self, &msg);
-                if(bret == false){
-                    return mrb_nil_value();
-                }
-            } else if (msg.type == FMRB_MSG_TYPE_APP_CONTROL) {
-                // Handle APP_CONTROL messages (like resize events)
-                // Unpack msgpack data
-                mrb_value data_str = mrb_str_new(mrb, (const char*)msg.data, msg.size);
-
-                // Get MessagePack module and call unpack as module function
-                struct RClass *msgpack_mod = mrb_module_get(mrb, "MessagePack");
-                mrb_value data_hash = mrb_funcall(mrb, mrb_obj_value(msgpack_mod),
-                                                  "unpack", 1, data_str);
-
-                if (mrb_hash_p(data_hash)) {
-                    // Check command type
-                    mrb_value cmd_val = mrb_hash_get(mrb, data_hash, mrb_str_new_cstr(mrb, "cmd"));
-                    if (mrb_string_p(cmd_val)) {
-                        const char* cmd = mrb_str_to_cstr(mrb, cmd_val);
-
-                        if (strcmp(cmd, "resize") == 0) {
-                            // Handle resize: update instance variables first, then call callback
-                            mrb_value width_val = mrb_hash_get(mrb, data_hash, mrb_str_new_cstr(mrb, "width"));
-                            mrb_value height_val = mrb_hash_get(mrb, data_hash, mrb_str_new_cstr(mrb, "height"));
-
-                            if (mrb_fixnum_p(width_val) && mrb_fixnum_p(height_val)) {
-                                mrb_int new_width = mrb_fixnum(width_val);
-                                mrb_int new_height = mrb_fixnum(height_val);
-
-                                // Update Ruby instance variables
-                                mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@window_width"), mrb_fixnum_value(new_width));
-                                mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@window_height"), mrb_fixnum_value(new_height));
-
-                                // Update user area dimensions
-                                mrb_int user_area_width = new_width - 2;
-                                mrb_int user_area_height = new_height - 12;
-                                mrb_int user_area_x1 = new_width - 1;
-                                mrb_int user_area_y1 = new_height - 1;
-
-                                mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_width"), mrb_fixnum_value(user_area_width));
-                                mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_height"), mrb_fixnum_value(user_area_height));
-                                mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_x1"), mrb_fixnum_value(user_area_x1));
-                                mrb_iv_set(mrb, self, mrb_intern_lit(mrb, "@user_area_y1"), mrb_fixnum_value(user_area_y1));
-
-                                // Call on_resize callback if it exists
-                                mrb_sym on_resize_sym = mrb_intern_lit(mrb, "on_resize");
-                                if (mrb_respond_to(mrb, self, on_resize_sym)) {
-                                    mrb_funcall(mrb, self, "on_resize", 2, width_val, height_val);
-                                }
-                            }
-                        } else {
-                            // Other control commands: call on_control if exists
-                            mrb_sym on_control_sym = mrb_intern_lit(mrb, "on_control");
-                            if (mrb_respond_to(mrb, self, on_control_sym)) {
-                                mrb_funcall(mrb, self, "on_control", 1, data_hash);
-                            }
-                        }
-                    }
-                }
-            } else {
-                FMRB_LOGI(TAG, "App %s message type %d not handled", ctx->app_name, msg.type);
+            if (!dispatch_app_message(mrb, self, ctx, &msg)) {
+                return -1;
             }
 
             // Continue loop to process more messages or wait for remaining time
@@ -488,17 +523,69 @@ static mrb_value mrb_fmrb_app_spin(mrb_state *mrb, mrb_value self)
     mrb_int elapsed_ms = pdTICKS_TO_MS(elapsed_ticks);
     mrb_int missed_ticks = (elapsed_ms + MRB_TICK_UNIT - 1) / MRB_TICK_UNIT;  // Round up
 
-    FMRB_LOGD(TAG, "_spin(%s): elapsed=%ldms, compensating %ld ticks",
+    FMRB_LOGD(TAG, "spin(%s): elapsed=%ldms, compensating %ld ticks",
               ctx->app_name, (long)elapsed_ms, (long)missed_ticks);
 
     for (mrb_int i = 0; i < missed_ticks; i++) {
         mrb_tick(mrb);
     }
 
+    return result;
+}
+
+static mrb_value mrb_fmrb_app_spin(mrb_state *mrb, mrb_value self)
+{
+
+    fmrb_app_task_context_t* ctx = fmrb_current();
+    if (!ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "No app context available");
+    }
+    FMRB_LOGD(TAG, ">>>>>>>>> _spin(%s) START >>>>>>>>>>>>>",ctx->app_name);
+
+    mrb_int timeout_ms;
+    mrb_get_args(mrb, "i", &timeout_ms);
+
+    app_spin(mrb, self, ctx, timeout_ms, false);
+
     FMRB_LOGD(TAG, "<<<<<<<<< _spin(%s) END <<<<<<<<<<<<<",ctx->app_name);
     return mrb_nil_value();
 }
 
+// FmrbApp#wait_frame(timeout_ms) - Block until every PRESENT so far is on screen
+// Returns true when caught up, false on timeout (unreported frames are then written off).
+// Messages are dispatched while waiting.
+static mrb_value mrb_fmrb_app_wait_frame(mrb_state *mrb, mrb_value self)
+{
+    fmrb_app_task_context_t* ctx = fmrb_current();
+    if (!ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "No app context available");
+    }
+
+    mrb_int timeout_ms;
+    mrb_get_args(mrb, "i", &timeout_ms);
+
+    if (app_spin(mrb, self, ctx, timeout_ms, true) == 1) {
+        return mrb_true_value();
+    }
+
+    // No report in time: a PRESENT that failed on the Host Task never gets one, so count
+    // everything as displayed rather than leaving frames in flight forever
+    FMRB_LOGD(TAG, "wait_frame(%s): %lu frames unreported, resyncing", ctx->app_name,
+              (unsigned long)(ctx->frames_presented - ctx->frames_displayed));
+    ctx->frames_displayed = ctx->frames_presented;
+    return mrb_false_value();
+}
+
+// FmrbApp#frames_in_flight - PRESENTs sent but not yet reported on screen
+static mrb_value mrb_fmrb_app_frames_in_flight(mrb_state *mrb, mrb_value self)
+{
+    fmrb_app_task_context_t* ctx = fmrb_current();
+    if (!ctx) {
+        return mrb_fixnum_value(0);
+    }
+    return mrb_fixnum_value((mrb_int)(ctx->frames_presented - ctx->frames_displayed));
+}
+
 // FmrbApp#_cleanup() - Cleanup app resources (canvas, message queue)
 // Called from Ruby destroy() method when app terminates
 static mrb_value mrb_fmrb_app_cleanup(mrb_state *mrb, mrb_value self)
@@ -574,6 +661,29 @@ static mrb_value mrb_fmrb_app_set_window_param(mrb_state *mrb, mrb_value self)
     return self;
 }
 
+// FmrbApp#_set_window_title(title) -> self
+// Change the title drawn in the window frame
+static mrb_value mrb_fmrb_app_set_window_title(mrb_state *mrb, mrb_value self)
+{
+    const char* title;
+    mrb_get_args(mrb, "z", &title);
+
+    fmrb_app_task_context_t* ctx = fmrb_current();
+    if (!ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "No app context available");
+    }
+    if (ctx->frame_style == FMRB_GFX_FRAME_NONE) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Window has no title bar");
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_window_title(fmrb_gfx_get_global_context(), ctx->canvas_id, title);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "Failed to set window title: %d", ret);
+    }
+
+    return self;
+}
+
 // FmrbApp#_send_message(dest_pid, msg_type, data) -> bool
 // Send a message to another task
 static mrb_value mrb_fmrb_app_send_message(mrb_state *mrb, mrb_value self)
@@ -762,9 +872,12 @@ void mrb_picoruby_fmrb_app_init_impl(mrb_state *mrb)
     // Instance methods (called from Ruby instances)
     mrb_define_method(mrb, app_class, "_init", mrb_fmrb_app_init, MRB_ARGS_NONE());
     mrb_define_method(mrb, app_class, "_spin", mrb_fmrb_app_spin, MRB_ARGS_REQ(1));
+    mrb_define_method(mrb, app_class, "_wait_frame", mrb_fmrb_app_wait_frame, MRB_ARGS_REQ(1));
+    mrb_define_method(mrb, app_class, "frames_in_flight", mrb_fmrb_app_frames_in_flight, MRB_ARGS_NONE());
     mrb_define_method(mrb, app_class, "_cleanup", mrb_fmrb_app_cleanup, MRB_ARGS_NONE());
     mrb_define_method(mrb, app_class, "_send_message", mrb_fmrb_app_send_message, MRB_ARGS_REQ(3));
     mrb_define_method(mrb, app_class, "_set_window_param", mrb_fmrb_app_set_window_param, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, app_class, "_set_window_title", mrb_fmrb_app_set_window_title, MRB_ARGS_REQ(1));
 
     // Class methods
     mrb_define_class_method(mrb, app_class, "ps", mrb_fmrb_app_s_ps, MRB_ARGS_NONE());
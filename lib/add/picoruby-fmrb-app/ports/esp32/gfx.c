@@ -1,6 +1,7 @@
 #include <string.h>
 #include <mruby.h>
 #include <mruby/class.h>
+#include <mruby/array.h>
 #include <mruby/data.h>
 #include <mruby/string.h>
 #include <mruby/variable.h>
@@ -19,28 +20,6 @@
 
 static const char* TAG = "gfx";
 
-// Helper function to send GFX command message to Host Task
-static fmrb_err_t send_gfx_command(const gfx_cmd_t *cmd) {
-    fmrb_app_task_context_t *ctx = fmrb_current();
-    if (!ctx) {
-        FMRB_LOGE(TAG, "Failed to get current task context");
-        return FMRB_ERR_INVALID_STATE;
-    }
-
-    fmrb_msg_t msg = {
-        .type = FMRB_MSG_TYPE_APP_GFX,
-        .src_pid = ctx->app_id,
-        .size = sizeof(gfx_cmd_t)
-    };
-    memcpy(msg.data, cmd, sizeof(gfx_cmd_t));
-
-    fmrb_err_t ret = fmrb_msg_send(PROC_ID_HOST, &msg, 100);
-    if (ret != FMRB_OK) {
-        FMRB_LOGE(TAG, "Failed to send graphics command: %d", ret);
-    }
-    return ret;
-}
-
 // Graphics context wrapper for mruby
 typedef struct {
     fmrb_gfx_context_t ctx;
@@ -110,7 +89,7 @@ static mrb_value mrb_gfx_clear(mrb_state *mrb, mrb_value self)
         .params.clear.color = (fmrb_color_t)color
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         FMRB_LOGE(TAG, "clear() failed: %d", ret);
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Graphics clear failed: %d", ret);
@@ -138,7 +117,7 @@ static mrb_value mrb_gfx_set_pixel(mrb_state *mrb, mrb_value self)
         .params.pixel = {.x = (int16_t)x, .y = (int16_t)y, .color = (fmrb_color_t)color}
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Set pixel failed: %d", ret);
     }
@@ -168,7 +147,7 @@ static mrb_value mrb_gfx_draw_line(mrb_state *mrb, mrb_value self)
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Draw line failed: %d", ret);
     }
@@ -198,7 +177,7 @@ static mrb_value mrb_gfx_draw_rect(mrb_state *mrb, mrb_value self)
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Draw rect failed: %d", ret);
     }
@@ -231,9 +210,9 @@ static mrb_value mrb_gfx_fill_rect(mrb_state *mrb, mrb_value self)
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
-        FMRB_LOGE("gfx", "fill_rect send_gfx_command failed: %d", ret);
+        FMRB_LOGE("gfx", "fill_rect fmrb_gfx_msg_send failed: %d", ret);
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Fill rect failed: %d", ret);
     }
 
@@ -265,7 +244,7 @@ static mrb_value mrb_gfx_draw_circle(mrb_state *mrb, mrb_value self)
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Draw circle failed: %d", ret);
     }
@@ -300,15 +279,547 @@ static mrb_value mrb_gfx_fill_circle(mrb_state *mrb, mrb_value self)
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
-        FMRB_LOGE("gfx", "fill_circle send_gfx_command failed: %d", ret);
+        FMRB_LOGE("gfx", "fill_circle fmrb_gfx_msg_send failed: %d", ret);
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Fill circle failed: %d", ret);
     }
 
     return self;
 }
 
+// Send a rounded rectangle command (shared by draw_round_rect / fill_round_rect)
+static mrb_value gfx_round_rect_common(mrb_state *mrb, mrb_value self, bool filled)
+{
+    mrb_int x, y, w, h, r, color;
+    mrb_get_args(mrb, "iiiiii", &x, &y, &w, &h, &r, &color);
+
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_ROUND_RECT,
+        .canvas_id = data->canvas_id,
+        .params.round_rect = {
+            .rect = {(int16_t)x, (int16_t)y, (uint16_t)w, (uint16_t)h},
+            .radius = (int16_t)r,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "%s round rect failed: %d", filled ? "Fill" : "Draw", ret);
+    }
+
+    return self;
+}
+
+// Graphics#draw_round_rect(x, y, w, h, r, color)
+static mrb_value mrb_gfx_draw_round_rect(mrb_state *mrb, mrb_value self)
+{
+    return gfx_round_rect_common(mrb, self, false);
+}
+
+// Graphics#fill_round_rect(x, y, w, h, r, color)
+static mrb_value mrb_gfx_fill_round_rect(mrb_state *mrb, mrb_value self)
+{
+    return gfx_round_rect_common(mrb, self, true);
+}
+
+// Send an ellipse command (shared by draw_ellipse / fill_ellipse)
+static mrb_value gfx_ellipse_common(mrb_state *mrb, mrb_value self, bool filled)
+{
+    mrb_int x, y, rx, ry, color;
+    mrb_get_args(mrb, "iiiii", &x, &y, &rx, &ry, &color);
+
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_ELLIPSE,
+        .canvas_id = data->canvas_id,
+        .params.ellipse = {
+            .x = (int16_t)x,
+            .y = (int16_t)y,
+            .rx = (int16_t)rx,
+            .ry = (int16_t)ry,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "%s ellipse failed: %d", filled ? "Fill" : "Draw", ret);
+    }
+
+    return self;
+}
+
+// Graphics#draw_ellipse(x, y, rx, ry, color)
+static mrb_value mrb_gfx_draw_ellipse(mrb_state *mrb, mrb_value self)
+{
+    return gfx_ellipse_common(mrb, self, false);
+}
+
+// Graphics#fill_ellipse(x, y, rx, ry, color)
+static mrb_value mrb_gfx_fill_ellipse(mrb_state *mrb, mrb_value self)
+{
+    return gfx_ellipse_common(mrb, self, true);
+}
+
+// Send a triangle command (shared by draw_triangle / fill_triangle)
+static mrb_value gfx_triangle_common(mrb_state *mrb, mrb_value self, bool filled)
+{
+    mrb_int x0, y0, x1, y1, x2, y2, color;
+    mrb_get_args(mrb, "iiiiiii", &x0, &y0, &x1, &y1, &x2, &y2, &color);
+
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_TRIANGLE,
+        .canvas_id = data->canvas_id,
+        .params.triangle = {
+            .x0 = (int16_t)x0, .y0 = (int16_t)y0,
+            .x1 = (int16_t)x1, .y1 = (int16_t)y1,
+            .x2 = (int16_t)x2, .y2 = (int16_t)y2,
+            .color = (fmrb_color_t)color,
+            .filled = filled
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "%s triangle failed: %d", filled ? "Fill" : "Draw", ret);
+    }
+
+    return self;
+}
+
+// Graphics#draw_triangle(x0, y0, x1, y1, x2, y2, color)
+static mrb_value mrb_gfx_draw_triangle(mrb_state *mrb, mrb_value self)
+{
+    return gfx_triangle_common(mrb, self, false);
+}
+
+// Graphics#fill_triangle(x0, y0, x1, y1, x2, y2, color)
+static mrb_value mrb_gfx_fill_triangle(mrb_state *mrb, mrb_value self)
+{
+    return gfx_triangle_common(mrb, self, true);
+}
+
+// Send a point-list command; points is a flat Array [x0, y0, x1, y1, ...]
+static mrb_value gfx_points_common(mrb_state *mrb, mrb_value self, gfx_cmd_type_t cmd_type, bool filled)
+{
+    mrb_value ary;
+    mrb_int color;
+    mrb_get_args(mrb, "Ai", &ary, &color);
+
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+
+    mrb_int len = RARRAY_LEN(ary);
+    if (len % 2 != 0 || len / 2 > UINT16_MAX) {
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "points must be a flat array of x, y pairs");
+    }
+    uint16_t count = (uint16_t)(len / 2);
+
+    // Scratch buffer owned by the GC so a raise below does not leak it
+    mrb_value buf = mrb_str_new(mrb, NULL, sizeof(fmrb_point_t) * count);
+    fmrb_point_t *points = (fmrb_point_t *)RSTRING_PTR(buf);
+    for (mrb_int i = 0; i < len; i++) {
+        mrb_value v = mrb_ary_ref(mrb, ary, i);
+        if (!mrb_integer_p(v)) {
+            mrb_raise(mrb, E_TYPE_ERROR, "point coordinates must be Integer");
+        }
+        if (i % 2 == 0) {
+            points[i / 2].x = (int16_t)mrb_integer(v);
+        } else {
+            points[i / 2].y = (int16_t)mrb_integer(v);
+        }
+    }
+
+    fmrb_err_t ret = fmrb_gfx_msg_send_points(cmd_type, data->canvas_id, points, count,
+                                              (fmrb_color_t)color, filled);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "Point list command %d failed: %d", cmd_type, ret);
+    }
+
+    return self;
+}
+
+// Graphics#draw_polyline(points, color)
+static mrb_value mrb_gfx_draw_polyline(mrb_state *mrb, mrb_value self)
+{
+    return gfx_points_common(mrb, self, GFX_CMD_POLYLINE, false);
+}
+
+// Graphics#draw_polygon(points, color)
+static mrb_value mrb_gfx_draw_polygon(mrb_state *mrb, mrb_value self)
+{
+    return gfx_points_common(mrb, self, GFX_CMD_POLYGON, false);
+}
+
+// Graphics#fill_polygon(points, color)
+static mrb_value mrb_gfx_fill_polygon(mrb_state *mrb, mrb_value self)
+{
+    return gfx_points_common(mrb, self, GFX_CMD_POLYGON, true);
+}
+
+// Graphics#draw_points(points, color)
+static mrb_value mrb_gfx_draw_points(mrb_state *mrb, mrb_value self)
+{
+    return gfx_points_common(mrb, self, GFX_CMD_POINTS, false);
+}
+
+// Graphics#copy_rect(src_x, src_y, w, h, dst_x, dst_y [, dst_canvas])
+static mrb_value mrb_gfx_copy_rect(mrb_state *mrb, mrb_value self)
+{
+    mrb_int src_x, src_y, w, h, dst_x, dst_y;
+    mrb_int dst_canvas = -1;
+    mrb_get_args(mrb, "iiiiii|i", &src_x, &src_y, &w, &h, &dst_x, &dst_y, &dst_canvas);
+
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_COPY_RECT,
+        .canvas_id = data->canvas_id,
+        .params.copy_rect = {
+            .src_rect = { .x = (int16_t)src_x, .y = (int16_t)src_y, .width = (uint16_t)w, .height = (uint16_t)h },
+            .dst_canvas_id = dst_canvas < 0 ? data->canvas_id : (fmrb_canvas_handle_t)dst_canvas,
+            .dst_x = (int16_t)dst_x,
+            .dst_y = (int16_t)dst_y
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "Copy rect failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#scroll_rect(x, y, w, h, dx, dy, fill_color)
+static mrb_value mrb_gfx_scroll_rect(mrb_state *mrb, mrb_value self)
+{
+    mrb_int x, y, w, h, dx, dy, fill_color;
+    mrb_get_args(mrb, "iiiiiii", &x, &y, &w, &h, &dx, &dy, &fill_color);
+
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_SCROLL_RECT,
+        .canvas_id = data->canvas_id,
+        .params.scroll_rect = {
+            .rect = { .x = (int16_t)x, .y = (int16_t)y, .width = (uint16_t)w, .height = (uint16_t)h },
+            .dx = (int16_t)dx,
+            .dy = (int16_t)dy,
+            .fill_color = (fmrb_color_t)fill_color
+        }
+    };
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "Scroll rect failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Tile layers are long-lived host resources, so these call fmrb_gfx directly
+// (like canvas creation) instead of going through the per-frame command buffer.
+
+static mrb_gfx_data *gfx_get_data(mrb_state *mrb, mrb_value self)
+{
+    mrb_gfx_data *data = (mrb_gfx_data *)mrb_data_get_ptr(mrb, self, &mrb_gfx_data_type);
+    if (!data || !data->ctx) {
+        mrb_raise(mrb, E_RUNTIME_ERROR, "Graphics not initialized");
+    }
+    return data;
+}
+
+// Graphics#tilemap_create(layer, tile_w, tile_h, map_w, map_h [, transparent_color])
+static mrb_value mrb_gfx_tilemap_create(mrb_state *mrb, mrb_value self)
+{
+    mrb_int layer, tile_w, tile_h, map_w, map_h;
+    mrb_int transparent_color = 0xFF;
+    mrb_get_args(mrb, "iiiii|i", &layer, &tile_w, &tile_h, &map_w, &map_h, &transparent_color);
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_create(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                 (uint8_t)tile_w, (uint8_t)tile_h,
+                                                 (uint16_t)map_w, (uint16_t)map_h,
+                                                 (fmrb_color_t)transparent_color);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "tilemap_create failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#tilemap_sheet(layer, sheet_w, sheet_h, pixels)  pixels: RGB332 String
+static mrb_value mrb_gfx_tilemap_sheet(mrb_state *mrb, mrb_value self)
+{
+    mrb_int layer, sheet_w, sheet_h;
+    char *pixels;
+    mrb_int len;
+    mrb_get_args(mrb, "iiis", &layer, &sheet_w, &sheet_h, &pixels, &len);
+
+    if (sheet_w <= 0 || sheet_h <= 0 || len != sheet_w * sheet_h) {
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "pixels must be sheet_w * sheet_h bytes");
+    }
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_set_sheet(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                    (const uint8_t *)pixels,
+                                                    (uint16_t)sheet_w, (uint16_t)sheet_h);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "tilemap_sheet failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#tilemap_set_cells(layer, x, y, w, tiles)  tiles: Array of w * h tile indices
+static mrb_value mrb_gfx_tilemap_set_cells(mrb_state *mrb, mrb_value self)
+{
+    mrb_int layer, x, y, w;
+    mrb_value ary;
+    mrb_get_args(mrb, "iiiiA", &layer, &x, &y, &w, &ary);
+
+    mrb_int len = RARRAY_LEN(ary);
+    if (w <= 0 || len == 0 || len % w != 0) {
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "tiles must hold whole rows of w cells");
+    }
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+
+    // Scratch buffer owned by the GC so a raise below does not leak it
+    mrb_value buf = mrb_str_new(mrb, NULL, len);
+    uint8_t *tiles = (uint8_t *)RSTRING_PTR(buf);
+    for (mrb_int i = 0; i < len; i++) {
+        mrb_value v = mrb_ary_ref(mrb, ary, i);
+        if (!mrb_integer_p(v)) {
+            mrb_raise(mrb, E_TYPE_ERROR, "tile indices must be Integer");
+        }
+        tiles[i] = (uint8_t)mrb_integer(v);
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_set_cells(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                    (uint16_t)x, (uint16_t)y,
+                                                    (uint16_t)w, (uint16_t)(len / w), tiles);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "tilemap_set_cells failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#tilemap_set_cell(layer, x, y, tile)
+static mrb_value mrb_gfx_tilemap_set_cell(mrb_state *mrb, mrb_value self)
+{
+    mrb_int layer, x, y, tile;
+    mrb_get_args(mrb, "iiii", &layer, &x, &y, &tile);
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    uint8_t cell = (uint8_t)tile;
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_set_cells(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                    (uint16_t)x, (uint16_t)y, 1, 1, &cell);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "tilemap_set_cell failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#tilemap_scroll(layer, x, y)
+static mrb_value mrb_gfx_tilemap_scroll(mrb_state *mrb, mrb_value self)
+{
+    mrb_int layer, x, y;
+    mrb_get_args(mrb, "iii", &layer, &x, &y);
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_scroll(data->ctx, data->canvas_id, (uint8_t)layer,
+                                                 (int16_t)x, (int16_t)y);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "tilemap_scroll failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#tilemap_delete(layer)
+static mrb_value mrb_gfx_tilemap_delete(mrb_state *mrb, mrb_value self)
+{
+    mrb_int layer;
+    mrb_get_args(mrb, "i", &layer);
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    fmrb_gfx_err_t ret = fmrb_gfx_tilemap_delete(data->ctx, data->canvas_id, (uint8_t)layer);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "tilemap_delete failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Copy an Array of RGB332 colors into buf (raises on non-Integer entries)
+static void gfx_colors_from_array(mrb_state *mrb, mrb_value ary, fmrb_color_t *buf, mrb_int len)
+{
+    for (mrb_int i = 0; i < len; i++) {
+        mrb_value v = mrb_ary_ref(mrb, ary, i);
+        if (!mrb_integer_p(v)) {
+            mrb_raise(mrb, E_TYPE_ERROR, "colors must be Integer");
+        }
+        buf[i] = (fmrb_color_t)mrb_integer(v);
+    }
+}
+
+// Graphics#set_palette(colors)  colors: Array of 256 RGB332 values, or nil for direct color
+static mrb_value mrb_gfx_set_palette(mrb_state *mrb, mrb_value self)
+{
+    mrb_value ary;
+    mrb_get_args(mrb, "A!", &ary);
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    fmrb_color_t palette[256];
+    const fmrb_color_t *p = NULL;
+    if (!mrb_nil_p(ary)) {
+        if (RARRAY_LEN(ary) != 256) {
+            mrb_raise(mrb, E_ARGUMENT_ERROR, "palette must have 256 entries");
+        }
+        gfx_colors_from_array(mrb, ary, palette, 256);
+        p = palette;
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_palette(data->ctx, data->canvas_id, p);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "set_palette failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Graphics#set_palette_range(start, colors)
+static mrb_value mrb_gfx_set_palette_range(mrb_state *mrb, mrb_value self)
+{
+    mrb_int start;
+    mrb_value ary;
+    mrb_get_args(mrb, "iA", &start, &ary);
+
+    mrb_int len = RARRAY_LEN(ary);
+    if (start < 0 || len == 0 || start + len > 256) {
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "palette range out of bounds");
+    }
+
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    fmrb_color_t colors[256];
+    gfx_colors_from_array(mrb, ary, colors, len);
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_palette_range(data->ctx, data->canvas_id, (uint8_t)start,
+                                                    (uint16_t)len, colors);
+    if (ret != FMRB_GFX_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "set_palette_range failed: %d", ret);
+    }
+
+    return self;
+}
+
+// Display list commands are buffered like drawing, so a list recorded inside
+// a frame is defined before the CALL_LIST that follows it.
+
+// Send one GFX_CMD_LIST operation; colors may be nil
+static void gfx_send_list_op(mrb_state *mrb, mrb_value self, fmrb_gfx_list_op_t op, mrb_int list_id,
+                             mrb_int dx, mrb_int dy, mrb_value colors)
+{
+    mrb_gfx_data *data = gfx_get_data(mrb, self);
+    if (list_id < 0 || list_id >= FMRB_GFX_MAX_LISTS) {
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "list id out of range");
+    }
+
+    gfx_cmd_t cmd = {
+        .cmd_type = GFX_CMD_LIST,
+        .canvas_id = data->canvas_id,
+        .params.list = {
+            .op = op,
+            .list_id = (uint8_t)list_id,
+            .dx = (int16_t)dx,
+            .dy = (int16_t)dy
+        }
+    };
+    if (!mrb_nil_p(colors)) {
+        mrb_int len = RARRAY_LEN(colors);
+        if (len > FMRB_GFX_LIST_MAX_SLOTS) {
+            mrb_raise(mrb, E_ARGUMENT_ERROR, "too many list colors");
+        }
+        gfx_colors_from_array(mrb, colors, cmd.params.list.colors, len);
+        cmd.params.list.color_count = (uint8_t)len;
+    }
+
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
+    if (ret != FMRB_OK) {
+        mrb_raisef(mrb, E_RUNTIME_ERROR, "Display list command failed: %d", ret);
+    }
+}
+
+// Graphics#_list_begin(id, slot_colors)  (see FmrbGfx#define_list)
+static mrb_value mrb_gfx_list_begin(mrb_state *mrb, mrb_value self)
+{
+    mrb_int list_id;
+    mrb_value slots;
+    mrb_get_args(mrb, "iA!", &list_id, &slots);
+
+    gfx_send_list_op(mrb, self, FMRB_GFX_LIST_BEGIN, list_id, 0, 0, slots);
+    return self;
+}
+
+// Graphics#_list_end
+static mrb_value mrb_gfx_list_end(mrb_state *mrb, mrb_value self)
+{
+    gfx_send_list_op(mrb, self, FMRB_GFX_LIST_END, 0, 0, 0, mrb_nil_value());
+    return self;
+}
+
+// Graphics#call_list(id [, x, y [, colors]])  colors replace the list's slot colors in order
+static mrb_value mrb_gfx_call_list(mrb_state *mrb, mrb_value self)
+{
+    mrb_int list_id;
+    mrb_int x = 0, y = 0;
+    mrb_value colors = mrb_nil_value();
+    mrb_get_args(mrb, "i|iiA!", &list_id, &x, &y, &colors);
+
+    gfx_send_list_op(mrb, self, FMRB_GFX_LIST_CALL, list_id, x, y, colors);
+    return self;
+}
+
+// Graphics#delete_list(id)
+static mrb_value mrb_gfx_delete_list(mrb_state *mrb, mrb_value self)
+{
+    mrb_int list_id;
+    mrb_get_args(mrb, "i", &list_id);
+
+    gfx_send_list_op(mrb, self, FMRB_GFX_LIST_DELETE, list_id, 0, 0, mrb_nil_value());
+    return self;
+}
+
 // Graphics#draw_text(x, y, text, color [, bg_color])
 static mrb_value mrb_gfx_draw_text(mrb_state *mrb, mrb_value self)
 {
@@ -349,9 +860,9 @@ static mrb_value mrb_gfx_draw_text(mrb_state *mrb, mrb_value self)
     strncpy(cmd.params.text.text, text, sizeof(cmd.params.text.text) - 1);
     cmd.params.text.text[sizeof(cmd.params.text.text) - 1] = '\0';
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
-        FMRB_LOGE("gfx", "draw_text send_gfx_command failed: %d", ret);
+        FMRB_LOGE("gfx", "draw_text fmrb_gfx_msg_send failed: %d", ret);
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Draw text failed: %d", ret);
     }
 
@@ -385,7 +896,7 @@ static mrb_value mrb_gfx_present(mrb_state *mrb, mrb_value self)
         }
     };
 
-    fmrb_err_t ret = send_gfx_command(&cmd);
+    fmrb_err_t ret = fmrb_gfx_msg_send(&cmd);
     if (ret != FMRB_OK) {
         FMRB_LOGE(TAG, "present() failed: %d", ret);
         mrb_raisef(mrb, E_RUNTIME_ERROR, "Present failed: %d", ret);
@@ -417,6 +928,30 @@ void mrb_fmrb_gfx_init(mrb_state *mrb)
     mrb_define_method(mrb, gfx_class, "fill_rect", mrb_gfx_fill_rect, MRB_ARGS_REQ(5));
     mrb_define_method(mrb, gfx_class, "draw_circle", mrb_gfx_draw_circle, MRB_ARGS_REQ(4));
     mrb_define_method(mrb, gfx_class, "fill_circle", mrb_gfx_fill_circle, MRB_ARGS_REQ(4));
+    mrb_define_method(mrb, gfx_class, "draw_round_rect", mrb_gfx_draw_round_rect, MRB_ARGS_REQ(6));
+    mrb_define_method(mrb, gfx_class, "fill_round_rect", mrb_gfx_fill_round_rect, MRB_ARGS_REQ(6));
+    mrb_define_method(mrb, gfx_class, "draw_ellipse", mrb_gfx_draw_ellipse, MRB_ARGS_REQ(5));
+    mrb_define_method(mrb, gfx_class, "fill_ellipse", mrb_gfx_fill_ellipse, MRB_ARGS_REQ(5));
+    mrb_define_method(mrb, gfx_class, "draw_triangle", mrb_gfx_draw_triangle, MRB_ARGS_REQ(7));
+    mrb_define_method(mrb, gfx_class, "fill_triangle", mrb_gfx_fill_triangle, MRB_ARGS_REQ(7));
+    mrb_define_method(mrb, gfx_class, "draw_polyline", mrb_gfx_draw_polyline, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, gfx_class, "draw_polygon", mrb_gfx_draw_polygon, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, gfx_class, "fill_polygon", mrb_gfx_fill_polygon, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, gfx_class, "draw_points", mrb_gfx_draw_points, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, gfx_class, "copy_rect", mrb_gfx_copy_rect, MRB_ARGS_ARG(6, 1));
+    mrb_define_method(mrb, gfx_class, "scroll_rect", mrb_gfx_scroll_rect, MRB_ARGS_REQ(7));
+    mrb_define_method(mrb, gfx_class, "tilemap_create", mrb_gfx_tilemap_create, MRB_ARGS_ARG(5, 1));
+    mrb_define_method(mrb, gfx_class, "tilemap_sheet", mrb_gfx_tilemap_sheet, MRB_ARGS_REQ(4));
+    mrb_define_method(mrb, gfx_class, "tilemap_set_cells", mrb_gfx_tilemap_set_cells, MRB_ARGS_REQ(5));
+    mrb_define_method(mrb, gfx_class, "tilemap_set_cell", mrb_gfx_tilemap_set_cell, MRB_ARGS_REQ(4));
+    mrb_define_method(mrb, gfx_class, "tilemap_scroll", mrb_gfx_tilemap_scroll, MRB_ARGS_REQ(3));
+    mrb_define_method(mrb, gfx_class, "tilemap_delete", mrb_gfx_tilemap_delete, MRB_ARGS_REQ(1));
+    mrb_define_method(mrb, gfx_class, "set_palette", mrb_gfx_set_palette, MRB_ARGS_REQ(1));
+    mrb_define_method(mrb, gfx_class, "set_palette_range", mrb_gfx_set_palette_range, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, gfx_class, "_list_begin", mrb_gfx_list_begin, MRB_ARGS_REQ(2));
+    mrb_define_method(mrb, gfx_class, "_list_end", mrb_gfx_list_end, MRB_ARGS_NONE());
+    mrb_define_method(mrb, gfx_class, "call_list", mrb_gfx_call_list, MRB_ARGS_ARG(1, 3));
+    mrb_define_method(mrb, gfx_class, "delete_list", mrb_gfx_delete_list, MRB_ARGS_REQ(1));
     mrb_define_method(mrb, gfx_class, "draw_text", mrb_gfx_draw_text, MRB_ARGS_ARG(4, 1));
     mrb_define_method(mrb, gfx_class, "present", mrb_gfx_present, MRB_ARGS_NONE());
     mrb_define_method(mrb, gfx_class, "destroy", mrb_gfx_destroy, MRB_ARGS_NONE());
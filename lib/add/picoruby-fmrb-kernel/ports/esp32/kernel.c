@@ -13,6 +13,7 @@
 #include "fmrb_task_config.h"
 #include "fmrb_log.h"
 #include "fmrb_link_transport.h"
+#include "fmrb_gfx.h"
 #include "boot.h"
 #include "hal.h"
 
@@ -203,7 +204,7 @@ static mrb_value mrb_kernel_get_window_list(mrb_state *mrb, mrb_value self)
     mrb_value array = mrb_ary_new_capa(mrb, count);
 
     for (int32_t i = 0; i < count; i++) {
-        // Create hash for each window: {pid:, app_name:, x:, y:, width:, height:, z_order:}
+        // Create hash for each window: {pid:, app_name:, x:, y:, width:, height:, z_order:, frame_style:, frame_flags:}
         mrb_value hash = mrb_hash_new(mrb);
         mrb_hash_set(mrb, hash, mrb_symbol_value(mrb_intern_cstr(mrb, "pid")),
                      mrb_fixnum_value(windows[i].pid));
@@ -219,6 +220,10 @@ static mrb_value mrb_kernel_get_window_list(mrb_state *mrb, mrb_value self)
                      mrb_fixnum_value(windows[i].height));
         mrb_hash_set(mrb, hash, mrb_symbol_value(mrb_intern_cstr(mrb, "z_order")),
                      mrb_fixnum_value(windows[i].z_order));
+        mrb_hash_set(mrb, hash, mrb_symbol_value(mrb_intern_cstr(mrb, "frame_style")),
+                     mrb_fixnum_value(windows[i].frame_style));
+        mrb_hash_set(mrb, hash, mrb_symbol_value(mrb_intern_cstr(mrb, "frame_flags")),
+                     mrb_fixnum_value(windows[i].frame_flags));
 
         mrb_ary_push(mrb, array, hash);
     }
@@ -226,6 +231,55 @@ static mrb_value mrb_kernel_get_window_list(mrb_state *mrb, mrb_value self)
     return array;
 }
 
+// FmrbKernel#_frame_hit(window, x, y) -> Symbol
+// Classify a window-relative point with the same geometry the host uses to draw the frame:
+// :none, :client, :title, :close, :resize or :border
+static mrb_value mrb_kernel_frame_hit(mrb_state *mrb, mrb_value self)
+{
+    mrb_value win;
+    mrb_int x, y;
+    mrb_get_args(mrb, "Hii", &win, &x, &y);
+
+    mrb_int style = mrb_fixnum(mrb_hash_get(mrb, win, mrb_symbol_value(mrb_intern_lit(mrb, "frame_style"))));
+    mrb_int flags = mrb_fixnum(mrb_hash_get(mrb, win, mrb_symbol_value(mrb_intern_lit(mrb, "frame_flags"))));
+    mrb_int width = mrb_fixnum(mrb_hash_get(mrb, win, mrb_symbol_value(mrb_intern_lit(mrb, "width"))));
+    mrb_int height = mrb_fixnum(mrb_hash_get(mrb, win, mrb_symbol_value(mrb_intern_lit(mrb, "height"))));
+
+    const char* part;
+    switch (fmrb_gfx_frame_hit_test((uint8_t)style, (uint8_t)flags, width, height, x, y)) {
+        case FMRB_GFX_FRAME_HIT_CLIENT: part = "client"; break;
+        case FMRB_GFX_FRAME_HIT_TITLE:  part = "title";  break;
+        case FMRB_GFX_FRAME_HIT_CLOSE:  part = "close";  break;
+        case FMRB_GFX_FRAME_HIT_RESIZE: part = "resize"; break;
+        case FMRB_GFX_FRAME_HIT_BORDER: part = "border"; break;
+        default:                        part = "none";   break;
+    }
+    return mrb_symbol_value(mrb_intern_cstr(mrb, part));
+}
+
+// FmrbKernel#_set_cursor_shape(shape) -> bool
+// shape: :arrow, :move or :resize (the host moves the cursor itself, only its shape is set here)
+static mrb_value mrb_kernel_set_cursor_shape(mrb_state *mrb, mrb_value self)
+{
+    mrb_sym shape_sym;
+    mrb_get_args(mrb, "n", &shape_sym);
+
+    const char* name = mrb_sym2name(mrb, shape_sym);
+    fmrb_gfx_cursor_shape_t shape;
+    if (strcmp(name, "arrow") == 0) {
+        shape = FMRB_GFX_CURSOR_ARROW;
+    } else if (strcmp(name, "move") == 0) {
+        shape = FMRB_GFX_CURSOR_MOVE;
+    } else if (strcmp(name, "resize") == 0) {
+        shape = FMRB_GFX_CURSOR_RESIZE;
+    } else {
+        mrb_raisef(mrb, E_ARGUMENT_ERROR, "Unknown cursor shape: %s", name);
+    }
+
+    fmrb_gfx_err_t ret = fmrb_gfx_set_cursor_shape(fmrb_gfx_get_global_context(), shape);
+    return mrb_bool_value(ret == FMRB_GFX_OK);
+}
+
 // FmrbKernel#_send_raw_message(dest_pid, msg_type, data) -> bool
 // Send raw binary message to another process
 static mrb_value mrb_kernel_send_raw_message(mrb_state *mrb, mrb_value self)
@@ -322,6 +376,8 @@ void mrb_fmrb_kernel_init(mrb_state *mrb)
     mrb_define_method(mrb, handler_class, "_get_window_list", mrb_kernel_get_window_list, MRB_ARGS_NONE());
     mrb_define_method(mrb, handler_class, "_set_hid_target", mrb_kernel_set_hid_target, MRB_ARGS_REQ(1));
     mrb_define_method(mrb, handler_class, "_set_focused_window", mrb_kernel_set_focused_window, MRB_ARGS_REQ(1));
+    mrb_define_method(mrb, handler_class, "_frame_hit", mrb_kernel_frame_hit, MRB_ARGS_REQ(3));
+    mrb_define_method(mrb, handler_class, "_set_cursor_shape", mrb_kernel_set_cursor_shape, MRB_ARGS_REQ(1));
     mrb_define_method(mrb, handler_class, "_send_raw_message", mrb_kernel_send_raw_message, MRB_ARGS_REQ(3));
     mrb_define_method(mrb, handler_class, "_bring_to_front", mrb_kernel_bring_to_front, MRB_ARGS_REQ(1));
     mrb_define_method(mrb, handler_class, "_update_window_position", mrb_kernel_update_window_position, MRB_ARGS_REQ(3));
@@ -14,6 +14,7 @@
 #include "fmrb_link_transport.h"
 #include "fmrb_link_protocol.h"
 #include "fmrb_gfx_msg.h"
+#include "fmrb_audio.h"
 #include "fmrb_msg.h"
 
 // Forward declaration for estalloc helper function
@@ -539,6 +540,9 @@ static void app_task_main(void* arg) {
 cleanup:
     FMRB_LOGI(TAG, "[%s gen=%u] Task exiting normally", ctx->app_name, ctx->gen);
 
+    // Silence the app's player on the host before its slot can be reused
+    fmrb_audio_release_app((uint8_t)ctx->app_id);
+
     // Perform cleanup immediately before task deletion
     fmrb_semaphore_take(g_ctx_lock, FMRB_TICK_MAX);
 
@@ -1153,6 +1157,8 @@ int32_t fmrb_app_get_window_list(fmrb_window_info_t* list, int32_t max_count) {
             list[count].width = ctx->window_width;
             list[count].height = ctx->window_height;
             list[count].z_order = ctx->z_order;
+            list[count].frame_style = ctx->frame_style;
+            list[count].frame_flags = ctx->frame_flags;
 
             count++;
         }
@@ -15,6 +15,7 @@
 #include "fmrb_kernel.h"
 #include "boot.h"
 #include "fmrb_link_transport.h"
+#include "fmrb_audio.h"
 #include "host/host_task.h"
 #include "fmrb_toml.h"
 
@@ -283,9 +284,15 @@ fmrb_err_t fmrb_kernel_get_hid_routing(fmrb_hid_routing_t *routing)
 fmrb_err_t fmrb_kernel_set_hid_target(uint8_t target_pid)
 {
     fmrb_semaphore_take(g_hid_routing_mutex, FMRB_TICK_MAX);
+    bool changed = g_hid_routing.target_pid != target_pid;
     g_hid_routing.target_pid = target_pid;
     fmrb_semaphore_give(g_hid_routing_mutex);
 
+    // The app with input focus also has audio focus; the host ducks the others
+    if (changed) {
+        fmrb_audio_set_focus(target_pid);
+    }
+
     FMRB_LOGI(TAG, "HID target set to PID=%d", target_pid);
     return FMRB_OK;
 }
@@ -19,6 +19,12 @@
 
 static const char *TAG = "host";
 
+// The host tracks the cursor from its own input. Set to 1 to also send every pointer move
+// back as CURSOR_SET_POSITION; the host then logs the core round-trip latency next to its local one.
+#ifndef FMRB_HOST_CURSOR_ECHO
+#define FMRB_HOST_CURSOR_ECHO 0
+#endif
+
 // Host message types
 typedef enum {
     HOST_MSG_HID_KEY_DOWN = 1,
@@ -62,6 +68,14 @@ static fmrb_task_handle_t g_host_task_handle = 0;
 static fmrb_gfx_command_buffer_t* g_gfx_cmd_buffer = NULL;
 #define GFX_CMD_BUFFER_SIZE (128)
 
+// Newest PRESENT per app still waiting for the host to display it
+typedef struct {
+    bool active;
+    uint32_t present_seq;   // App's present number (gfx_cmd_t.params.present.seq)
+    uint32_t render_push;   // fmrb_gfx render push count that carried it
+} pending_frame_t;
+static pending_frame_t g_pending_frames[FMRB_MAX_APPS];
+
 // Forward declarations (implemented in picoruby-fmrb-app)
 // extern int fmrb_app_dispatch_update(uint32_t delta_time_ms);
 // extern int fmrb_app_dispatch_key_down(int key_code);
@@ -72,6 +86,46 @@ static fmrb_gfx_command_buffer_t* g_gfx_cmd_buffer = NULL;
 // Internal forward declarations
 static void host_task_process_host_message(const host_message_t *msg);
 
+/**
+ * FRAME_DONE from the host: tell each app whose PRESENT made it to the display
+ * (runs in the host task from fmrb_link_transport_process())
+ */
+static void host_task_on_frame_done(uint8_t type, uint8_t seq, uint8_t sub_cmd,
+                                    const uint8_t *payload, uint32_t payload_len,
+                                    void *user_data)
+{
+    if (!payload || payload_len < sizeof(fmrb_link_graphics_frame_done_t)) {
+        return;
+    }
+    fmrb_link_graphics_frame_done_t done;
+    memcpy(&done, payload, sizeof(done));
+
+    for (int pid = 0; pid < FMRB_MAX_APPS; pid++) {
+        pending_frame_t *pending = &g_pending_frames[pid];
+        if (!pending->active || (int32_t)(done.render_pushes - pending->render_push) < 0) {
+            continue;
+        }
+        gfx_frame_event_t ev = {
+            .frame = done.frame,
+            .presented = pending->present_seq
+        };
+        fmrb_msg_t msg = {
+            .type = FMRB_MSG_TYPE_APP_GFX,
+            .src_pid = PROC_ID_HOST,
+            .size = sizeof(ev)
+        };
+        memcpy(msg.data, &ev, sizeof(ev));
+
+        // Never block the host task; a dropped notification stays pending and is retried on the
+        // next FRAME_DONE
+        if (fmrb_msg_send(pid, &msg, 0) != FMRB_OK) {
+            FMRB_LOGD(TAG, "Frame notification to PID %d deferred", pid);
+            continue;
+        }
+        pending->active = false;
+    }
+}
+
 /**
  * Initialize Graphics Audio layer and subsystems
  */
@@ -139,6 +193,10 @@ static int init_gfx_audio(void)
             return -1;
         }
         FMRB_LOGI(TAG, "Graphics command buffer created (max=%d)", GFX_CMD_BUFFER_SIZE);
+
+        if (fmrb_link_transport_register_callback(FMRB_LINK_GFX_FRAME_DONE, host_task_on_frame_done, NULL) != FMRB_OK) {
+            FMRB_LOGW(TAG, "Failed to register FRAME_DONE callback, apps get no frame notifications");
+        }
     }
 
     // Initialize Audio subsystem (APU emulator)
@@ -202,6 +260,12 @@ static void host_task_process_gfx_command(const fmrb_msg_t *msg)
                                     gfx_cmd->params.present.transparent_color);
         if (ret != FMRB_GFX_OK) {
             FMRB_LOGE(TAG, "Failed to push canvas %d to screen: %d", gfx_cmd->canvas_id, ret);
+        } else if (gfx_cmd->params.present.seq != 0 && msg->src_pid < FMRB_MAX_APPS) {
+            // Report back to the app once the host has displayed this push
+            pending_frame_t *pending = &g_pending_frames[msg->src_pid];
+            pending->active = true;
+            pending->present_seq = gfx_cmd->params.present.seq;
+            pending->render_push = ctx->render_pushes;
         }
 
         // Present to actual screen (calls display())
@@ -289,6 +353,93 @@ static void host_task_process_gfx_command(const fmrb_msg_t *msg)
                                                    gfx_cmd->params.text.font_size);
             break;
 
+        case GFX_CMD_ROUND_RECT:
+            ret = fmrb_gfx_command_buffer_add_round_rect(g_gfx_cmd_buffer,
+                                                         gfx_cmd->canvas_id,
+                                                         &gfx_cmd->params.round_rect.rect,
+                                                         gfx_cmd->params.round_rect.radius,
+                                                         gfx_cmd->params.round_rect.color,
+                                                         gfx_cmd->params.round_rect.filled);
+            break;
+
+        case GFX_CMD_ELLIPSE:
+            ret = fmrb_gfx_command_buffer_add_ellipse(g_gfx_cmd_buffer,
+                                                      gfx_cmd->canvas_id,
+                                                      gfx_cmd->params.ellipse.x,
+                                                      gfx_cmd->params.ellipse.y,
+                                                      gfx_cmd->params.ellipse.rx,
+                                                      gfx_cmd->params.ellipse.ry,
+                                                      gfx_cmd->params.ellipse.color,
+                                                      gfx_cmd->params.ellipse.filled);
+            break;
+
+        case GFX_CMD_TRIANGLE:
+            ret = fmrb_gfx_command_buffer_add_triangle(g_gfx_cmd_buffer,
+                                                       gfx_cmd->canvas_id,
+                                                       gfx_cmd->params.triangle.x0,
+                                                       gfx_cmd->params.triangle.y0,
+                                                       gfx_cmd->params.triangle.x1,
+                                                       gfx_cmd->params.triangle.y1,
+                                                       gfx_cmd->params.triangle.x2,
+                                                       gfx_cmd->params.triangle.y2,
+                                                       gfx_cmd->params.triangle.color,
+                                                       gfx_cmd->params.triangle.filled);
+            break;
+
+        case GFX_CMD_POLYLINE:
+            ret = fmrb_gfx_command_buffer_add_polyline(g_gfx_cmd_buffer,
+                                                       gfx_cmd->canvas_id,
+                                                       gfx_cmd->params.points.points,
+                                                       gfx_cmd->params.points.count,
+                                                       gfx_cmd->params.points.color);
+            break;
+
+        case GFX_CMD_POLYGON:
+            ret = fmrb_gfx_command_buffer_add_polygon(g_gfx_cmd_buffer,
+                                                      gfx_cmd->canvas_id,
+                                                      gfx_cmd->params.points.points,
+                                                      gfx_cmd->params.points.count,
+                                                      gfx_cmd->params.points.color,
+                                                      gfx_cmd->params.points.filled);
+            break;
+
+        case GFX_CMD_COPY_RECT:
+            ret = fmrb_gfx_command_buffer_add_copy_rect(g_gfx_cmd_buffer,
+                                                        gfx_cmd->canvas_id,
+                                                        &gfx_cmd->params.copy_rect.src_rect,
+                                                        gfx_cmd->params.copy_rect.dst_canvas_id,
+                                                        gfx_cmd->params.copy_rect.dst_x,
+                                                        gfx_cmd->params.copy_rect.dst_y);
+            break;
+
+        case GFX_CMD_SCROLL_RECT:
+            ret = fmrb_gfx_command_buffer_add_scroll_rect(g_gfx_cmd_buffer,
+                                                          gfx_cmd->canvas_id,
+                                                          &gfx_cmd->params.scroll_rect.rect,
+                                                          gfx_cmd->params.scroll_rect.dx,
+                                                          gfx_cmd->params.scroll_rect.dy,
+                                                          gfx_cmd->params.scroll_rect.fill_color);
+            break;
+
+        case GFX_CMD_POINTS:
+            ret = fmrb_gfx_command_buffer_add_points(g_gfx_cmd_buffer,
+                                                     gfx_cmd->canvas_id,
+                                                     gfx_cmd->params.points.points,
+                                                     gfx_cmd->params.points.count,
+                                                     gfx_cmd->params.points.color);
+            break;
+
+        case GFX_CMD_LIST:
+            ret = fmrb_gfx_command_buffer_add_list(g_gfx_cmd_buffer,
+                                                   gfx_cmd->canvas_id,
+                                                   gfx_cmd->params.list.op,
+                                                   gfx_cmd->params.list.list_id,
+                                                   gfx_cmd->params.list.dx,
+                                                   gfx_cmd->params.list.dy,
+                                                   gfx_cmd->params.list.colors,
+                                                   gfx_cmd->params.list.color_count);
+            break;
+
         default:
             FMRB_LOGW(TAG, "Unknown graphics command type: %d", gfx_cmd->cmd_type);
             return;
@@ -366,10 +517,11 @@ static void host_task_process_host_message(const host_message_t *msg)
         }
 
         case HOST_MSG_HID_MOUSE_MOVE: {
-            // Update cursor position via GFX API
             int x = msg->data.mouse_move.x;
             int y = msg->data.mouse_move.y;
 
+#if FMRB_HOST_CURSOR_ECHO
+            // The host already moved the cursor; echoing lets it log the core round-trip latency
             fmrb_gfx_context_t gfx_ctx = fmrb_gfx_get_global_context();
             if (gfx_ctx) {
                 fmrb_gfx_err_t gfx_ret = fmrb_gfx_set_cursor_position(gfx_ctx, x, y);
@@ -377,6 +529,7 @@ static void host_task_process_host_message(const host_message_t *msg)
                     FMRB_LOGW(TAG, "Failed to set cursor position: %d", gfx_ret);
                 }
             }
+#endif
 
             FMRB_LOGD(TAG, "Mouse move: (%d, %d) - forwarding to Kernel", x, y);
 
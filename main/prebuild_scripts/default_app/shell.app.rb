@@ -48,6 +48,9 @@ class ShellApp < FmrbApp
     @prompt = "> "
     @need_full_redraw = false   # Full screen redraw (includes logo)
     @need_line_redraw = false   # Only current input line redraw
+    @need_scroll_redraw = false # Scroll existing lines, draw only new ones
+    @drawn_lines = 0            # History lines currently on screen at their positions
+    @scroll_lines = 0           # Lines to scroll up on the next scroll redraw
     @max_line_length = 100  # Maximum input line length
     @input_buffer = []  # Character buffer for getch
     @frame_ms = 33
@@ -57,9 +60,9 @@ class ShellApp < FmrbApp
 
   def on_create()
     @gfx.clear(FmrbGfx::WHITE)
-    draw_window_frame
     show_logo
     draw_prompt
+    @drawn_lines = @history.length
     @gfx.present
     Log.info("on_create called")
     Log.info("user_area: x0=#{@user_area_x0}, y0=#{@user_area_y0}, width=#{@user_area_width}, height=#{@user_area_height}")
@@ -451,6 +454,12 @@ class ShellApp < FmrbApp
       # Full redraw: everything including logo (for scroll, etc.)
       redraw_screen
       @need_full_redraw = false
+      @need_scroll_redraw = false
+      @need_line_redraw = false
+    elsif @need_scroll_redraw
+      # Scroll on the host and draw only the new lines
+      redraw_scrolled
+      @need_scroll_redraw = false
       @need_line_redraw = false
     elsif @need_line_redraw
       # Partial redraw: only current input line (for typing)
@@ -528,11 +537,37 @@ class ShellApp < FmrbApp
     # Full redraw: Clear user area and redraw everything including logo
     @gfx.fill_rect(@user_area_x0, @user_area_y0,
                     @user_area_width, @user_area_height, FmrbGfx::WHITE)
-    draw_window_frame
     draw_prompt
+    @drawn_lines = @history.length
+    @scroll_lines = 0
     @gfx.present
   end
 
+  def redraw_scrolled
+    # Move the lines still on screen instead of redrawing them
+    if @scroll_lines > 0
+      @gfx.scroll_rect(@user_area_x0, @user_area_y0 + 2, @user_area_width, @user_area_height - 2,
+                       0, -(@scroll_lines * @char_height), FmrbGfx::WHITE)
+    end
+
+    # Draw lines added since the last redraw (includes the line just entered)
+    x = @user_area_x0 + 2
+    (@drawn_lines...@history.length).each do |i|
+      y = @user_area_y0 + 2 + (i * @char_height)
+      @gfx.fill_rect(x, y, @user_area_width - 4, @char_height, FmrbGfx::WHITE)
+      entry = @history[i]
+      if entry.is_a?(Hash) && entry[:type] == :logo_line
+        draw_logo_line(x, y, entry)
+      else
+        @gfx.draw_text(x, y, entry.to_s, FmrbGfx::BLACK)
+      end
+    end
+    @drawn_lines = @history.length
+    @scroll_lines = 0
+
+    redraw_input_line
+  end
+
   def redraw_input_line
     # Partial redraw: Only redraw the current input line
     x = @user_area_x0 + 2
@@ -554,7 +589,7 @@ class ShellApp < FmrbApp
   end
 
   def on_event(ev)
-    # Call parent class handler first (for close button, etc.)
+    # Call parent class handler first
     super(ev)
 
     if ev[:type] == :key_down
@@ -650,9 +685,11 @@ class ShellApp < FmrbApp
     while @history.length >= max_lines - 1
       # Remove oldest line to make room
       @history.shift
+      @scroll_lines += 1
+      @drawn_lines -= 1 if @drawn_lines > 0
     end
 
-    @need_full_redraw = true
+    @need_scroll_redraw = true
   end
 
   def handle_backspace
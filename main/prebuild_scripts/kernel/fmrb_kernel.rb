@@ -19,6 +19,9 @@ class FmrbKernelImpl < FmrbKernel
     # Mouse button state (for click event routing)
     @mouse_down_pid = nil  # Window where mouse_down occurred
 
+    # Window whose close button is pressed (closed on release)
+    @close_pid = nil
+
     # Mouse capture state (for drag and resize only)
     @capture_pid = nil     # Window that captured mouse
     @capture_mode = nil    # :drag, :resize, or nil
@@ -166,13 +169,9 @@ class FmrbKernelImpl < FmrbKernel
 
         Log.info("Relative pos in window: (#{relative_x},#{relative_y}), size=#{win_width}x#{win_height}")
 
-        # Record mouse_down window for button_up event routing
-        @mouse_down_pid = target_pid
-
-        # Check for resize handle (bottom-right 10x10 area) first
-        # Resize handle only for non-system_gui windows
-        if target_name != "system_gui" &&
-           relative_x >= win_width - 10 && relative_y >= win_height - 10
+        # Frame parts are drawn by the host compositor and handled here; only client clicks reach the app
+        part = _frame_hit(target_window, relative_x, relative_y)
+        if part == :resize
           # Start resize and capture mouse
           @capture_mode = :resize
           @capture_pid = target_pid
@@ -180,16 +179,24 @@ class FmrbKernelImpl < FmrbKernel
           @resize_start_height = win_height
           @resize_start_x = x
           @resize_start_y = y
+          _set_cursor_shape(:resize)
           Log.info("Start resize: PID #{target_pid}, size=(#{win_width}x#{win_height})")
-        # Check if click is in menu bar region (not resizing and not close button)
-        elsif target_name != "system_gui" && relative_y < 11 && relative_x < win_width - 10
-          # Start drag and capture mouse (excluding close button area on the right)
+        elsif part == :title
+          # Start drag and capture mouse
           @capture_mode = :drag
           @capture_pid = target_pid
           @drag_offset_x = x - win_x
           @drag_offset_y = y - win_y
+          _set_cursor_shape(:move)
           Log.info("Start drag: PID #{target_pid}, offset=(#{@drag_offset_x},#{@drag_offset_y})")
+        elsif part == :close
+          # Closed on release, if the pointer is still over the button
+          @close_pid = target_pid
         end
+        return unless part == :client
+
+        # Record mouse_down window for button_up event routing
+        @mouse_down_pid = target_pid
 
         # Create new binary message with relative coordinates
         # Format: subtype(1 byte) + button(1 byte) + x(2 bytes) + y(2 bytes)
@@ -241,10 +248,8 @@ class FmrbKernelImpl < FmrbKernel
           end
         end
 
-        # Forward mouse_move event:
-        # - If capture is active (drag/resize): send to @capture_pid
-        # - Otherwise: send to @hid_target_pid (focused window)
-        target_pid = @capture_pid || @hid_target_pid
+        # Forward mouse_move event to the focused window
+        target_pid = @hid_target_pid
         if target_pid
           # Convert to window-relative coordinates
           target_window = find_window_by_pid(target_pid)
@@ -266,8 +271,16 @@ class FmrbKernelImpl < FmrbKernel
         end
 
       when 5  # Mouse button up
-        # Forward to captured window or mouse_down window
-        target_pid = @capture_pid || @mouse_down_pid
+        if @close_pid
+          close_window = find_window_by_pid(@close_pid)
+          if close_window && _frame_hit(close_window, x - close_window[:x], y - close_window[:y]) == :close
+            Log.info("Close button: PID #{@close_pid}")
+            _send_raw_message(@close_pid, FmrbConst::MSG_TYPE_APP_CONTROL, MessagePack.pack({"cmd" => "close"}))
+          end
+        end
+
+        # Forward to the window that received the mouse_down (frame presses are not forwarded)
+        target_pid = @mouse_down_pid
         if target_pid
           # Convert to window-relative coordinates
           target_window = find_window_by_pid(target_pid)
@@ -301,10 +314,13 @@ class FmrbKernelImpl < FmrbKernel
           @drag_offset_y = 0
         end
 
+        _set_cursor_shape(:arrow) if @capture_mode
+
         # Clear all mouse button state
         @capture_pid = nil
         @capture_mode = nil
         @mouse_down_pid = nil
+        @close_pid = nil
       end
 
     rescue => e
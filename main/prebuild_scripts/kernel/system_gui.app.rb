@@ -2,6 +2,8 @@
 # This is the default system GUI that provides basic UI elements
 
 class SystemGuiApp < FmrbApp
+  SYSTEM_FRAME_LIST_ID = 14  # Display list holding the top bar
+
   def initialize
     super()
     @counter = 0
@@ -40,6 +42,15 @@ class SystemGuiApp < FmrbApp
   end
 
   def draw_system_frame()
+    # Static, so it is recorded once and replayed every frame
+    unless @system_frame_defined
+      @gfx.define_list(SYSTEM_FRAME_LIST_ID) { draw_system_frame_direct }
+      @system_frame_defined = true
+    end
+    @gfx.call_list(SYSTEM_FRAME_LIST_ID)
+  end
+
+  def draw_system_frame_direct()
     @gfx.fill_rect( 0,  0, @window_width, 13, 0xC5)
     @gfx.draw_text( 2,  2, "Family mruby", FmrbGfx::WHITE)
 
@@ -141,7 +152,7 @@ class SystemGuiApp < FmrbApp
     #Log.debug("on_event: gui app")
     #p ev
 
-    # Call parent class handler first (for close button, etc.)
+    # Call parent class handler first
     super(ev)
 
     # Handle mouse up event